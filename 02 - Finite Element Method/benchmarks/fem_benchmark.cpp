@@ -0,0 +1,537 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+using namespace std;
+
+#include "../utilities/precision_utilities.h"
+#include "../data_structures/SDDS.h"
+#include "../geometry/mesh.h"
+#include "../gid/input_output.h"
+#include "../utilities/log_utilities.h"
+#include "../utilities/math_utilities.h"
+#include "../utilities/skyline_utilities.h"
+#include "../utilities/FEM_utilities.h"
+#include "mesh_generator.h"
+
+/*
+    Programa de medición de desempeño del proceso MEF2D sobre mallas generadas
+    de tamaño creciente.
+
+    Para cada variante de malla (estructurada y no estructurada) y para cada
+    tamaño solicitado, el programa genera la malla, la escribe y la vuelve a
+    leer en el formato de GiD, y ejecuta un paso de tiempo completo del proceso
+    tal como lo hace el procedimiento principal, midiendo cada etapa por separado:
+
+        - generate        Generación de la malla en memoria.
+        - write           Escritura del archivo de entrada (write_input_file).
+        - read            Lectura del archivo de entrada (read_input_file).
+        - renumber        Renumeración de los nodos con Reverse Cuthill-McKee
+                          (Mesh::renumber_nodes), solo con --rcm. Se indica el
+                          ancho de banda antes y después de renumerar.
+        - local_systems   Cálculo de las matrices locales M, K y b.
+        - assembly        Ensamblaje de las matrices globales.
+        - neumann         Aplicación de las condiciones de Neumann.
+        - dirichlet       Aplicación de las condiciones de Dirichlet.
+        - matvec          Producto K * T (Math::product).
+        - cholesky        Factorización de Cholesky de M en almacenamiento skyline
+                          (Skyline::factorize). Se indica la cantidad de datos
+                          del perfil.
+        - solve           Cálculo completo de las temperaturas del siguiente tiempo.
+        - full_step       Un paso de tiempo completo, de local_systems a solve.
+
+    Por cada etapa se reporta el menor tiempo de las repeticiones, el rendimiento
+    en nodos por segundo, y el exponente de escalamiento respecto al tamaño
+    anterior medido, es decir, el valor p tal que tiempo ~ nodos^p.
+
+    Las etapas cuyo costo estimado supera el presupuesto de operaciones, o
+    cuyas matrices densas superan el límite de memoria, no se ejecutan y se
+    reporta el motivo; las etapas posteriores del paso de tiempo dependen de
+    ellas, por lo que tampoco se ejecutan.
+
+    Compilación y ejecución, desde este directorio:
+
+            g++ -O2 -o fem_benchmark fem_benchmark.cpp
+            ./fem_benchmark [opciones]
+
+    Con -DFEM_DOUBLE las mismas etapas se miden con datos en double (ver
+    precision_utilities.h).
+
+    Opciones:
+        --sizes <n1,n2,...>     Cantidades aproximadas de nodos a medir
+                                (por defecto 100,1000,10000,100000,1000000).
+        --max-nodes <n>         Omite los tamaños mayores a <n> nodos.
+        --mesh <tipo>           structured, unstructured o both (por defecto).
+        --repeat <r>            Repeticiones por etapa (por defecto 3). Una etapa
+                                que tarda más de 1 segundo no se repite.
+        --budget <ops>          Presupuesto de operaciones por etapa (por defecto 2e9).
+        --memory-cap <MB>       Límite de memoria para matrices densas (por defecto 512).
+        --seed <s>              Semilla para las mallas no estructuradas (por defecto 1).
+        --keep-files            Conserva los archivos .dat generados.
+        --rcm                   Renumera los nodos antes del paso de tiempo.
+        --csv <archivo>         Guarda además los resultados en formato CSV.
+*/
+
+template <typename T>
+thread_local Data SDDS<T>::ref = Data();
+
+/*
+    Enumeración utilizada para identificar las etapas medidas.
+
+    NUM_STAGES no es una etapa, se utiliza como cantidad total de etapas.
+*/
+enum stage {STAGE_GENERATE,STAGE_WRITE,STAGE_READ,STAGE_RENUMBER,STAGE_LOCAL_SYSTEMS,STAGE_ASSEMBLY,STAGE_NEUMANN,STAGE_DIRICHLET,STAGE_MATVEC,STAGE_CHOLESKY,STAGE_SOLVE,STAGE_FULL_STEP,NUM_STAGES};
+
+const char* STAGE_NAMES[NUM_STAGES] = {"generate","write","read","renumber","local_systems","assembly","neumann","dirichlet","matvec","cholesky","solve","full_step"};
+
+//Cantidades máximas de tamaños y de variantes de malla a medir
+const int MAX_SIZES = 16;
+const int NUM_KINDS = 2;
+const char* KIND_NAMES[NUM_KINDS] = {"structured","unstructured"};
+
+/*
+    Estructura BenchOptions utilizada para almacenar las opciones recibidas
+    en la línea de comandos, con un constructor genérico que coloca los
+    valores por defecto.
+*/
+typedef struct BenchOptions{
+    long sizes[MAX_SIZES];
+    int nsizes;
+    long max_nodes;
+    bool kinds[NUM_KINDS];
+    int repeat;
+    double budget;
+    double memory_cap;
+    unsigned int seed;
+    bool keep_files;
+    bool renumber;
+    char* csv;
+    BenchOptions(){
+        long defaults[] = {100,1000,10000,100000,1000000};
+        nsizes = 5;
+        for(int i = 0; i < nsizes; i++) sizes[i] = defaults[i];
+        max_nodes = 1000000;
+        kinds[0] = kinds[1] = true;
+        repeat = 3;
+        budget = 2e9;
+        memory_cap = 512;
+        seed = 1;
+        keep_files = false;
+        renumber = false;
+        csv = NULL;
+    }
+} BenchOptions;
+
+/*
+    Estructura Measurement utilizada para almacenar el resultado de una etapa:
+    su tiempo en segundos, o un tiempo negativo junto con el motivo por el que
+    no se ejecutó, y una nota opcional a mostrar junto al resultado.
+*/
+typedef struct Measurement{
+    double seconds;
+    string reason;
+    string note;
+    Measurement(){
+        seconds = -1;
+    }
+} Measurement;
+
+void show_usage(char* program){
+    cout << "Usage: " << program << " [--sizes <n1,n2,...>] [--max-nodes <n>] [--mesh structured|unstructured|both]\n"
+         << "       [--repeat <r>] [--budget <ops>] [--memory-cap <MB>] [--seed <s>] [--keep-files] [--rcm] [--csv <file>]\n";
+    exit(EXIT_FAILURE);
+}
+
+BenchOptions parse_options(int argc, char** argv){
+    BenchOptions opts;
+
+    for(int i = 1; i < argc; i++){
+        string arg(argv[i]);
+        bool has_value = (i+1 < argc);
+
+        if(arg == "--keep-files") opts.keep_files = true;
+        else if(arg == "--rcm")   opts.renumber = true;
+        else if(!has_value) show_usage(argv[0]);
+        else if(arg == "--sizes"){
+            //Se separan los tamaños indicados por comas
+            opts.nsizes = 0;
+            char* token = strtok(argv[++i], ",");
+            while(token != NULL && opts.nsizes < MAX_SIZES){
+                opts.sizes[opts.nsizes++] = atol(token);
+                token = strtok(NULL, ",");
+            }
+        }
+        else if(arg == "--max-nodes")  opts.max_nodes = atol(argv[++i]);
+        else if(arg == "--repeat")     opts.repeat = max(1, atoi(argv[++i]));
+        else if(arg == "--budget")     opts.budget = atof(argv[++i]);
+        else if(arg == "--memory-cap") opts.memory_cap = atof(argv[++i]);
+        else if(arg == "--seed")       opts.seed = atoi(argv[++i]);
+        else if(arg == "--csv")        opts.csv = argv[++i];
+        else if(arg == "--mesh"){
+            string kind(argv[++i]);
+            opts.kinds[0] = (kind == "structured" || kind == "both");
+            opts.kinds[1] = (kind == "unstructured" || kind == "both");
+            if(!opts.kinds[0] && !opts.kinds[1]) show_usage(argv[0]);
+        }
+        else show_usage(argv[0]);
+    }
+
+    return opts;
+}
+
+/*
+    Función que retorna los segundos transcurridos desde <begin>.
+*/
+double seconds_since(chrono::steady_clock::time_point begin){
+    return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+}
+
+/*
+    Función que estima la cantidad de operaciones elementales de una etapa
+    con las implementaciones actuales, para una malla de <n> nodos, <e>
+    elementos, <d> nodos con Dirichlet, <nn> nodos con Neumann, <f> nodos libres
+    y ancho de banda <w>.
+
+    Las búsquedas por ID en la malla son lineales, por lo que se incluyen en la
+    estimación. Los nodos con Dirichlet se consultan en un árbol balanceado, con
+    un costo de log(d) por consulta: en la etapa dirichlet, el vector b consulta
+    las n columnas de cada una de las f filas libres, mientras que K y M solo
+    consultan los n nodos para construir sus vistas.
+*/
+double estimated_cost(int s, double n, double e, double d, double nn, double f, double w){
+    switch(s){
+        case STAGE_READ:          return 1.5*e*n + n*(d+nn)/2;
+        case STAGE_LOCAL_SYSTEMS: return e*e/2;
+        case STAGE_ASSEMBLY:      return 2*n*n + e*e/2;
+        case STAGE_NEUMANN:       return n*nn;
+        case STAGE_DIRICHLET:     return (f+2)*n*log2(d+2) + f*d;
+        case STAGE_MATVEC:        return f*f;
+        case STAGE_CHOLESKY:      return f*f + f*w*w;
+        case STAGE_SOLVE:         return f*w*w + 3*f*f;
+    }
+    return n + e;
+}
+
+/*
+    Función que estima la memoria, en MB, de las matrices que existen al mismo
+    tiempo durante una etapa.
+
+    K y M se reducen a los nodos libres mediante vistas (ver DSMV.h), que solo
+    ocupan sus índices, por lo que conservan su tamaño de n x n hasta el final
+    del paso de tiempo.
+*/
+double estimated_memory(int s, double n, double f, double w){
+    double floats = 0;
+    switch(s){
+        case STAGE_ASSEMBLY: case STAGE_NEUMANN: case STAGE_DIRICHLET: case STAGE_MATVEC:
+            floats = 2*n*n; break;
+        case STAGE_CHOLESKY: case STAGE_SOLVE:
+            floats = 2*n*n + f*(w+1); break;
+    }
+    return floats*sizeof(real)/(1024.0*1024.0);
+}
+
+void free_list(DS<DS<real>*>* L){
+    int length = 0;
+    SDDS<DS<real>*>::extension(L, &length);
+    for(int i = 0; i < length; i++){
+        DS<real>* temp = NULL;
+        SDDS<DS<real>*>::extract(L,i,&temp);
+        SDDS<real>::destroy(temp);
+    }
+    SDDS<DS<real>*>::destroy(L);
+}
+
+/*
+    Función que ejecuta un paso de tiempo del proceso MEF2D, con las mismas
+    operaciones del procedimiento principal, hasta la etapa <last> inclusive.
+
+    Cada etapa se mide con la clase utilitaria Perf, salvo el producto K * T y
+    la factorización de Cholesky, cuyos tiempos se colocan en <matvec> y
+    <cholesky>. La cantidad de datos del perfil de M se coloca en <profile>.
+*/
+void solver_step(Mesh* G, DS<real>* T, DS<real>* T_N, DS<int>* dirichlet_indices, int last, double* matvec, double* cholesky, long* profile){
+    int nelems = G->get_quantity(NUM_ELEMENTS);
+    int nnodes = G->get_quantity(NUM_NODES);
+    int free_nodes = nnodes - G->get_quantity(NUM_DIRICHLET_BCs);
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+    float dt = G->get_parameter(TIME_STEP);
+    DS<real> *M = NULL, *K = NULL, *b = NULL;
+    DS<DS<real>*> *M_locals, *K_locals, *b_locals;
+
+    SDDS<DS<real>*>::create(&M_locals, nelems, ARRAY);
+    SDDS<DS<real>*>::create(&K_locals, nelems, ARRAY);
+    SDDS<DS<real>*>::create(&b_locals, nelems, ARRAY);
+
+    {
+        ScopedTimer timer(PHASE_LOCAL_SYSTEMS);
+        for(int e = 0; e < nelems; e++){
+            Element* current_elem = G->get_element(e+1);
+            SDDS<DS<real>*>::insert(M_locals, e, FEM::calculate_local_M<real>(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT), current_elem));
+            SDDS<DS<real>*>::insert(K_locals, e, FEM::calculate_local_K<real>(G->get_parameter(THERMAL_CONDUCTIVITY), current_elem));
+            SDDS<DS<real>*>::insert(b_locals, e, FEM::calculate_local_b<real>(G->get_parameter(HEAT_SOURCE), current_elem));
+        }
+    }
+
+    if(last >= STAGE_ASSEMBLY){
+        ScopedTimer timer(PHASE_ASSEMBLY);
+        SDDS<real>::create(&M, nnodes, nnodes, MATRIX); Math::zeroes(M);
+        SDDS<real>::create(&K, nnodes, nnodes, MATRIX); Math::zeroes(K);
+        SDDS<real>::create(&b, nnodes, 1, MATRIX);      Math::zeroes(b);
+
+        for(int e = 0; e < nelems; e++){
+            Element* current_elem = G->get_element(e+1);
+            DS<real> *temp;
+            SDDS<DS<real>*>::extract(M_locals,e,&temp);
+            FEM::assembly(M, temp, current_elem, true);
+            SDDS<DS<real>*>::extract(K_locals,e,&temp);
+            FEM::assembly(K, temp, current_elem, true);
+            SDDS<DS<real>*>::extract(b_locals,e,&temp);
+            FEM::assembly(b, temp, current_elem, false);
+        }
+    }
+
+    if(last >= STAGE_NEUMANN){
+        ScopedTimer timer(PHASE_NEUMANN);
+        Math::sum_in_place(b,T_N);
+    }
+
+    if(last >= STAGE_DIRICHLET){
+        ScopedTimer timer(PHASE_DIRICHLET);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &b, K, Td, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &K, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &M, dirichlet_indices);
+    }
+
+    if(last >= STAGE_MATVEC){
+        ScopedTimer timer(PHASE_SOLVE);
+
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        DS<real>* temp = Math::product(K,T);
+        *matvec = seconds_since(begin);
+
+        Math::product_in_place(temp, -1);
+        Math::sum_in_place(b, temp);
+        Math::product_in_place(b, dt);
+
+        if(last >= STAGE_CHOLESKY){
+            begin = chrono::steady_clock::now();
+            Skyline* M_skyline = new Skyline(M);
+            M_skyline->factorize();
+            *cholesky = seconds_since(begin);
+            *profile = M_skyline->stored();
+
+            M_skyline->solve(b);
+            Math::sum_in_place(T, b);
+            delete M_skyline;
+        }
+        SDDS<real>::destroy(temp);
+    }
+
+    free_list(M_locals);
+    free_list(K_locals);
+    free_list(b_locals);
+    if(M != NULL) SDDS<real>::destroy(M);
+    if(K != NULL) SDDS<real>::destroy(K);
+    if(b != NULL) SDDS<real>::destroy(b);
+}
+
+/*
+    Función que mide todas las etapas para una variante de malla <kind> de
+    <side> x <side> nodos, y coloca los resultados en <results>.
+*/
+void benchmark_mesh(BenchOptions* opts, int kind, int side, Measurement* results){
+    double n = (double) side*side, e = 2.0*(side-1)*(side-1), d = side, nn = side, f = n - d;
+    char filename[64];
+    snprintf(filename, sizeof(filename), "bench_%s_%d", KIND_NAMES[kind], side*side);
+
+    //Generación y escritura, ambas lineales en la cantidad de nodos
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    Mesh* G = new Mesh();
+    generate_mesh(G, side, kind == 1, opts->seed);
+    results[STAGE_GENERATE].seconds = seconds_since(begin);
+
+    begin = chrono::steady_clock::now();
+    write_input_file(G, filename);
+    results[STAGE_WRITE].seconds = seconds_since(begin);
+
+    //Lectura del archivo generado
+    if(estimated_cost(STAGE_READ, n, e, d, nn, f, n) <= opts->budget){
+        for(int r = 0; r < opts->repeat; r++){
+            begin = chrono::steady_clock::now();
+            Mesh* R = new Mesh();
+            read_input_file(R, filename);
+            double elapsed = seconds_since(begin);
+            delete R;
+            if(results[STAGE_READ].seconds < 0 || elapsed < results[STAGE_READ].seconds) results[STAGE_READ].seconds = elapsed;
+            if(elapsed > 1) break;
+        }
+    }
+    else results[STAGE_READ].reason = "estimated cost exceeds --budget";
+
+    if(!opts->keep_files) remove(add_extension(filename, ".dat").c_str());
+
+    //Renumeración de los nodos, que modifica la malla utilizada en el paso de tiempo
+    if(opts->renumber){
+        int before = G->bandwidth();
+        begin = chrono::steady_clock::now();
+        G->renumber_nodes();
+        results[STAGE_RENUMBER].seconds = seconds_since(begin);
+        results[STAGE_RENUMBER].note = "bandwidth " + to_string(before) + " -> " + to_string(G->bandwidth());
+    }
+    else results[STAGE_RENUMBER].reason = "requires --rcm";
+
+    //Se determina hasta qué etapa del paso de tiempo es posible llegar,
+    //<last> queda antes de local_systems si no es posible ejecutar ninguna
+    double w = G->bandwidth();
+    int last = STAGE_LOCAL_SYSTEMS - 1;
+    for(int s = STAGE_LOCAL_SYSTEMS; s <= STAGE_SOLVE; s++){
+        if(estimated_cost(s, n, e, d, nn, f, w) > opts->budget)
+            results[s].reason = "estimated cost exceeds --budget";
+        else if(estimated_memory(s, n, f, w) > opts->memory_cap){
+            char reason[96];
+            snprintf(reason, sizeof(reason), "matrices need %.0f MB > --memory-cap", estimated_memory(s, n, f, w));
+            results[s].reason = reason;
+        }
+        else{ last = s; continue; }
+        break;
+    }
+    for(int s = last+2; s <= STAGE_SOLVE; s++)
+        results[s].reason = string("requires ") + STAGE_NAMES[last+1];
+    if(last < STAGE_SOLVE) results[STAGE_FULL_STEP].reason = string("requires ") + STAGE_NAMES[last+1];
+
+    if(last >= STAGE_LOCAL_SYSTEMS){
+        int nnodes = (int) n, free_nodes = (int) f;
+        DS<real> *T, *T_N;
+        DS<int> *dirichlet_indices, *neumann_indices;
+
+        //Preparación de los vectores del proceso, igual que en el procedimiento principal
+        SDDS<real>::create(&T, free_nodes, 1, MATRIX);
+        SDDS<real>::create(&T_N, nnodes, 1, MATRIX);
+        Math::init(T, G->get_parameter(INITIAL_TEMPERATURE));
+        SDDS<int>::create(&neumann_indices, G->get_quantity(NUM_NEUMANN_BCs), ARRAY);
+        G->get_condition_indices(neumann_indices, NEUMANN);
+        FEM::built_T_Neumann(T_N, G->get_parameter(NEUMANN_VALUE), neumann_indices);
+        SDDS<int>::create(&dirichlet_indices, BINARY_SEARCH_TREE, true);
+        G->get_condition_indices(dirichlet_indices, DIRICHLET);
+
+        phase phases[] = {PHASE_LOCAL_SYSTEMS,PHASE_ASSEMBLY,PHASE_NEUMANN,PHASE_DIRICHLET};
+        for(int r = 0; r < opts->repeat; r++){
+            double matvec = 0, cholesky = 0, times[NUM_STAGES];
+            long profile = 0;
+
+            Perf::reset();
+            begin = chrono::steady_clock::now();
+            solver_step(G, T, T_N, dirichlet_indices, last, &matvec, &cholesky, &profile);
+            times[STAGE_FULL_STEP] = seconds_since(begin);
+
+            for(int s = STAGE_LOCAL_SYSTEMS; s <= STAGE_DIRICHLET; s++)
+                times[s] = Perf::get_time(phases[s - STAGE_LOCAL_SYSTEMS]);
+            times[STAGE_MATVEC] = matvec;
+            times[STAGE_CHOLESKY] = cholesky;
+            if(last >= STAGE_CHOLESKY)
+                results[STAGE_CHOLESKY].note = "profile " + to_string(profile) + " of " + to_string((long) f*((long) f+1)/2);
+            times[STAGE_SOLVE] = Perf::get_time(PHASE_SOLVE);
+
+            //Se conserva el menor tiempo de cada etapa ejecutada
+            for(int s = STAGE_LOCAL_SYSTEMS; s <= STAGE_FULL_STEP; s++){
+                if(s > last && s != STAGE_FULL_STEP) continue;
+                if(s == STAGE_FULL_STEP && last < STAGE_SOLVE) continue;
+                if(results[s].seconds < 0 || times[s] < results[s].seconds) results[s].seconds = times[s];
+            }
+            if(times[STAGE_FULL_STEP] > 1) break;
+        }
+
+        SDDS<real>::destroy(T); SDDS<real>::destroy(T_N);
+        SDDS<int>::destroy(dirichlet_indices); SDDS<int>::destroy(neumann_indices);
+    }
+
+    delete G;
+}
+
+/*
+    Procedimiento principal del programa de medición.
+
+    Se recorren las variantes de malla y los tamaños solicitados, se miden
+    todas las etapas, y se muestran los resultados por variante, junto con
+    el rendimiento y el exponente de escalamiento de cada etapa.
+*/
+int main(int argc, char** argv){
+    BenchOptions opts = parse_options(argc, argv);
+    Measurement results[NUM_KINDS][MAX_SIZES][NUM_STAGES];
+    long nodes[MAX_SIZES], elems[MAX_SIZES];
+
+    ofstream csvFile;
+    if(opts.csv != NULL){
+        csvFile.open(opts.csv);
+        csvFile << "mesh,nodes,elements,stage,seconds,nodes_per_second,scaling_exponent,note\n";
+    }
+
+    //Se calcula el lado de la cuadrícula de cada tamaño solicitado
+    int sides[MAX_SIZES];
+    for(int i = 0; i < opts.nsizes; i++){
+        sides[i] = max(2, (int) lround(sqrt((double) opts.sizes[i])));
+        nodes[i] = (long) sides[i]*sides[i];
+        elems[i] = 2L*(sides[i]-1)*(sides[i]-1);
+    }
+
+    for(int kind = 0; kind < NUM_KINDS; kind++){
+        if(!opts.kinds[kind]) continue;
+
+        cout << "\n" << KIND_NAMES[kind] << " meshes\n";
+        cout << "\t" << left << setw(10) << "nodes" << setw(11) << "elements" << setw(15) << "stage"
+             << right << setw(12) << "seconds" << setw(14) << "nodes/s" << setw(10) << "exponent" << "  note\n";
+
+        for(int i = 0; i < opts.nsizes; i++){
+            if(nodes[i] > opts.max_nodes) continue;
+            benchmark_mesh(&opts, kind, sides[i], results[kind][i]);
+
+            for(int s = 0; s < NUM_STAGES; s++){
+                Measurement* m = &results[kind][i][s];
+                cout << "\t" << left << setw(10) << nodes[i] << setw(11) << elems[i] << setw(15) << STAGE_NAMES[s] << right;
+                if(csvFile.is_open()) csvFile << KIND_NAMES[kind] << "," << nodes[i] << "," << elems[i] << "," << STAGE_NAMES[s] << ",";
+
+                if(m->seconds < 0){
+                    cout << setw(12) << "-" << setw(14) << "-" << setw(10) << "-" << "  skipped: " << m->reason << "\n";
+                    if(csvFile.is_open()) csvFile << ",,,skipped: " << m->reason << "\n";
+                    continue;
+                }
+
+                //Exponente respecto al tamaño anterior medido para la misma etapa
+                double exponent = NAN;
+                for(int k = i-1; k >= 0; k--)
+                    if(nodes[k] <= opts.max_nodes && results[kind][k][s].seconds > 0 && nodes[k] < nodes[i]){
+                        if(m->seconds > 0)
+                            exponent = log(m->seconds/results[kind][k][s].seconds)/log((double) nodes[i]/nodes[k]);
+                        break;
+                    }
+                double throughput = (m->seconds > 0)?nodes[i]/m->seconds:0;
+
+                cout << scientific << setprecision(3) << setw(12) << m->seconds << setw(14) << throughput;
+                cout << fixed << setprecision(2) << setw(10);
+                if(isnan(exponent)) cout << "-"; else cout << exponent;
+                if(!m->note.empty()) cout << "  " << m->note;
+                cout << "\n";
+                cout.unsetf(ios::floatfield); cout << setprecision(6);
+
+                if(csvFile.is_open()){
+                    csvFile << m->seconds << "," << throughput << ",";
+                    if(!isnan(exponent)) csvFile << exponent;
+                    csvFile << "," << m->note << "\n";
+                }
+            }
+            cout.flush();
+        }
+    }
+
+    if(csvFile.is_open()) csvFile.close();
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+    Funciones para generar mallas sintéticas de triángulos sobre un dominio
+    cuadrado, con el objetivo de medir el desempeño del proceso MEF2D con
+    mallas de tamaño arbitrario.
+
+    La malla se construye a partir de una cuadrícula de <side> x <side> nodos
+    sobre el cuadrado [0, MESH_LENGTH] x [0, MESH_LENGTH], y cada celda de la
+    cuadrícula se divide en dos triángulos. Se tienen dos variantes:
+        - Estructurada: todos los nodos en su posición exacta de la cuadrícula,
+          todas las celdas divididas por la misma diagonal, y los IDs de nodos
+          y elementos asignados en orden de la cuadrícula.
+        - No estructurada: los nodos interiores desplazados aleatoriamente
+          hasta un 30% del espaciado, cada celda dividida por una diagonal
+          elegida al azar, y los IDs de nodos y elementos permutados al azar,
+          tal como los numera un mallador que no sigue la geometría.
+
+    En ambos casos, los nodos del borde izquierdo tienen condición de Dirichlet,
+    y los nodos del borde derecho tienen condición de Neumann. Los parámetros
+    del material y del tiempo son los mismos de "3rdtest.dat".
+
+    Los elementos se definen siempre en sentido antihorario, al igual que en
+    los archivos generados por GiD.
+*/
+
+//Longitud del lado del dominio cuadrado
+const float MESH_LENGTH = 10;
+
+/*
+    Función auxiliar que llena el arreglo <perm> de longitud <n> con una
+    permutación de los números 0 a n-1.
+
+    Si <shuffle> es falso se coloca la permutación identidad, de lo contrario
+    se utiliza el algoritmo de Fisher-Yates con el generador <rng>.
+*/
+void generate_permutation(DS<int>* perm, int n, bool shuffle, mt19937* rng){
+    for(int i = 0; i < n; i++)
+        SDDS<int>::insert(perm, i, i);
+
+    if(!shuffle) return;
+
+    for(int i = n-1; i > 0; i--){
+        int j = uniform_int_distribution<int>(0, i)(*rng);
+        int a, b;
+        SDDS<int>::extract(perm, i, &a);
+        SDDS<int>::extract(perm, j, &b);
+        SDDS<int>::insert(perm, i, b);
+        SDDS<int>::insert(perm, j, a);
+    }
+}
+
+/*
+    Función para generar una malla sintética.
+
+    Se reciben:
+    - <G> como un objeto Mesh recién instanciado, en el que se colocarán todos
+      los datos de la malla generada, tal como lo hace read_input_file.
+    - <side> como la cantidad de nodos por lado de la cuadrícula, por lo que la
+      malla tendrá side^2 nodos y 2*(side-1)^2 elementos.
+    - <unstructured> para indicar si se genera la variante no estructurada.
+    - <seed> como la semilla del generador aleatorio, de modo que una misma
+      semilla produce siempre la misma malla.
+*/
+void generate_mesh(Mesh* G, int side, bool unstructured, unsigned int seed){
+    mt19937 rng(seed);
+
+    int nnodes = side*side;
+    int nelems = 2*(side-1)*(side-1);
+    float h = MESH_LENGTH/(side-1);     //Espaciado de la cuadrícula
+    uniform_real_distribution<float> jitter(-0.3*h, 0.3*h);
+    uniform_int_distribution<int> coin(0, 1);
+
+    G->set_parameters(500, 35, 0.8, 20, 12, 5, 5, 0.5, 0, 5);
+    G->set_quantities(nnodes, nelems, side, side);
+    G->init_geometry();
+
+    //Se asignan los IDs de nodos, permutados en la variante no estructurada.
+    //El nodo de la columna i y la fila j de la cuadrícula tiene el ID node_ids[j*side + i] + 1
+    DS<int>* node_ids;
+    SDDS<int>::create(&node_ids, nnodes, ARRAY);
+    generate_permutation(node_ids, nnodes, unstructured, &rng);
+
+    //Se conservan los nodos en orden de la cuadrícula para construir los elementos
+    DS<FEMNode*>* grid;
+    SDDS<FEMNode*>::create(&grid, nnodes, ARRAY);
+
+    int id, ndirichlet = 0, nneumann = 0;
+    for(int j = 0; j < side; j++)
+        for(int i = 0; i < side; i++){
+            float x = i*h, y = j*h;
+            //En la variante no estructurada, los nodos interiores se desplazan
+            if(unstructured && i > 0 && i < side-1 && j > 0 && j < side-1){
+                x += jitter(rng);
+                y += jitter(rng);
+            }
+
+            Point* P = new Point();
+            P->set_x(x);
+            P->set_y(y);
+
+            SDDS<int>::extract(node_ids, j*side + i, &id);
+            FEMNode* node = new FEMNode(id+1, P);
+
+            //Cada nodo se coloca en el arreglo de la malla en la posición de su ID,
+            //de modo que el archivo generado los lista en orden de ID
+            G->add_node(node, id);
+            SDDS<FEMNode*>::insert(grid, j*side + i, node);
+
+            //Borde izquierdo con Dirichlet, borde derecho con Neumann
+            if(i == 0)      G->add_dirichlet_cond(node, ndirichlet++);
+            if(i == side-1) G->add_neumann_cond(node, nneumann++);
+        }
+
+    //Se asignan los IDs de elementos, permutados en la variante no estructurada
+    DS<int>* elem_ids;
+    SDDS<int>::create(&elem_ids, nelems, ARRAY);
+    generate_permutation(elem_ids, nelems, unstructured, &rng);
+
+    int k = 0;
+    for(int j = 0; j < side-1; j++)
+        for(int i = 0; i < side-1; i++){
+            //Esquinas de la celda en sentido antihorario
+            FEMNode *a, *b, *c, *d;
+            SDDS<FEMNode*>::extract(grid, j*side + i, &a);
+            SDDS<FEMNode*>::extract(grid, j*side + i+1, &b);
+            SDDS<FEMNode*>::extract(grid, (j+1)*side + i+1, &c);
+            SDDS<FEMNode*>::extract(grid, (j+1)*side + i, &d);
+
+            int e1, e2;
+            SDDS<int>::extract(elem_ids, k++, &e1);
+            SDDS<int>::extract(elem_ids, k++, &e2);
+
+            //La diagonal a-c se utiliza siempre en la variante estructurada, y
+            //se alterna al azar con la diagonal b-d en la no estructurada
+            if(!unstructured || coin(rng) == 0){
+                G->add_element(new Element(e1+1, a, b, c), e1);
+                G->add_element(new Element(e2+1, a, c, d), e2);
+            }
+            else{
+                G->add_element(new Element(e1+1, a, b, d), e1);
+                G->add_element(new Element(e2+1, b, c, d), e2);
+            }
+        }
+
+    SDDS<int>::destroy(node_ids);
+    SDDS<int>::destroy(elem_ids);
+    SDDS<FEMNode*>::destroy(grid);
+}
@@ -0,0 +1,822 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+#include "../utilities/precision_utilities.h"
+#include "../data_structures/SDDS.h"
+
+/*
+    Programa de medición de desempeño de la biblioteca de estructuras de datos.
+
+    Para cada categoría de estructura de datos (ARRAY, MATRIX, SINGLE_LINKED_LIST,
+    DOUBLE_LINKED_LIST, BINARY_SEARCH_TREE y GRAPH) se miden las operaciones que
+    la categoría soporta, en tres variantes:
+        - sdds      A través de la clase utilitaria SDDS, es decir, con el
+                    despacho por getCategory() y las llamadas virtuales.
+        - direct    Invocando directamente los métodos de la clase concreta
+                    (DSA, DSM, DSSL, DSDL, DST o DSG), sin pasar por SDDS.
+        - baseline  Con un arreglo crudo o el contenedor estándar equivalente:
+                    int* para ARRAY y MATRIX, forward_list, list, multiset y
+                    unordered_map para las demás categorías.
+
+    Las operaciones medidas son:
+        - create        Crear y liberar la estructura (vacía en las dinámicas,
+                        de n posiciones en las estáticas).
+        - insert        Crear la estructura, insertar n datos y liberarla.
+        - push_back     Igual que insert, pero añadiendo al final (solo listas).
+        - sorted        Igual que insert, pero con los datos 0 a n-1 en orden
+                        (solo árboles). sorted(avl) utiliza el árbol balanceado.
+        - extract       Extraer el dato de posiciones (o IDs) al azar.
+        - search        Buscar valores al azar, la mitad de ellos presentes.
+        - count         Contar las ocurrencias de valores al azar.
+        - extension     Obtener la longitud de la estructura.
+        - reverse       Invertir el contenido de la estructura.
+        - create_copy   Copiar la estructura completa y liberar la copia.
+        - connect       Crear un grafo de n nodos, definir las conexiones de
+                        cada nodo con sus 4 vecinos en un anillo, construir
+                        las conexiones en formato CSR y liberarlo (solo grafos).
+        - bfs, dfs      Recorrer en anchura o en profundidad el grafo anterior
+                        desde un nodo (solo grafos).
+        - components    Determinar las componentes conexas del grafo anterior
+                        (solo grafos).
+        - dijkstra      Calcular los caminos más cortos desde un nodo del grafo
+                        anterior, con pesos dados por sus datos (solo grafos).
+                        La columna sdds obtiene un único camino con
+                        shortest_path().
+
+    Todos los tiempos se reportan en nanosegundos por operación, tomando el menor
+    de las repeticiones, junto con el cociente sdds / baseline como medida del
+    costo de la abstracción. Las operaciones que una variante no ofrece se
+    muestran con "-".
+
+    Para las estructuras dinámicas se mide además la operación "pool": crear la
+    estructura, insertar n datos y liberarla, invocando directamente la clase
+    concreta con PoolAllocator (columna direct) y con el asignador por defecto
+    (columna baseline).
+
+    Además, se verifica con el contador de reservas de Perf que la inversión de
+    las listas enlazadas no reserve memoria; si lo hace, el programa termina con
+    error.
+
+    Compilación y ejecución, desde este directorio:
+
+            g++ -O2 -o sdds_benchmark sdds_benchmark.cpp
+            ./sdds_benchmark [opciones]
+
+    Opciones:
+        --sizes <n1,n2,...>     Cantidades de datos a medir (por defecto 100,1000,10000).
+        --repeat <r>            Repeticiones por medición (por defecto 5).
+        --queries <q>           Consultas por medición de extract, search y count
+                                (por defecto 1000).
+        --seed <s>              Semilla para los datos y las consultas (por defecto 1).
+        --csv <archivo>         Guarda además los resultados en formato CSV.
+*/
+
+template <typename T>
+thread_local Data SDDS<T>::ref = Data();
+
+//Cantidad máxima de tamaños a medir
+const int MAX_SIZES = 16;
+
+/*
+    Estructura BenchOptions utilizada para almacenar las opciones recibidas
+    en la línea de comandos, con un constructor genérico que coloca los
+    valores por defecto.
+*/
+typedef struct BenchOptions{
+    long sizes[MAX_SIZES];
+    int nsizes;
+    int repeat;
+    int queries;
+    unsigned int seed;
+    char* csv;
+    BenchOptions(){
+        long defaults[] = {100,1000,10000};
+        nsizes = 3;
+        for(int i = 0; i < nsizes; i++) sizes[i] = defaults[i];
+        repeat = 5;
+        queries = 1000;
+        seed = 1;
+        csv = NULL;
+    }
+} BenchOptions;
+
+/*
+    Datos compartidos por todas las mediciones de un mismo tamaño:
+    - <values> contiene una permutación al azar de 0 a n-1, que son los datos
+      a insertar. Se insertan al azar para que el árbol binario de búsqueda
+      no degenere en una lista.
+    - <positions> contiene posiciones al azar para las extracciones.
+    - <queries> contiene valores al azar entre 0 y 2n-1 para las búsquedas y
+      los conteos, de modo que aproximadamente la mitad están presentes.
+*/
+int *values, *positions, *queries;
+int n, nqueries, repeat;
+
+//Acumulador de resultados, para que el compilador no elimine las operaciones medidas
+long long sink = 0;
+
+//Estructura cuya extensión se mide a través de SDDS. Se accede desde una
+//variable global para que el compilador no conozca su clase concreta, como
+//ocurre con cualquier llamador de SDDS
+DS<int>* measured;
+
+ofstream csvFile;
+
+void show_usage(char* program){
+    cout << "Usage: " << program << " [--sizes <n1,n2,...>] [--repeat <r>] [--queries <q>] [--seed <s>] [--csv <file>]\n";
+    exit(EXIT_FAILURE);
+}
+
+BenchOptions parse_options(int argc, char** argv){
+    BenchOptions opts;
+
+    for(int i = 1; i < argc; i++){
+        string arg(argv[i]);
+        if(i+1 >= argc) show_usage(argv[0]);
+
+        if(arg == "--sizes"){
+            //Se separan los tamaños indicados por comas
+            opts.nsizes = 0;
+            char* token = strtok(argv[++i], ",");
+            while(token != NULL && opts.nsizes < MAX_SIZES){
+                opts.sizes[opts.nsizes++] = atol(token);
+                token = strtok(NULL, ",");
+            }
+        }
+        else if(arg == "--repeat")  opts.repeat = max(1, atoi(argv[++i]));
+        else if(arg == "--queries") opts.queries = max(1, atoi(argv[++i]));
+        else if(arg == "--seed")    opts.seed = atoi(argv[++i]);
+        else if(arg == "--csv")     opts.csv = argv[++i];
+        else show_usage(argv[0]);
+    }
+
+    return opts;
+}
+
+/*
+    Función que ejecuta <repeat> veces el bloque <body>, el cual realiza
+    <ops> operaciones, y retorna el menor tiempo en nanosegundos por operación.
+*/
+template <typename Body>
+double measure(long ops, Body body){
+    double best = -1;
+    for(int r = 0; r < repeat; r++){
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        body();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count()/ops;
+        if(best < 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+/*
+    Función que verifica que el bloque <body> no reserve memoria, comparando el
+    contador de reservas de Perf antes y después de ejecutarlo. Si se registra
+    alguna reserva, se reporta la operación <op> de la categoría <cat> y se
+    termina el programa con error.
+*/
+template <typename Body>
+void check_no_allocations(const char* cat, const char* op, Body body){
+    long before = Perf::get_allocations();
+    body();
+    long allocations = Perf::get_allocations() - before;
+    if(allocations != 0){
+        cerr << "\n" << cat << " " << op << " reserved memory " << allocations << " times, expected none.\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+    Función que verifica que la copia del grafo <G>, obtenida con create_copy(),
+    conserve sus conexiones: el recorrido en anchura desde el nodo 0 y la
+    cantidad de componentes conexas deben coincidir con los del original. En
+    caso contrario se reporta la diferencia y se termina el programa con error.
+*/
+void check_graph_copy(DS<int>* G){
+    DS<int>* copy;
+    SDDS<int>::create_copy(G, &copy);
+
+    DS<int> *O, *P;
+    int n1 = 0, n2 = 0, c1 = 0, c2 = 0;
+    SDDS<int>::bfs(G, 0, &O); SDDS<int>::extension(O, &n1);
+    SDDS<int>::bfs(copy, 0, &P); SDDS<int>::extension(P, &n2);
+    bool same = n1 == n2;
+    for(int i = 0; same && i < n1; i++){
+        int a, b;
+        SDDS<int>::extract(O, i, &a); SDDS<int>::extract(P, i, &b);
+        same = a == b;
+    }
+    SDDS<int>::connected_components(G, &c1);
+    SDDS<int>::connected_components(copy, &c2);
+
+    SDDS<int>::destroy(O); delete O;
+    SDDS<int>::destroy(P); delete P;
+    SDDS<int>::destroy(copy); delete copy;
+
+    if(!same || c1 != c2){
+        cerr << "\nGRAPH create_copy does not preserve the connections: bfs visits " << n1 << " vs " << n2
+             << " nodes, " << c1 << " vs " << c2 << " components.\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+    Función que muestra una fila de resultados. Un tiempo negativo indica
+    que la variante no ofrece la operación.
+*/
+void report(const char* cat, const char* op, double sdds, double direct, const char* base_name, double base){
+    cout << "\t" << left << setw(20) << cat << setw(13) << op << right << fixed << setprecision(1);
+    if(sdds < 0)   cout << setw(12) << "-"; else cout << setw(12) << sdds;
+    if(direct < 0) cout << setw(12) << "-"; else cout << setw(12) << direct;
+    if(base < 0)   cout << setw(12) << "-"; else cout << setw(12) << base;
+    cout << setprecision(2);
+    if(sdds < 0 || base <= 0) cout << setw(10) << "-";
+    else if(sdds/base > 9999) cout << setw(10) << ">9999";
+    else cout << setw(10) << sdds/base;
+    cout << "   " << base_name << "\n";
+    cout.unsetf(ios::floatfield); cout << setprecision(6);
+
+    if(csvFile.is_open()){
+        csvFile << n << "," << cat << "," << op << ",";
+        if(sdds >= 0) csvFile << sdds;
+        csvFile << ",";
+        if(direct >= 0) csvFile << direct;
+        csvFile << "," << base_name << ",";
+        if(base >= 0) csvFile << base;
+        csvFile << "\n";
+    }
+}
+
+/*==================== ARRAY ====================*/
+void bench_array(){
+    DS<int>* S; DSA<int>* D; int* B;
+    double sdds, direct, base;
+
+    sdds = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DS<int>* A; SDDS<int>::create(&A, n, ARRAY); SDDS<int>::destroy(A); delete A; } });
+    direct = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DSA<int>* A = new DSA<int>(); A->create(n); sink += (long long) A; A->destroy(); delete A; } });
+    base = measure(1000, [](){ for(int r = 0; r < 1000; r++){ int* A = (int*) malloc(sizeof(int)*n); sink += (long long) A; free(A); } });
+    report("ARRAY", "create", sdds, direct, "int*", base);
+
+    sdds = measure(n, [](){ DS<int>* A; SDDS<int>::create(&A, n, ARRAY); for(int i = 0; i < n; i++) SDDS<int>::insert(A, i, values[i]); SDDS<int>::destroy(A); delete A; });
+    direct = measure(n, [](){ DSA<int>* A = new DSA<int>(); A->create(n); for(int i = 0; i < n; i++) A->insert(i, values[i]); A->destroy(); delete A; });
+    base = measure(n, [](){ int* A = (int*) malloc(sizeof(int)*n); for(int i = 0; i < n; i++) A[i] = values[i]; sink += A[n-1]; free(A); });
+    report("ARRAY", "insert", sdds, direct, "int*", base);
+
+    //Estructuras ya llenas para las demás operaciones
+    SDDS<int>::create(&S, n, ARRAY);
+    D = new DSA<int>(); D->create(n);
+    B = (int*) malloc(sizeof(int)*n);
+    for(int i = 0; i < n; i++){ SDDS<int>::insert(S, i, values[i]); D->insert(i, values[i]); B[i] = values[i]; }
+
+    sdds = measure(nqueries, [S](){ int v; for(int q = 0; q < nqueries; q++){ SDDS<int>::extract(S, positions[q], &v); sink += v; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extract(positions[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += B[positions[q]]; });
+    report("ARRAY", "extract", sdds, direct, "int*", base);
+
+    sdds = measure(nqueries, [S](){ bool r; for(int q = 0; q < nqueries; q++){ SDDS<int>::search(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->search(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += (find(B, B+n, queries[q]) != B+n); });
+    report("ARRAY", "search", sdds, direct, "int*", base);
+
+    sdds = measure(nqueries, [S](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::count(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->count(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += count(B, B+n, queries[q]); });
+    report("ARRAY", "count", sdds, direct, "int*", base);
+
+    measured = S;
+    sdds = measure(nqueries, [](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::extension(measured, &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extension(); });
+    report("ARRAY", "extension", sdds, direct, "-", -1);
+
+    sdds = measure(n, [S](){ SDDS<int>::reverse(S); });
+    direct = measure(n, [D](){ D->reverse(); });
+    base = measure(n, [B](){ reverse(B, B+n); sink += B[0]; });
+    report("ARRAY", "reverse", sdds, direct, "int*", base);
+
+    sdds = measure(n, [S](){ DS<int>* C; SDDS<int>::create_copy(S, &C); SDDS<int>::destroy(C); delete C; });
+    base = measure(n, [B](){ int* C = (int*) malloc(sizeof(int)*n); memcpy(C, B, sizeof(int)*n); sink += C[0]; free(C); });
+    report("ARRAY", "create_copy", sdds, -1, "int*", base);
+
+    SDDS<int>::destroy(S); delete S;
+    D->destroy(); delete D;
+    free(B);
+}
+
+/*==================== MATRIX ====================*/
+void bench_matrix(){
+    //La matriz es cuadrada, con aproximadamente n celdas
+    static int side;
+    side = max(1, (int) lround(sqrt((double) n)));
+    int cells = side*side;
+    DS<int>* S; DSM<int>* D; int* B;
+    double sdds, direct, base;
+
+    sdds = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DS<int>* M; SDDS<int>::create(&M, side, side, MATRIX); SDDS<int>::destroy(M); delete M; } });
+    direct = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DSM<int>* M = new DSM<int>(); Data d; d.n = side; d.m = side; M->create(d); sink += (long long) M; M->destroy(); delete M; } });
+    base = measure(1000, [](){ for(int r = 0; r < 1000; r++){ int* M = (int*) malloc(sizeof(int)*side*side); sink += (long long) M; free(M); } });
+    report("MATRIX", "create", sdds, direct, "int* (row-major)", base);
+
+    sdds = measure(cells, [](){ DS<int>* M; SDDS<int>::create(&M, side, side, MATRIX);
+                                for(int i = 0; i < side; i++) for(int j = 0; j < side; j++) SDDS<int>::insert(M, i, j, values[(i*side + j) % n]);
+                                SDDS<int>::destroy(M); delete M; });
+    direct = measure(cells, [](){ DSM<int>* M = new DSM<int>(); Data d; d.n = side; d.m = side; M->create(d);
+                                  for(int i = 0; i < side; i++) for(int j = 0; j < side; j++){ d.n = i; d.m = j; M->insert(d, values[(i*side + j) % n]); }
+                                  M->destroy(); delete M; });
+    base = measure(cells, [](){ int* M = (int*) malloc(sizeof(int)*side*side);
+                                for(int i = 0; i < side; i++) for(int j = 0; j < side; j++) M[i*side + j] = values[(i*side + j) % n];
+                                sink += M[0]; free(M); });
+    report("MATRIX", "insert", sdds, direct, "int* (row-major)", base);
+
+    SDDS<int>::create(&S, side, side, MATRIX);
+    D = new DSM<int>(); { Data d; d.n = side; d.m = side; D->create(d); }
+    B = (int*) malloc(sizeof(int)*cells);
+    for(int i = 0; i < side; i++)
+        for(int j = 0; j < side; j++){
+            int v = values[(i*side + j) % n];
+            Data d; d.n = i; d.m = j;
+            SDDS<int>::insert(S, i, j, v); D->insert(d, v); B[i*side + j] = v;
+        }
+
+    sdds = measure(nqueries, [S](){ int v; for(int q = 0; q < nqueries; q++){ int p = positions[q] % (side*side); SDDS<int>::extract(S, p / side, p % side, &v); sink += v; } });
+    direct = measure(nqueries, [D](){ Data d; for(int q = 0; q < nqueries; q++){ int p = positions[q] % (side*side); d.n = p / side; d.m = p % side; sink += D->extract(d); } });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += B[positions[q] % (side*side)]; });
+    report("MATRIX", "extract", sdds, direct, "int* (row-major)", base);
+
+    sdds = measure(nqueries, [S](){ bool r; for(int q = 0; q < nqueries; q++){ SDDS<int>::search(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->search(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += (find(B, B+side*side, queries[q]) != B+side*side); });
+    report("MATRIX", "search", sdds, direct, "int* (row-major)", base);
+
+    sdds = measure(nqueries, [S](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::count(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->count(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += count(B, B+side*side, queries[q]); });
+    report("MATRIX", "count", sdds, direct, "int* (row-major)", base);
+
+    sdds = measure(cells, [S](){ DS<int>* C; SDDS<int>::create_copy(S, &C); SDDS<int>::destroy(C); delete C; });
+    base = measure(cells, [B](){ int* C = (int*) malloc(sizeof(int)*side*side); memcpy(C, B, sizeof(int)*side*side); sink += C[0]; free(C); });
+    report("MATRIX", "create_copy", sdds, -1, "int* (row-major)", base);
+
+    SDDS<int>::destroy(S); delete S;
+    D->destroy(); delete D;
+    free(B);
+}
+
+/*
+    Funciones que llenan un contenedor estándar añadiendo los datos al final,
+    como referencia para push_back(). forward_list no tiene push_back, por lo
+    que se conserva un iterador al último elemento.
+*/
+void std_fill_back(forward_list<int>* L){
+    auto last = L->before_begin();
+    for(int i = 0; i < n; i++) last = L->insert_after(last, values[i]);
+}
+
+void std_fill_back(list<int>* L){
+    for(int i = 0; i < n; i++) L->push_back(values[i]);
+}
+
+/*
+    Función que mide una lista enlazada, simple o doble, contra su contenedor
+    estándar equivalente.
+
+    <List> es la clase concreta (DSSL o DSDL), <Std> el contenedor estándar
+    (forward_list o list), y <cat> la categoría correspondiente.
+*/
+template <class List, class Std>
+void bench_list(category cat, const char* cat_name, const char* std_name){
+    static category list_cat;
+    list_cat = cat;
+    DS<int>* S = NULL; List* D; Std* B;
+    double sdds, direct, base;
+
+    sdds = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DS<int>* L = NULL; SDDS<int>::create(&L, list_cat); SDDS<int>::destroy(L); delete L; } });
+    direct = measure(1000, [](){ for(int r = 0; r < 1000; r++){ List* L = new List(); L->create(); sink += (long long) L; L->destroy(); delete L; } });
+    base = measure(1000, [](){ for(int r = 0; r < 1000; r++){ Std* L = new Std(); sink += (long long) L; delete L; } });
+    report(cat_name, "create", sdds, direct, std_name, base);
+
+    sdds = measure(n, [](){ DS<int>* L = NULL; SDDS<int>::create(&L, list_cat); for(int i = 0; i < n; i++) SDDS<int>::insert(L, values[i]); SDDS<int>::destroy(L); delete L; });
+    direct = measure(n, [](){ List* L = new List(); L->create(); for(int i = 0; i < n; i++) L->insert(values[i]); L->destroy(); delete L; });
+    base = measure(n, [](){ Std* L = new Std(); for(int i = 0; i < n; i++) L->push_front(values[i]); sink += L->front(); delete L; });
+    report(cat_name, "insert", sdds, direct, std_name, base);
+
+    sdds = measure(n, [](){ DS<int>* L = NULL; SDDS<int>::create(&L, list_cat); for(int i = 0; i < n; i++) SDDS<int>::push_back(L, values[i]); SDDS<int>::destroy(L); delete L; });
+    direct = measure(n, [](){ List* L = new List(); L->create(); for(int i = 0; i < n; i++) L->push_back(values[i]); L->destroy(); delete L; });
+    base = measure(n, [](){ Std* L = new Std(); std_fill_back(L); sink += L->front(); delete L; });
+    report(cat_name, "push_back", sdds, direct, std_name, base);
+
+    SDDS<int>::create(&S, cat);
+    D = new List(); D->create();
+    B = new Std();
+    for(int i = 0; i < n; i++){ SDDS<int>::insert(S, values[i]); D->insert(values[i]); B->push_front(values[i]); }
+
+    sdds = measure(nqueries, [S](){ int v; for(int q = 0; q < nqueries; q++){ SDDS<int>::extract(S, positions[q], &v); sink += v; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extract(positions[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += *next(B->begin(), positions[q]); });
+    report(cat_name, "extract", sdds, direct, std_name, base);
+
+    sdds = measure(nqueries, [S](){ bool r; for(int q = 0; q < nqueries; q++){ SDDS<int>::search(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->search(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += (find(B->begin(), B->end(), queries[q]) != B->end()); });
+    report(cat_name, "search", sdds, direct, std_name, base);
+
+    sdds = measure(nqueries, [S](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::count(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->count(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += count(B->begin(), B->end(), queries[q]); });
+    report(cat_name, "count", sdds, direct, std_name, base);
+
+    measured = S;
+    sdds = measure(nqueries, [](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::extension(measured, &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extension(); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += distance(B->begin(), B->end()); });
+    report(cat_name, "extension", sdds, direct, std_name, base);
+
+    sdds = measure(n, [S](){ SDDS<int>::reverse(S); });
+    direct = measure(n, [D](){ D->reverse(); });
+    base = measure(n, [B](){ B->reverse(); sink += B->front(); });
+    report(cat_name, "reverse", sdds, direct, std_name, base);
+
+    //La inversión se realiza en el lugar, por lo que no debe reservar memoria
+    check_no_allocations(cat_name, "reverse", [S, D](){ SDDS<int>::reverse(S); D->reverse(); });
+
+    sdds = measure(n, [S](){ DS<int>* C; SDDS<int>::create_copy(S, &C); SDDS<int>::destroy(C); delete C; });
+    base = measure(n, [B](){ Std* C = new Std(*B); sink += C->front(); delete C; });
+    report(cat_name, "create_copy", sdds, -1, std_name, base);
+
+    SDDS<int>::destroy(S); delete S;
+    D->destroy(); delete D;
+    delete B;
+}
+
+/*==================== BINARY_SEARCH_TREE ====================*/
+void bench_tree(){
+    DS<int>* S; DST<int>* D; multiset<int>* B;
+    double sdds, direct, base;
+
+    sdds = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DS<int>* T; SDDS<int>::create(&T, BINARY_SEARCH_TREE); SDDS<int>::destroy(T); delete T; } });
+    direct = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DST<int>* T = new DST<int>(); T->create(); sink += (long long) T; T->destroy(); delete T; } });
+    base = measure(1000, [](){ for(int r = 0; r < 1000; r++){ multiset<int>* T = new multiset<int>(); sink += (long long) T; delete T; } });
+    report("BINARY_SEARCH_TREE", "create", sdds, direct, "multiset", base);
+
+    sdds = measure(n, [](){ DS<int>* T; SDDS<int>::create(&T, BINARY_SEARCH_TREE); for(int i = 0; i < n; i++) SDDS<int>::insert(T, values[i]); SDDS<int>::destroy(T); delete T; });
+    direct = measure(n, [](){ DST<int>* T = new DST<int>(); T->create(); for(int i = 0; i < n; i++) T->insert(values[i]); T->destroy(); delete T; });
+    base = measure(n, [](){ multiset<int>* T = new multiset<int>(); for(int i = 0; i < n; i++) T->insert(values[i]); sink += *T->begin(); delete T; });
+    report("BINARY_SEARCH_TREE", "insert", sdds, direct, "multiset", base);
+
+    //Inserción de datos ordenados, el peor caso del árbol sin balancear
+    sdds = measure(n, [](){ DS<int>* T; SDDS<int>::create(&T, BINARY_SEARCH_TREE); for(int i = 0; i < n; i++) SDDS<int>::insert(T, i); SDDS<int>::destroy(T); delete T; });
+    direct = measure(n, [](){ DST<int>* T = new DST<int>(); T->create(); for(int i = 0; i < n; i++) T->insert(i); T->destroy(); delete T; });
+    base = measure(n, [](){ multiset<int>* T = new multiset<int>(); for(int i = 0; i < n; i++) T->insert(i); sink += *T->begin(); delete T; });
+    report("BINARY_SEARCH_TREE", "sorted", sdds, direct, "multiset", base);
+
+    sdds = measure(n, [](){ DS<int>* T; SDDS<int>::create(&T, BINARY_SEARCH_TREE, true); for(int i = 0; i < n; i++) SDDS<int>::insert(T, i); SDDS<int>::destroy(T); delete T; });
+    direct = measure(n, [](){ DST<int>* T = new DST<int>(); T->create(true); for(int i = 0; i < n; i++) T->insert(i); T->destroy(); delete T; });
+    report("BINARY_SEARCH_TREE", "sorted(avl)", sdds, direct, "multiset", base);
+
+    SDDS<int>::create(&S, BINARY_SEARCH_TREE);
+    D = new DST<int>(); D->create();
+    B = new multiset<int>();
+    for(int i = 0; i < n; i++){ SDDS<int>::insert(S, values[i]); D->insert(values[i]); B->insert(values[i]); }
+
+    sdds = measure(nqueries, [S](){ bool r; for(int q = 0; q < nqueries; q++){ SDDS<int>::search(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->search(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += (B->find(queries[q]) != B->end()); });
+    report("BINARY_SEARCH_TREE", "search", sdds, direct, "multiset", base);
+
+    sdds = measure(nqueries, [S](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::count(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->count(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += B->count(queries[q]); });
+    report("BINARY_SEARCH_TREE", "count", sdds, direct, "multiset", base);
+
+    //La extensión de un árbol es su altura, que el contenedor estándar no ofrece
+    measured = S;
+    sdds = measure(nqueries, [](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::extension(measured, &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extension(); });
+    report("BINARY_SEARCH_TREE", "extension", sdds, direct, "-", -1);
+
+    sdds = measure(n, [S](){ DS<int>* C; SDDS<int>::create_copy(S, &C); SDDS<int>::destroy(C); delete C; });
+    base = measure(n, [B](){ multiset<int>* C = new multiset<int>(*B); sink += *C->begin(); delete C; });
+    report("BINARY_SEARCH_TREE", "create_copy", sdds, -1, "multiset", base);
+
+    SDDS<int>::destroy(S); delete S;
+    D->destroy(); delete D;
+    delete B;
+}
+
+/*==================== POOL ====================*/
+/*
+    Función que mide la construcción y liberación de una estructura dinámica
+    con el asignador por bloques <Pooled> contra el asignador por defecto
+    <Plain>. <fill> inserta los n datos en la estructura recibida.
+*/
+template <class Plain, class Pooled, typename Fill>
+void bench_pool(const char* cat_name, Fill fill){
+    double pooled = measure(n, [fill](){ Pooled* S = new Pooled(); S->create(); fill(S); sink += S->extension(); S->destroy(); delete S; });
+    double plain = measure(n, [fill](){ Plain* S = new Plain(); S->create(); fill(S); sink += S->extension(); S->destroy(); delete S; });
+    report(cat_name, "pool", -1, pooled, "malloc", plain);
+}
+
+/*==================== GRAPH ====================*/
+/*
+    Implementaciones de referencia de los algoritmos sobre grafos, con
+    contenedores estándar, sobre el grafo <R> representado como vector de
+    vectores de índices. Se utilizan como línea base de las mediciones y para
+    verificar los resultados de DSG (ver check_graph_algorithms()).
+*/
+int reference_bfs(vector<vector<int>>* R, int* level){
+    for(int i = 0; i < n; i++) level[i] = -1;
+    queue<int> Q; Q.push(0); level[0] = 0; int cont = 0;
+    while(!Q.empty()){ int v = Q.front(); Q.pop(); cont++; for(int w : (*R)[v]) if(level[w] == -1){ level[w] = level[v] + 1; Q.push(w); } }
+    return cont;
+}
+
+int reference_dfs(vector<vector<int>>* R){
+    vector<bool> visited(n); vector<int> stack; stack.push_back(0); int cont = 0;
+    while(!stack.empty()){ int v = stack.back(); stack.pop_back(); if(visited[v]) continue; visited[v] = true; cont++; for(int w : (*R)[v]) if(!visited[w]) stack.push_back(w); }
+    return cont;
+}
+
+int reference_components(vector<vector<int>>* R, int* component){
+    for(int i = 0; i < n; i++) component[i] = -1;
+    int ncomp = 0;
+    for(int s = 0; s < n; s++){
+        if(component[s] != -1) continue;
+        queue<int> Q; Q.push(s); component[s] = ncomp;
+        while(!Q.empty()){ int v = Q.front(); Q.pop(); for(int w : (*R)[v]) if(component[w] == -1){ component[w] = ncomp; Q.push(w); } }
+        ncomp++;
+    }
+    return ncomp;
+}
+
+template <typename Weight>
+void reference_dijkstra(vector<vector<int>>* R, DSG<int>* D, Weight weight, double* dist){
+    for(int i = 0; i < n; i++) dist[i] = -1;
+    priority_queue<pair<double,int>, vector<pair<double,int>>, greater<pair<double,int>>> Q;
+    dist[0] = 0; Q.push(make_pair(0.0, 0));
+    while(!Q.empty()){
+        pair<double,int> top = Q.top(); Q.pop();
+        if(top.first > dist[top.second]) continue;
+        for(int w : (*R)[top.second]){
+            double d = top.first + weight(D->vertex(top.second), D->vertex(w));
+            if(dist[w] < 0 || d < dist[w]){ dist[w] = d; Q.push(make_pair(d, w)); }
+        }
+    }
+}
+
+/*
+    Función que verifica los resultados de los algoritmos de DSG sobre el grafo
+    <S>, cuya implementación es <D>, contra las implementaciones de referencia
+    sobre su equivalente <R>: los niveles del recorrido en anchura, la cantidad
+    de nodos del recorrido en profundidad, las componentes conexas y las
+    distancias de Dijkstra con <weight>, tanto de DSG como de las funciones de
+    SDDS. Si algún resultado difiere se reporta el algoritmo y se termina el
+    programa con error.
+*/
+template <typename Weight>
+void check_graph_algorithms(DS<int>* S, DSG<int>* D, vector<vector<int>>* R, Weight weight){
+    int* order = (int*) malloc(sizeof(int)*n);
+    int* expected = (int*) malloc(sizeof(int)*n);
+    int* obtained = (int*) malloc(sizeof(int)*n);
+    double* dist_expected = (double*) malloc(sizeof(double)*n);
+    double* dist_obtained = (double*) malloc(sizeof(double)*n);
+    const char* wrong = NULL;
+
+    //Recorrido en anchura: cantidad de nodos visitados y nivel de cada uno
+    DS<int>* O; int visited = 0;
+    int nbfs = reference_bfs(R, expected);
+    SDDS<int>::bfs(S, 0, &O); SDDS<int>::extension(O, &visited);
+    SDDS<int>::destroy(O); delete O;
+    if(D->bfs(0, order, obtained) != nbfs || visited != nbfs) wrong = "bfs";
+    for(int i = 0; wrong == NULL && i < n; i++)
+        if(obtained[i] != expected[i]) wrong = "bfs";
+
+    //Recorrido en profundidad: cantidad de nodos visitados
+    int ndfs = reference_dfs(R);
+    SDDS<int>::dfs(S, 0, &O); SDDS<int>::extension(O, &visited);
+    SDDS<int>::destroy(O); delete O;
+    if(wrong == NULL && (D->dfs(0, order) != ndfs || visited != ndfs)) wrong = "dfs";
+
+    //Componentes conexas: cantidad y componente de cada nodo
+    int ncomp = reference_components(R, expected), count = 0;
+    SDDS<int>::connected_components(S, &count);
+    if(wrong == NULL && (D->components(obtained) != ncomp || count != ncomp)) wrong = "components";
+    for(int i = 0; wrong == NULL && i < n; i++)
+        if(obtained[i] != expected[i]) wrong = "components";
+
+    //Dijkstra: distancia a cada nodo; los pesos son enteros, por lo que las
+    //sumas son exactas y las distancias deben coincidir exactamente
+    reference_dijkstra(R, D, weight, dist_expected);
+    D->dijkstra(0, weight, dist_obtained, NULL);
+    for(int i = 0; wrong == NULL && i < n; i++)
+        if(dist_obtained[i] != dist_expected[i]) wrong = "dijkstra";
+    double length; DS<int>* P;
+    SDDS<int>::shortest_path(S, 0, n/2, weight, &length, &P);
+    SDDS<int>::destroy(P); delete P;
+    if(wrong == NULL && length != dist_expected[n/2]) wrong = "dijkstra";
+
+    free(order); free(expected); free(obtained);
+    free(dist_expected); free(dist_obtained);
+
+    if(wrong != NULL){
+        cerr << "\nGRAPH " << wrong << " does not match the reference implementation.\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+void bench_graph(){
+    DS<int>* S; DSG<int>* D; unordered_map<int,int>* B;
+    double sdds, direct, base;
+
+    sdds = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DS<int>* G; SDDS<int>::create(&G, GRAPH); SDDS<int>::destroy(G); delete G; } });
+    direct = measure(1000, [](){ for(int r = 0; r < 1000; r++){ DSG<int>* G = new DSG<int>(); G->create(); sink += (long long) G; G->destroy(); delete G; } });
+    base = measure(1000, [](){ for(int r = 0; r < 1000; r++){ unordered_map<int,int>* G = new unordered_map<int,int>(); sink += (long long) G; delete G; } });
+    report("GRAPH", "create", sdds, direct, "unordered_map", base);
+
+    //Los nodos se insertan con IDs de 0 a n-1, y con los datos al azar
+    sdds = measure(n, [](){ DS<int>* G; SDDS<int>::create(&G, GRAPH); for(int i = 0; i < n; i++) SDDS<int>::insert(G, i, values[i]); SDDS<int>::destroy(G); delete G; });
+    direct = measure(n, [](){ DSG<int>* G = new DSG<int>(); G->create(); for(int i = 0; i < n; i++) G->insert(i, values[i]); G->destroy(); delete G; });
+    base = measure(n, [](){ unordered_map<int,int>* G = new unordered_map<int,int>(); for(int i = 0; i < n; i++) (*G)[i] = values[i]; sink += G->size(); delete G; });
+    report("GRAPH", "insert", sdds, direct, "unordered_map", base);
+
+    SDDS<int>::create(&S, GRAPH);
+    D = new DSG<int>(); D->create();
+    B = new unordered_map<int,int>();
+    for(int i = 0; i < n; i++){ SDDS<int>::insert(S, i, values[i]); D->insert(i, values[i]); (*B)[i] = values[i]; }
+
+    sdds = measure(nqueries, [S](){ int v; for(int q = 0; q < nqueries; q++){ SDDS<int>::extract(S, positions[q], &v); sink += v; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extract(positions[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += B->at(positions[q]); });
+    report("GRAPH", "extract", sdds, direct, "unordered_map", base);
+
+    //La búsqueda y el conteo son por dato, no por ID, por lo que recorren todos los nodos
+    sdds = measure(nqueries, [S](){ bool r; for(int q = 0; q < nqueries; q++){ SDDS<int>::search(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->search(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++){ bool r = false; for(auto& kv : *B) if(kv.second == queries[q]){ r = true; break; } sink += r; } });
+    report("GRAPH", "search", sdds, direct, "unordered_map", base);
+
+    sdds = measure(nqueries, [S](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::count(S, queries[q], &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->count(queries[q]); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++){ int r = 0; for(auto& kv : *B) r += (kv.second == queries[q]); sink += r; } });
+    report("GRAPH", "count", sdds, direct, "unordered_map", base);
+
+    measured = S;
+    sdds = measure(nqueries, [](){ int r = 0; for(int q = 0; q < nqueries; q++){ SDDS<int>::extension(measured, &r); sink += r; } });
+    direct = measure(nqueries, [D](){ for(int q = 0; q < nqueries; q++) sink += D->extension(); });
+    base = measure(nqueries, [B](){ for(int q = 0; q < nqueries; q++) sink += B->size(); });
+    report("GRAPH", "extension", sdds, direct, "unordered_map", base);
+
+    sdds = measure(n, [S](){ DS<int>* C; SDDS<int>::create_copy(S, &C); SDDS<int>::destroy(C); delete C; });
+    base = measure(n, [B](){ unordered_map<int,int>* C = new unordered_map<int,int>(*B); sink += C->size(); delete C; });
+    report("GRAPH", "create_copy", sdds, -1, "unordered_map", base);
+
+    SDDS<int>::destroy(S); delete S;
+    D->destroy(); delete D;
+    delete B;
+
+    //Cada nodo i se conecta con los nodos i-2, i-1, i+1 e i+2 de un anillo.
+    //Los listados de identificadores se construyen antes de medir
+    DS<int>** C = (DS<int>**) malloc(sizeof(DS<int>*)*n);
+    for(int i = 0; i < n; i++){
+        SDDS<int>::create(&C[i], SINGLE_LINKED_LIST);
+        for(int d = -2; d <= 2; d++)
+            if(d != 0) SDDS<int>::push_back(C[i], ((i + d) % n + n) % n);
+    }
+
+    sdds = measure(n, [C](){
+        DS<int>* G; SDDS<int>::create(&G, GRAPH);
+        for(int i = 0; i < n; i++) SDDS<int>::insert(G, i, values[i]);
+        for(int i = 0; i < n; i++) SDDS<int>::define_connections(G, i, C[i]);
+        ((DSG<int>*) G)->build_adjacency(); sink += ((DSG<int>*) G)->edges();
+        SDDS<int>::destroy(G); delete G;
+    });
+    base = measure(n, [C](){
+        unordered_map<int, vector<int>>* G = new unordered_map<int, vector<int>>();
+        for(int i = 0; i < n; i++){
+            vector<int>& L = (*G)[i];
+            for(NodeSL<int>* c = (NodeSL<int>*) ((DSSL<int>*) C[i])->getRoot(); c != NULL; c = c->next) L.push_back(c->data);
+        }
+        sink += G->size(); delete G;
+    });
+    report("GRAPH", "connect", sdds, -1, "unordered_map", base);
+
+    //Para los algoritmos sobre el grafo, se construye el grafo del anillo una
+    //sola vez, y su equivalente como vector de vectores de índices
+    SDDS<int>::create(&S, GRAPH);
+    for(int i = 0; i < n; i++) SDDS<int>::insert(S, i, values[i]);
+    for(int i = 0; i < n; i++) SDDS<int>::define_connections(S, i, C[i]);
+    D = (DSG<int>*) S;
+    D->build_adjacency();
+
+    //La copia del grafo debe recorrerse igual que el original
+    check_graph_copy(S);
+
+    vector<vector<int>>* R = new vector<vector<int>>(n);
+    for(int i = 0; i < n; i++)
+        for(NodeSL<NodeG<int>*>* c = D->vertex(i)->connections; c != NULL; c = c->next) (*R)[i].push_back(c->data->index);
+
+    int* order = (int*) malloc(sizeof(int)*n);
+    int* level = (int*) malloc(sizeof(int)*n);
+    double* dist = (double*) malloc(sizeof(double)*n);
+    auto weight = [](NodeG<int>* a, NodeG<int>* b){ return (double) abs(a->data - b->data); };
+
+    //Los algoritmos de DSG deben coincidir con las implementaciones de referencia
+    check_graph_algorithms(S, D, R, weight);
+
+    sdds = measure(n, [S](){ DS<int>* O; SDDS<int>::bfs(S, 0, &O); int r = 0; SDDS<int>::extension(O, &r); sink += r; SDDS<int>::destroy(O); delete O; });
+    direct = measure(n, [D, order, level](){ sink += D->bfs(0, order, level); });
+    base = measure(n, [R, level](){ reference_bfs(R, level); sink += level[n-1]; });
+    report("GRAPH", "bfs", sdds, direct, "vector", base);
+
+    sdds = measure(n, [S](){ DS<int>* O; SDDS<int>::dfs(S, 0, &O); int r = 0; SDDS<int>::extension(O, &r); sink += r; SDDS<int>::destroy(O); delete O; });
+    direct = measure(n, [D, order](){ sink += D->dfs(0, order); });
+    base = measure(n, [R](){ sink += reference_dfs(R); });
+    report("GRAPH", "dfs", sdds, direct, "vector", base);
+
+    sdds = measure(n, [S](){ int r = 0; SDDS<int>::connected_components(S, &r); sink += r; });
+    direct = measure(n, [D, level](){ sink += D->components(level); });
+    base = measure(n, [R, level](){ sink += reference_components(R, level); });
+    report("GRAPH", "components", sdds, direct, "vector", base);
+
+    sdds = measure(n, [S, weight](){ double L; DS<int>* P; SDDS<int>::shortest_path(S, 0, n/2, weight, &L, &P); sink += L; SDDS<int>::destroy(P); delete P; });
+    direct = measure(n, [D, dist, level, weight](){ D->dijkstra(0, weight, dist, level); sink += dist[n-1]; });
+    base = measure(n, [R, D, dist, weight](){ reference_dijkstra(R, D, weight, dist); sink += dist[n-1]; });
+    report("GRAPH", "dijkstra", sdds, direct, "priority_queue", base);
+
+    free(order); free(level); free(dist);
+    delete R;
+    SDDS<int>::destroy(S); delete S;
+
+    for(int i = 0; i < n; i++){ SDDS<int>::destroy(C[i]); delete C[i]; }
+    free(C);
+}
+
+/*
+    Procedimiento principal del programa de medición.
+
+    Para cada tamaño solicitado se generan los datos y las consultas, y se
+    miden todas las categorías de estructuras de datos.
+*/
+int main(int argc, char** argv){
+    BenchOptions opts = parse_options(argc, argv);
+    repeat = opts.repeat;
+
+    if(opts.csv != NULL){
+        csvFile.open(opts.csv);
+        csvFile << "n,category,operation,sdds_ns,direct_ns,baseline,baseline_ns\n";
+    }
+
+    for(int s = 0; s < opts.nsizes; s++){
+        n = max(1L, opts.sizes[s]);
+        nqueries = opts.queries;
+        mt19937 rng(opts.seed);
+
+        values = (int*) malloc(sizeof(int)*n);
+        positions = (int*) malloc(sizeof(int)*nqueries);
+        queries = (int*) malloc(sizeof(int)*nqueries);
+        for(int i = 0; i < n; i++) values[i] = i;
+        shuffle(values, values+n, rng);
+        for(int q = 0; q < nqueries; q++){
+            positions[q] = uniform_int_distribution<int>(0, n-1)(rng);
+            queries[q] = uniform_int_distribution<int>(0, 2*n-1)(rng);
+        }
+
+        cout << "\nn = " << n << " (nanoseconds per operation)\n";
+        cout << "\t" << left << setw(20) << "category" << setw(13) << "operation" << right
+             << setw(12) << "sdds" << setw(12) << "direct" << setw(12) << "baseline" << setw(10) << "ratio" << "   baseline\n";
+
+        bench_array();
+        bench_matrix();
+        bench_list< DSSL<int>, forward_list<int> >(SINGLE_LINKED_LIST, "SINGLE_LINKED_LIST", "forward_list");
+        bench_list< DSDL<int>, list<int> >(DOUBLE_LINKED_LIST, "DOUBLE_LINKED_LIST", "list");
+        bench_tree();
+        bench_graph();
+        bench_pool< DSSL<int>, DSSL<int, PoolAllocator> >("SINGLE_LINKED_LIST", [](auto* S){ for(int i = 0; i < n; i++) S->push_back(values[i]); });
+        bench_pool< DSDL<int>, DSDL<int, PoolAllocator> >("DOUBLE_LINKED_LIST", [](auto* S){ for(int i = 0; i < n; i++) S->push_back(values[i]); });
+        bench_pool< DST<int>, DST<int, PoolAllocator> >("BINARY_SEARCH_TREE", [](auto* S){ for(int i = 0; i < n; i++) S->insert(values[i]); });
+        bench_pool< DSG<int>, DSG<int, PoolAllocator> >("GRAPH", [](auto* S){ for(int i = 0; i < n; i++) S->insert(i, values[i]); });
+        cout.flush();
+
+        free(values); free(positions); free(queries);
+    }
+
+    if(csvFile.is_open()) csvFile.close();
+
+    //Se muestra el acumulador para que las operaciones medidas no se eliminen
+    cout << "\nchecksum: " << sink << "\n";
+
+    return 0;
+}
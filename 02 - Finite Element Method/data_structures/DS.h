@@ -15,6 +15,14 @@
 template <typename T>
 class DS{
     public:
+        /*
+            Destructor virtual, para que un objeto pueda liberarse con
+            delete a través de un puntero a DS, sin conocer su clase
+            concreta. La memoria de la estructura de datos como tal se
+            libera con destroy().
+        */
+        virtual ~DS(){}
+
         /*
             Función que retorna la categoría de la estructura
             de datos local.
@@ -188,6 +196,20 @@ class insertable{
         virtual void insert(T value) = 0;
 };
 
+/*
+    Interfaz para estructuras de datos que permiten añadir datos
+    al final de su contenido.
+*/
+template <typename T>
+class appendable{
+    public:
+        /*
+            Función para añadir un valor <value> de tipo <T>
+            al final de la estructura de datos local de tipo <T>.
+        */
+        virtual void push_back(T value) = 0;
+};
+
 /*
     Interfaz para estructuras de datos que permiten la definición
     de una extensión mediante el cálculo de un número entero.
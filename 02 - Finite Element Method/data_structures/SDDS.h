@@ -84,7 +84,8 @@ struct NodeDL: Node<type>{
 
     La estructura extienda a la estructura Node, añadieno un
     puntero al nodo padre en el árbol, un puntero al hijo izquierdo
-    en el árbol, y un puntero al hijo derecho en el árbol.
+    en el árbol, un puntero al hijo derecho en el árbol, y la altura
+    y cantidad de nodos del sub-árbol que tiene al nodo como raíz.
 
     Dado que Node es un template, y que acá aún no se ha determinado
     el tipo de dato a utilizar, NodeT se define también como
@@ -96,6 +97,8 @@ struct NodeT: Node<type>{
     NodeT<type>* parent;
     NodeT<type>* left;
     NodeT<type>* right;
+    int height;
+    int size;
 };
 
 /*
@@ -107,7 +110,10 @@ struct NodeT: Node<type>{
     un entero para almacenar el identificador del grafo, un puntero
     a una lista enlazada simple de punteros a nodo de grafo, la cual
     representa las conexiones del nodo en el grafo, y un puntero al
-    nodo siguiente en el grafo.
+    nodo siguiente en el grafo. Se añade también el índice del nodo,
+    su posición en el orden de inserción, que el grafo utiliza para
+    acceder a él en tiempo constante y para su representación compacta
+    de conexiones.
 
     Dado que Node es un template, y que acá aún no se ha determinado
     el tipo de dato a utilizar, NodeG se define también como
@@ -118,13 +124,19 @@ template <typename type>
 struct NodeG: Node<type>{
     bool entry;
     int id;
+    int index;
     NodeSL<NodeG<type>*>* connections;
     NodeG<type>* next;
 };
 
+//Las estructuras de datos registran sus reservas de memoria en la clase Perf
+#include "../utilities/perf_utilities.h"
+
 #include "DS.h"
 #include "static/DSA.h"
 #include "static/DSM.h"
+#include "static/DSMV.h"
+#include "dynamic/allocators.h"
 #include "dynamic/DSSL.h"
 #include "dynamic/DSDL.h"
 #include "dynamic/DST.h"
@@ -160,8 +172,12 @@ class SDDS{
             Como atributo privado local se maneja una variable auxiliar
             de tipo "struct Data", para poder facilitar los procesos
             de manejo de las estructuras de datos estáticas.
+
+            Cada hilo de ejecución tiene su propia copia (thread_local),
+            de modo que varios hilos pueden manipular sus propias
+            estructuras al mismo tiempo sin interferir entre sí.
         */
-        static Data ref;
+        static thread_local Data ref;
 
         /*========== Funciones para manejo de interfaces ===========*/
 
@@ -174,6 +190,15 @@ class SDDS{
             var->insert(value);
         }
 
+        /*
+            Función que recibe un objeto appendable de tipo <type>
+            para ejecutar su método push_back(), enviando el <value>
+            proporcionado.
+        */
+        static void push_back_aux(appendable<type>* var, type value){
+            var->push_back(value);
+        }
+
         /*
             Función que recibe un objeto positionable de tipo <type>
             para ejecutar su método insert(), enviando la posición
@@ -221,19 +246,9 @@ class SDDS{
             árbol se copiará el contenido del árbol original.
         */
         static void copy_tree(NodeT<type>* O, DST<type>** clone){
-            //Si el árbol original está vacío, no hay nada que copiar
-            if(O == NULL) return;
-
-            //El dato en el nodo actual del árbol original se inserta en el
-            //árbol del objeto DS
-            (*clone)->insert(O->data);
-
-            //Se procede a copiar el contenido del sub-árbol izquierdo del
-            //nodo actual del árbol original
-            copy_tree(O->left, clone);
-            //Se procede a copiar el contenido del sub-árbol derecho del
-            //nodo actual del árbol original
-            copy_tree(O->right, clone);
+            //Se copia el árbol original nodo por nodo, conservando su forma,
+            //mediante el método copy() del árbol del objeto DS
+            (*clone)->copy(O);
         }
 
         /*========= Funciones para manejo de grafos ===============*/
@@ -251,33 +266,9 @@ class SDDS{
             donde se almacenará la dirección extraída.
         */
         static void extractNode(DS<type>* G, int id, NodeG<type>** node){
-            /*
-                Se copia la referencia al primer nodo del listado de
-                nodos del grafo del objeto DS para no perderla
-                durante el recorrido.
-                
-                Para obtener la dirección del primer nodo del listado de
-                nodos del grafo del objeto DS invocamos el método
-                getRoot().
-                
-                Como getRoot() retorna la dirección de un Nodo genérico
-                para estructuras de datos dinámicas, hacemos casting a la
-                dirección de un Nodo de una grafo de datos tipo <type>.
-            */
-            NodeG<type>* graph = (NodeG<type>*) ( (DSG<type>*) G )->getRoot();
-
-            //Se recorre el listado de nodos del grafo hasta el final
-            while(graph != NULL){
-                //Terminamos el proceso cuando nos encontremos en el nodo
-                //cuyo identificador es igual al proporcionado
-                if(graph->id == id) break;
-
-                //Se avanza al siguiente nodo del grafo
-                graph = graph->next;
-            }
-
-            //Se almacena la dirección del nodo solicitado en <node>
-            *node = graph;
+            //El grafo obtiene la dirección del nodo a partir de su tabla de
+            //identificadores, sin recorrer el listado de nodos
+            *node = ( (DSG<type>*) G )->find(id);
         }
 
         /*
@@ -294,36 +285,30 @@ class SDDS{
             dado.
         */
         static void insert_connections(DS<type>* G, int id, NodeSL<NodeG<type>*>* C){
-            /*
-                Se copia la referencia al primer nodo del listado de
-                nodos del grafo del objeto DS para no perderla
-                durante el recorrido.
-                
-                Para obtener la dirección del primer nodo del listado de
-                nodos del grafo del objeto DS invocamos el método
-                getRoot().
-                
-                Como getRoot() retorna la dirección de un Nodo genérico
-                para estructuras de datos dinámicas, hacemos casting a la
-                dirección de un Nodo de una grafo de datos tipo <type>.
-            */
-            NodeG<type>* graph = (NodeG<type>*) ( (DSG<type>*) G )->getRoot();
-
-            //Se recorre el listado de nodos del grafo hasta el final
-            while(graph != NULL){
-                //Verificamos si nos encontramos en el nodo indicado por
-                //el identificador dado
-                if(graph->id == id){
-                    //Se coloca como conexiones del nodo indicado la lista
-                    //proporcionada
-                    graph->connections = C;
-                    //No es necesario continuar con el recorrido
-                    break;
-                }
+            //El grafo localiza el nodo a partir de su tabla de identificadores
+            //y coloca la lista proporcionada como sus conexiones
+            ( (DSG<type>*) G )->set_connections(id, C);
+        }
 
-                //Se avanza al siguiente nodo del grafo
-                graph = graph->next;
-            }
+        /*
+            Función auxiliar para los recorridos bfs() y dfs(), que realiza
+            el recorrido en anchura si <breadth> es true, o en profundidad
+            en caso contrario.
+        */
+        static void traverse(DS<type>* G, int id, DS<int>** order, bool breadth){
+            DSG<type>* graph = (DSG<type>*) G;
+
+            //El grafo coloca los índices de los nodos visitados
+            int* visited = (int*) malloc(sizeof(int)*graph->extension());
+            int cont = breadth ? graph->bfs(graph->index(id), visited, NULL)
+                               : graph->dfs(graph->index(id), visited);
+
+            //Se convierten los índices en identificadores
+            SDDS<int>::create(order, cont, ARRAY);
+            for(int i = 0; i < cont; i++)
+                SDDS<int>::insert(*order, i, graph->id(visited[i]));
+
+            free(visited);
         }
 
     /*Se definen los métodos para cada una de las operaciones que el
@@ -366,6 +351,30 @@ class SDDS{
             *res = var->count(value);
         }
 
+        /*
+            Funciones para consultas ordenadas sobre un objeto DS de tipo <type>
+            que contiene un árbol binario de búsqueda:
+                - lower_bound() almacena en <res> el menor dato mayor o igual a
+                  <value>, y en <found> si dicho dato existe.
+                - upper_bound() almacena en <res> el menor dato estrictamente
+                  mayor a <value>, y en <found> si dicho dato existe.
+                - count_range() almacena en <res> la cantidad de datos en el
+                  rango [<low>, <high>].
+
+            Se asume pre-validación de que <var> es un árbol binario de búsqueda.
+        */
+        static void lower_bound(DS<type>* var, type value, type* res, bool* found){
+            *found = ((DST<type>*) var)->lower_bound(value, res);
+        }
+
+        static void upper_bound(DS<type>* var, type value, type* res, bool* found){
+            *found = ((DST<type>*) var)->upper_bound(value, res);
+        }
+
+        static void count_range(DS<type>* var, type low, type high, int* res){
+            *res = ((DST<type>*) var)->count_range(low, high);
+        }
+
         /*
             Función que muestra el contenido de una estructura de datos
             de un objeto DS de tipo <type>.
@@ -429,6 +438,35 @@ class SDDS{
             *var = matrix;
         }
 
+        /*
+            Función que instancia un puntero a objeto DS de tipo <type>
+            enviado por referencia creando un objeto DSMV, es decir, una
+            vista sobre la matriz <base>, sin copiar sus datos.
+
+            Se reciben <nrows> y <rows> como el número de filas de la vista
+            y los índices, en <base>, de dichas filas, y <ncols> y <cols>
+            como el número de columnas de la vista y sus índices en <base>.
+            Los índices se copian en la vista.
+
+            Si <owner> es true, la vista se vuelve propietaria de <base>, de
+            modo que al liberar la vista con destroy() se libera también la
+            matriz base. En caso contrario, la matriz base debe mantenerse
+            mientras se utilice la vista, y liberarse por separado.
+
+            Dado que DSMV extiende a DSM, la vista se manipula con las mismas
+            funciones extension(), insert() y extract() que una matriz.
+        */
+        static void create_view(DS<type>** var, DS<type>* base, int nrows, int* rows, int ncols, int* cols, bool owner){
+            DSMV<type>* view = new DSMV<type>();
+
+            ref.n = nrows;
+            ref.m = ncols;
+            view->create(ref);
+            view->observe(base, rows, cols, owner);
+
+            *var = view;
+        }
+
         /*
             Función que instancia un puntero a objeto DS de tipo
             <type> enviado por referencia creando un objeto dependiendo
@@ -475,6 +513,26 @@ class SDDS{
             }
         }
 
+        /*
+            Función que instancia un puntero a objeto DS de tipo <type>
+            enviado por referencia, al igual que la función anterior, pero
+            indicando con <balanced> si el árbol a crear debe mantenerse
+            balanceado.
+
+            <balanced> solo aplica si <cat> es BINARY_SEARCH_TREE; para las
+            demás categorías se ignora.
+        */
+        static void create(DS<type>** var, category cat, bool balanced){
+            if(cat != BINARY_SEARCH_TREE){
+                create(var, cat);
+                return;
+            }
+
+            DST<type>* T = new DST<type>();
+            T->create(balanced);
+            *var = T;
+        }
+
         /*==== Funciones para medición de estructuras de datos ====*/
 
         /*
@@ -605,6 +663,39 @@ class SDDS{
             }
         }
 
+        /*
+            Función para añadir un valor <value> de tipo <type>
+            al final de la estructura de datos de un objeto DS de
+            tipo <type>.
+
+            Solo las listas enlazadas permiten esta operación.
+        */
+        static void push_back(DS<type>* var, type value){
+            //Se invoca getCategory() para determinar el tipo de
+            //estructura de datos con la que se cuenta
+            category cat = var->getCategory();
+
+            switch(cat){
+                /*
+                    En cada caso:
+                        - Se hace casting de <var> al objeto
+                          correspondiente a la estructura de datos
+                          en cuestión.
+                        - Se envía el objeto casteado junto con <value>
+                          a push_back_aux().
+                */
+
+                case SINGLE_LINKED_LIST: {
+                    push_back_aux( ((DSSL<type>*) var), value);
+                    break;
+                }
+                case DOUBLE_LINKED_LIST: {
+                    push_back_aux( ((DSDL<type>*) var), value);
+                    break;
+                }
+            }
+        }
+
         /*
             Función para insertar un valor <value> de tipo <type>
             en la posición indicada por <n> de la estructura de datos
@@ -764,25 +855,30 @@ class SDDS{
             //dato de tipo <type>
             NodeG<type>* temp;
 
+            //Se inicializa la lista enlazada simple auxiliar
+            graph_nodes->create();
+
             //Se adapta el listado de conexiones, dado como objeto genérico DS,
-            //a un objeto DSSL, un objeto para listas enlazadas simples.
-            DSSL<int>* L = (DSSL<int>*) C;
+            //a un objeto DSSL, un objeto para listas enlazadas simples, y se
+            //obtiene su primer nodo para recorrerla sin indexar por posición
+            NodeSL<int>* L = (NodeSL<int>*) ((DSSL<int>*) C)->getRoot();
 
-            //Se recorre la lista de indicadores de nodos conectados
-            //Se usa como límite la longitud de la lista <L>, la cual se obtiene
-            //invocando su método extension()
-            for(int i= 0; i < L->extension(); i++){
+            //Se recorre la lista de indicadores de nodos conectados hasta el final
+            while(L != NULL){
                 /*Se envía a la función para extracción de un nodo en un grafo:
                     - El grafo.
                     - El id del nodo cuya dirección necesitamos, indicado por el
-                      entero en la posición actual de la lista de identificadores.
+                      entero en el nodo actual de la lista de identificadores.
                     - La variable auxiliar temp, **por referencia**, para almacenar
                       la dirección obtenida.                                       */
-                extractNode(G,L->extract(i),&temp);
+                extractNode(G,L->data,&temp);
 
                 //Insertamos la dirección obtenida en el lista enlazada simple de
                 //punteros a Nodos de Grafo de datos de tipo <type>
                 graph_nodes->insert(temp);
+
+                //Se avanza al siguiente nodo de la lista
+                L = L->next;
             }
 
             /*Se envía a la función para inserción de conexiones:
@@ -805,6 +901,83 @@ class SDDS{
             delete graph_nodes;
         }
 
+        /*
+            Funciones de recorrido de un objeto DS que contiene un grafo de datos
+            tipo <type>, a partir del nodo con identificador <id>:
+                - bfs() realiza un recorrido en anchura.
+                - dfs() realiza un recorrido en profundidad.
+
+            Ambas instancian en <order>, enviado por referencia, un arreglo con
+            los identificadores de los nodos alcanzables desde <id>, en el orden
+            en que se visitan.
+
+            Los recorridos siguen los listados de conexiones definidos con
+            define_connections().
+        */
+        static void bfs(DS<type>* G, int id, DS<int>** order){
+            traverse(G, id, order, true);
+        }
+
+        static void dfs(DS<type>* G, int id, DS<int>** order){
+            traverse(G, id, order, false);
+        }
+
+        /*
+            Función que almacena en <n> la cantidad de componentes conexas de un
+            objeto DS que contiene un grafo de datos tipo <type>. Una malla
+            correctamente definida tiene una sola componente.
+
+            Se asume que las conexiones son simétricas.
+        */
+        static void connected_components(DS<type>* G, int* n){
+            DSG<type>* graph = (DSG<type>*) G;
+
+            int* component = (int*) malloc(sizeof(int)*max(graph->extension(), 1));
+            *n = graph->components(component);
+            free(component);
+        }
+
+        /*
+            Función que obtiene el camino más corto entre los nodos con
+            identificadores <from> y <to> de un objeto DS que contiene un grafo
+            de datos tipo <type>.
+
+            Se recibe <weight> como una función que, dados dos nodos conectados,
+            retorna el peso no negativo de su conexión.
+
+            Se almacena en <length> la longitud del camino, y se instancia en
+            <path>, enviado por referencia, un arreglo con los identificadores
+            de los nodos del camino desde <from> hasta <to>. Si <to> no es
+            alcanzable, <length> es -1 y <path> queda en NULL.
+        */
+        template <typename Weight>
+        static void shortest_path(DS<type>* G, int from, int to, Weight weight, double* length, DS<int>** path){
+            DSG<type>* graph = (DSG<type>*) G;
+            int n = graph->extension();
+
+            double* dist = (double*) malloc(sizeof(double)*n);
+            int* previous = (int*) malloc(sizeof(int)*n);
+            graph->dijkstra(graph->index(from), weight, dist, previous);
+
+            int target = graph->index(to);
+            *length = dist[target];
+            *path = NULL;
+
+            if(dist[target] >= 0){
+                //Se cuenta la cantidad de nodos del camino, y luego se colocan
+                //sus identificadores recorriéndolo desde el final
+                int cont = 0;
+                for(int v = target; v != -1; v = previous[v]) cont++;
+
+                SDDS<int>::create(path, cont, ARRAY);
+                for(int v = target; v != -1; v = previous[v])
+                    SDDS<int>::insert(*path, --cont, graph->id(v));
+            }
+
+            free(dist);
+            free(previous);
+        }
+
         /*
             Función que recibe un objeto DS de tipo <type> por valor, y
             un segundo objeto DS, también de tipo <type>, por referencia, para copiar
@@ -903,19 +1076,15 @@ class SDDS{
 
                     //Recorremos la lista del objeto original hasta el final
                     while(SL != NULL){
-                        //Se invoca a insert_aux() enviando el objeto copia
-                        //casteado a DSSL, junto con el dato actual en la lista
-                        insert_aux( ((DSSL<type>*) *clone), SL->data);
+                        //Se invoca a push_back_aux() enviando el objeto copia
+                        //casteado a DSSL, junto con el dato actual en la lista,
+                        //de modo que los datos quedan en el mismo orden que en
+                        //el objeto original
+                        push_back_aux( ((DSSL<type>*) *clone), SL->data);
 
                         //Se avanza al siguiente nodo de la lista
                         SL = SL->next;
                     }
-
-                    //Dado que los datos se insertan al inicia de la lista, los
-                    //datos del objeto original han quedado en orden inverso, por
-                    //lo que invocamos el método reverse() del objeto copia
-                    //haciéndole casting a DSSL
-                    reverse_aux( ((DSSL<type>*) *clone) );
                     break;
                 }
 
@@ -945,19 +1114,15 @@ class SDDS{
                     
                     //Recorremos la lista del objeto original hasta el final
                     while(DL != NULL){
-                        //Se invoca a insert_aux() enviando el objeto copia
-                        //casteado a DSDL, junto con el dato actual en la lista
-                        insert_aux( ((DSDL<type>*) *clone), DL->data);
+                        //Se invoca a push_back_aux() enviando el objeto copia
+                        //casteado a DSDL, junto con el dato actual en la lista,
+                        //de modo que los datos quedan en el mismo orden que en
+                        //el objeto original
+                        push_back_aux( ((DSDL<type>*) *clone), DL->data);
 
                         //Se avanza al siguiente nodo de la lista
                         DL = DL->next;
                     }
-
-                    //Dado que los datos se insertan al inicia de la lista, los
-                    //datos del objeto original han quedado en orden inverso, por
-                    //lo que invocamos el método reverse() del objeto copia
-                    //haciéndole casting a DSDL
-                    reverse_aux( ((DSDL<type>*) *clone) );
                     break;
                 }
 
@@ -967,8 +1132,9 @@ class SDDS{
                     *clone = new DST<type>();
 
                     //Se invoca el método create() de la copia, haciéndole
-                    //casting a DST
-                    ((DST<type>*) *clone)->create();
+                    //casting a DST, conservando el modo balanceado del
+                    //árbol original
+                    ((DST<type>*) *clone)->create( ((DST<type>*) original)->is_balanced() );
 
                     /*
                       Se copia la referencia a la raíz del árbol del
@@ -1022,6 +1188,14 @@ class SDDS{
                         //del nodo actual del grafo
                         insert_pos_aux( ((DSG<type>*) *clone), G->id, G->data);
 
+                        //Se avanza al siguiente nodo del grafo
+                        G = G->next;
+                    }
+
+                    //Una vez insertados todos los nodos en la copia, se recorre de nuevo
+                    //el grafo original para copiar las conexiones de cada nodo
+                    G = (NodeG<type>*) ((DSG<type>*) original)->getRoot();
+                    while(G != NULL){
                         /*
                             Se copia la referencia al primer nodo de la lista de
                             conexiones del nodo actual del grafo del objeto original
@@ -1047,20 +1221,18 @@ class SDDS{
                         //Recorremos las conexiones del nodo actual del grafo del objeto
                         //original hasta el final
                         while(O != NULL){
-                            //La conexión actual se almacena en la lista de la variable
-                            //auxiliar
-                            L->insert(O->data);
+                            //La conexión actual se añade al final de la lista de la
+                            //variable auxiliar, conservando el orden original.
+                            //La conexión debe apuntar al nodo de la copia con el mismo
+                            //identificador, y no al nodo del grafo original, ya que las
+                            //conexiones en formato CSR usan la posición del nodo en su
+                            //propio grafo
+                            L->push_back( ((DSG<type>*) *clone)->find(O->data->id) );
 
                             //Se avanza a la conexión siguiente
                             O = O->next;
                         }
 
-                        //Dado que los datos se insertan al inicia de la lista, las
-                        //conexiones del nodo actual del grafo del objeto original han
-                        //quedado en orden inverso, por lo que invocamos el método
-                        //reverse() de la variable auxiliar
-                        L->reverse();
-
                         /*Enviamos a la función para inserción de conexiones:
                             - El objeto copia.
                             - El identificador del nodo actual, para que se sepa a qué
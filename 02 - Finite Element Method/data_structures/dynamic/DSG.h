@@ -3,8 +3,35 @@
 
     Se define la implementación como independiente del tipo de dato
     a almacenar mediante el uso de template.
+
+    El segundo "meta-parámetro", <Allocator>, indica el asignador de memoria
+    para los nodos (ver "allocators.h"). Por defecto se utiliza
+    MallocAllocator, que reserva cada nodo por separado; con PoolAllocator los
+    nodos se reservan en bloques contiguos y se liberan todos juntos.
+
+    Además del listado enlazado de nodos, el grafo mantiene:
+        - Una tabla indexada por identificador, que contiene la posición de
+          cada nodo en el orden de inserción (su "índice"), y un arreglo con
+          la dirección de cada nodo según su índice. Con ellos se obtiene en
+          tiempo constante el nodo correspondiente a un identificador, en
+          lugar de recorrer todo el listado. Se asume que los identificadores
+          son enteros no negativos.
+        - Una representación compacta de las conexiones (formato CSR), que se
+          construye a demanda con build_adjacency(): las conexiones del nodo
+          con índice i son los índices adjacency_targets()[k] para k desde
+          adjacency_offsets()[i] hasta adjacency_offsets()[i+1]-1, almacenados
+          en un único arreglo contiguo. Es la representación a utilizar para
+          recorrer el grafo completo.
+
+    Sobre la representación CSR se ofrecen los algoritmos de recorrido y
+    análisis del grafo: recorrido en anchura (bfs), recorrido en profundidad
+    (dfs), componentes conexas (components), caminos más cortos (dijkstra) y
+    reordenamiento de nodos para reducir el ancho de banda
+    (reverse_cuthill_mckee).
+    Todos ellos trabajan con índices de nodos, y construyen la representación
+    CSR si no está al día.
 */
-template <typename T>
+template <typename T, class Allocator = MallocAllocator>
 /*
     En C++, la implementación se maneja como una herencia,
     de modo que DSG hereda de:
@@ -34,6 +61,169 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
         */
         NodeG<T>* G;
 
+        //Asignador de memoria propio de la estructura para sus nodos
+        Allocator alloc;
+
+        //Tabla de identificador a índice, con -1 para los identificadores
+        //no utilizados, y su capacidad. Cubre únicamente los identificadores
+        //menores a <ids>, acotada por la cantidad de nodos (ver register_node())
+        int* index_of;
+        int ids;
+
+        //Tabla hash de identificador a índice para los identificadores que
+        //no cubre la tabla anterior, con direccionamiento abierto: -1 en
+        //<hash_ids> indica una posición libre. Su capacidad es potencia de 2
+        int* hash_ids;
+        int* hash_index;
+        int hash_count;
+        int hash_capacity;
+
+        //Dirección de cada nodo según su índice, cantidad de nodos y capacidad
+        NodeG<T>** vertices;
+        int nvertices;
+        int capacity;
+
+        //Conexiones en formato CSR, y si están al día con los listados de
+        //conexiones de los nodos
+        int* offsets;
+        int* targets;
+        int nedges;
+        bool adjacency_ready;
+
+        /*
+            Función que retorna la posición de la tabla hash en la que se
+            encuentra el identificador <id>, o la posición libre en la que
+            debería colocarse. La tabla debe tener al menos una posición libre.
+        */
+        int hash_slot(int id){
+            int mask = hash_capacity - 1;
+            int slot = (int) (((unsigned int) id * 2654435761u) & mask);
+            while(hash_ids[slot] != -1 && hash_ids[slot] != id) slot = (slot + 1) & mask;
+            return slot;
+        }
+
+        /*
+            Función que coloca en la tabla hash el índice <index> del
+            identificador <id>, duplicando su capacidad cuando está a la mitad.
+        */
+        void hash_store(int id, int index){
+            if(2*(hash_count + 1) > hash_capacity){
+                int old = hash_capacity;
+                int* old_ids = hash_ids;
+                int* old_index = hash_index;
+                hash_capacity = (old == 0) ? 16 : 2*old;
+                Perf::count_allocation(2*sizeof(int)*hash_capacity, 2);
+                hash_ids = (int*) malloc(sizeof(int)*hash_capacity);
+                hash_index = (int*) malloc(sizeof(int)*hash_capacity);
+                for(int i = 0; i < hash_capacity; i++) hash_ids[i] = -1;
+                for(int i = 0; i < old; i++)
+                    if(old_ids[i] != -1){
+                        int slot = hash_slot(old_ids[i]);
+                        hash_ids[slot] = old_ids[i];
+                        hash_index[slot] = old_index[i];
+                    }
+                free(old_ids);
+                free(old_index);
+            }
+
+            int slot = hash_slot(id);
+            if(hash_ids[slot] == -1) hash_count++;
+            hash_ids[slot] = id;
+            hash_index[slot] = index;
+        }
+
+        /*
+            Función que retorna el índice del nodo con identificador <id>, o -1
+            si no existe, consultando la tabla que cubre dicho identificador.
+        */
+        int lookup(int id){
+            if(id < 0) return -1;
+            if(id < ids) return index_of[id];
+            if(hash_count == 0) return -1;
+            int slot = hash_slot(id);
+            return (hash_ids[slot] == -1) ? -1 : hash_index[slot];
+        }
+
+        /*
+            Función que registra el nodo <node> en las tablas de acceso por
+            identificador y por índice, ampliándolas al doble de su capacidad
+            cuando es necesario.
+
+            La tabla de identificadores directa solo se amplía para cubrir
+            identificadores menores a 4 veces la cantidad de nodos (o a 1024), y
+            a lo sumo al doble de ese límite, de modo que un grafo con pocos nodos
+            e identificadores muy grandes no reserve una tabla del tamaño de su
+            mayor identificador. Los identificadores fuera de ella se
+            colocan en la tabla hash, y pasan a la tabla directa cuando esta se
+            amplía lo suficiente para cubrirlos.
+        */
+        void register_node(NodeG<T>* node){
+            if(node->id < 0){
+                cerr << "Los identificadores de los nodos de un grafo deben ser no negativos.\n";
+                exit(EXIT_FAILURE);
+            }
+
+            if(nvertices == capacity){
+                capacity = (capacity == 0) ? 16 : 2*capacity;
+                Perf::count_allocation(sizeof(NodeG<T>*)*capacity);
+                vertices = (NodeG<T>**) realloc(vertices, sizeof(NodeG<T>*)*capacity);
+            }
+
+            long bound = max(1024L, 4L*(nvertices + 1));
+            if(node->id >= ids && node->id < bound){
+                int old = ids;
+                ids = (int) max((long) node->id + 1, min(2L*ids, 2*bound));
+                Perf::count_allocation(sizeof(int)*ids);
+                index_of = (int*) realloc(index_of, sizeof(int)*ids);
+                for(int i = old; i < ids; i++) index_of[i] = -1;
+
+                //Los identificadores de la tabla hash que ahora cubre la tabla
+                //directa se trasladan a ella
+                if(hash_count > 0){
+                    int* old_ids = hash_ids;
+                    int* old_index = hash_index;
+                    int old_capacity = hash_capacity;
+                    hash_ids = hash_index = NULL;
+                    hash_count = hash_capacity = 0;
+                    for(int i = 0; i < old_capacity; i++){
+                        if(old_ids[i] == -1) continue;
+                        if(old_ids[i] < ids) index_of[old_ids[i]] = old_index[i];
+                        else hash_store(old_ids[i], old_index[i]);
+                    }
+                    free(old_ids);
+                    free(old_index);
+                }
+            }
+
+            //Si el identificador ya existía, la tabla pasa a referirse al
+            //nodo más reciente, el mismo que se encuentra primero en el listado
+            node->index = nvertices;
+            vertices[nvertices++] = node;
+            if(node->id < ids) index_of[node->id] = node->index;
+            else hash_store(node->id, node->index);
+            adjacency_ready = false;
+        }
+
+        /*
+            Función que libera las tablas de acceso y las conexiones en
+            formato CSR.
+        */
+        void free_tables(){
+            free(index_of);
+            free(hash_ids);
+            free(hash_index);
+            free(vertices);
+            free(offsets);
+            free(targets);
+            index_of = NULL;
+            hash_ids = hash_index = NULL;
+            vertices = NULL;
+            offsets = NULL;
+            targets = NULL;
+            ids = hash_count = hash_capacity = nvertices = capacity = nedges = 0;
+            adjacency_ready = false;
+        }
+
         /*
             Función que crea espacio en memoria para un NodeG<type>,
             es decir, un Nodo para un grafo de tipo <type>.
@@ -44,7 +234,8 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
         void* createNode() override {
             //sizeof( NodeG<type> ) ya que se necesita espacio para
             //un Nodo para grafos para almacenar un dato de tipo <type>
-            return malloc(sizeof(NodeG<T>));
+            //El espacio se solicita al asignador de la estructura
+            return alloc.allocate(sizeof(NodeG<T>));
         }
 
     public:
@@ -101,8 +292,16 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
 
                 //A través de la variable auxiliar temp, liberamos
                 //el nodo previamente "rescatado"
-                free(temp);
+                alloc.deallocate(temp);
             }
+
+            //Se liberan en bloque los nodos del grafo, en caso de que el
+            //asignador así lo permita. Las conexiones se reservan siempre
+            //por separado, por lo que se liberaron una por una
+            alloc.release();
+            //Se liberan también las tablas de acceso y las conexiones en
+            //formato CSR
+            free_tables();
             //Al final del proceso, G habrá quedado apuntando a NULL,
             //lo cual está bien ya que se interpreta como un grafo
             //vacío, y eso es coherente con la operación realizada.
@@ -287,6 +486,16 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
             //Para inicializar un grafo basta con que el puntero
             //al inicio del grafo apunte a NULL
             G = NULL;
+
+            //Las tablas de acceso y las conexiones en formato CSR inician
+            //vacías
+            index_of = NULL;
+            hash_ids = hash_index = NULL;
+            vertices = NULL;
+            offsets = NULL;
+            targets = NULL;
+            ids = hash_count = hash_capacity = nvertices = capacity = nedges = 0;
+            adjacency_ready = false;
         }
         
         /*
@@ -294,27 +503,9 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
             de tipo <type>.
         */
         int extension() override {
-            //Se inicializa un contador en 0
-            int cont = 0;
-
-            //Se copia el puntero al inicio del grafo para no
-            //perder la referencia durante el proceso de recorrido
-            NodeG<T>* Gcopy = G;
-
-            //Se recorre el listado del grafo hasta el final
-            while(Gcopy != NULL){
-                //Si entramos al while, hay un nodo no evaluado
-                //Se actualiza el contador
-                cont++;
-
-                //Se avanza al siguiente nodo del grafo
-                Gcopy = Gcopy->next;
-            }
-
-            /* Se puede añadir acá el conteo del número de aristas */
-
-            //Se retorna el resultado
-            return cont;
+            //Cada nodo insertado tiene su propio índice, por lo que la
+            //cantidad de nodos es la cantidad de índices asignados
+            return nvertices;
         }
 
         /*
@@ -352,6 +543,9 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
             //El nuevo inicio del listado de nodos del grafo será el
             //nuevo nodo creado
             G = temp;
+
+            //Se registra el nuevo nodo para accederlo por identificador
+            register_node(temp);
         }
 
         /*
@@ -361,21 +555,461 @@ class DSG: public dynamicDS<T>,public measurable,public positionable<T> {
             Se asume pre-validación de un identificador válido.
         */
         T extract(int id) override {
-            //Se copia el puntero al inicio del grafo para no
-            //perder la referencia durante el proceso de recorrido
-            NodeG<T>* Gcopy = G;
+            //Se obtiene el nodo a través de la tabla de identificadores
+            return vertices[lookup(id)]->data;
+        }
 
-            //Se recorre el listado de nodos del grafo hasta el final
-            while(Gcopy != NULL){
-                //Si el nodo actual corresponde con el solicitado,
-                //ya no seguimos recorriendo el listado
-                if(Gcopy->id == id) break;
+        /*
+            Función que retorna la dirección del nodo con identificador <id>
+            del grafo local de tipo <type>, o NULL si no existe.
+        */
+        NodeG<T>* find(int id){
+            int pos = lookup(id);
+            if(pos == -1) return NULL;
+            return vertices[pos];
+        }
 
-                //Se avanza al siguiente nodo del grafo
-                Gcopy = Gcopy->next;
+        /*
+            Función que define la lista enlazada simple <C>, de punteros a nodos
+            del grafo, como el listado de conexiones del nodo con identificador
+            <id>. Si el nodo ya tenía conexiones, se liberan.
+
+            Se asume pre-validación de un identificador válido.
+        */
+        void set_connections(int id, NodeSL<NodeG<T>*>* C){
+            NodeG<T>* node = vertices[lookup(id)];
+
+            NodeSL<NodeG<T>*>* L = node->connections;
+            while(L != NULL){
+                NodeSL<NodeG<T>*>* tempL = L;
+                L = L->next;
+                free(tempL);
+            }
+
+            node->connections = C;
+
+            //Las conexiones en formato CSR deben reconstruirse
+            adjacency_ready = false;
+        }
+
+        /*
+            Función que construye las conexiones en formato CSR a partir de los
+            listados de conexiones de los nodos. Si no ha habido cambios desde
+            la última construcción, no se hace nada.
+        */
+        void build_adjacency(){
+            if(adjacency_ready) return;
+
+            //Primero se cuentan las conexiones de cada nodo, acumulándolas
+            //para obtener dónde inicia cada una en el arreglo contiguo
+            Perf::count_allocation(sizeof(int)*(nvertices+1));
+            offsets = (int*) realloc(offsets, sizeof(int)*(nvertices+1));
+            offsets[0] = 0;
+            for(int i = 0; i < nvertices; i++){
+                int cont = 0;
+                for(NodeSL<NodeG<T>*>* L = vertices[i]->connections; L != NULL; L = L->next) cont++;
+                offsets[i+1] = offsets[i] + cont;
+            }
+            nedges = offsets[nvertices];
+
+            //Luego se colocan los índices de los nodos conectados, conservando
+            //el orden de cada listado de conexiones
+            Perf::count_allocation(sizeof(int)*max(nedges, 1));
+            targets = (int*) realloc(targets, sizeof(int)*max(nedges, 1));
+            for(int i = 0; i < nvertices; i++){
+                int k = offsets[i];
+                for(NodeSL<NodeG<T>*>* L = vertices[i]->connections; L != NULL; L = L->next)
+                    targets[k++] = L->data->index;
+            }
+
+            adjacency_ready = true;
+        }
+
+        /*
+            Funciones de acceso a las conexiones en formato CSR. Deben
+            utilizarse después de invocar build_adjacency().
+        */
+        const int* adjacency_offsets(){ return offsets; }
+        const int* adjacency_targets(){ return targets; }
+        int edges(){ return nedges; }
+
+        /*
+            Funciones de conversión entre el identificador de un nodo y su
+            índice. index() retorna -1 si el identificador no existe.
+        */
+        int index(int id){
+            return lookup(id);
+        }
+        int id(int index){ return vertices[index]->id; }
+        NodeG<T>* vertex(int index){ return vertices[index]; }
+
+        /*========= Algoritmos sobre el grafo ===============*/
+
+        /*
+            Función que realiza un recorrido en anchura del grafo a partir del
+            nodo con índice <source>.
+
+            Se reciben <order> y <level> como arreglos de al menos extension()
+            posiciones. En <order> se colocan los índices de los nodos en el
+            orden en que se visitan, y en <level>, para cada índice, la cantidad
+            de conexiones que lo separan de <source>, o -1 si no es alcanzable.
+            <level> puede ser NULL si no se necesita.
+
+            El recorrido avanza por niveles: los nodos de un mismo nivel, la
+            "frontera", ocupan un tramo contiguo de <order>, y la siguiente
+            frontera se forma a continuación con los nodos aún no visitados
+            conectados a ella. Así, <order> hace a la vez de cola y de resultado.
+
+            Se retorna la cantidad de nodos visitados.
+        */
+        int bfs(int source, int* order, int* level){
+            build_adjacency();
+
+            //Si no se necesitan los niveles, se utiliza un arreglo auxiliar,
+            //ya que también sirven para marcar los nodos visitados
+            int* aux = NULL;
+            if(level == NULL){
+                Perf::count_allocation(sizeof(int)*nvertices);
+                level = aux = (int*) malloc(sizeof(int)*nvertices);
+            }
+            for(int i = 0; i < nvertices; i++) level[i] = -1;
+
+            order[0] = source;
+            level[source] = 0;
+            int begin = 0, end = 1, depth = 0;
+
+            //Mientras la frontera actual, order[begin..end-1], no esté vacía,
+            //se construye la siguiente
+            while(begin < end){
+                int next = end;
+                depth++;
+                for(int f = begin; f < end; f++){
+                    int v = order[f];
+                    for(int k = offsets[v]; k < offsets[v+1]; k++){
+                        int w = targets[k];
+                        if(level[w] == -1){
+                            level[w] = depth;
+                            order[next++] = w;
+                        }
+                    }
+                }
+                begin = end;
+                end = next;
+            }
+
+            free(aux);
+            return end;
+        }
+
+        /*
+            Función que realiza un recorrido en profundidad del grafo a partir
+            del nodo con índice <source>.
+
+            Se recibe <order> como un arreglo de al menos extension() posiciones,
+            en el que se colocan los índices de los nodos en el orden en que se
+            visitan, el mismo que produciría la versión recursiva siguiendo cada
+            listado de conexiones en orden.
+
+            En lugar de la recursión se utiliza una pila explícita que guarda,
+            para cada nodo del camino actual, la siguiente conexión a explorar,
+            de modo que grafos con caminos largos no agotan la pila del programa.
+
+            Se retorna la cantidad de nodos visitados.
+        */
+        int dfs(int source, int* order){
+            build_adjacency();
+
+            Perf::count_allocation((sizeof(bool) + 2*sizeof(int))*nvertices, 3);
+            bool* visited = (bool*) calloc(nvertices, sizeof(bool));
+            int* stack = (int*) malloc(sizeof(int)*nvertices);
+            int* edge = (int*) malloc(sizeof(int)*nvertices);
+
+            int cont = 0, top = 0;
+            visited[source] = true;
+            order[cont++] = source;
+            stack[0] = source;
+            edge[0] = offsets[source];
+
+            while(top >= 0){
+                int v = stack[top];
+
+                //Si el nodo del tope ya no tiene conexiones por explorar,
+                //se regresa al nodo anterior del camino
+                if(edge[top] == offsets[v+1]){
+                    top--;
+                    continue;
+                }
+
+                //De lo contrario se toma su siguiente conexión, y si lleva a un
+                //nodo no visitado, se avanza hacia él
+                int w = targets[edge[top]++];
+                if(!visited[w]){
+                    visited[w] = true;
+                    order[cont++] = w;
+                    top++;
+                    stack[top] = w;
+                    edge[top] = offsets[w];
+                }
+            }
+
+            free(visited);
+            free(stack);
+            free(edge);
+            return cont;
+        }
+
+        /*
+            Función que determina las componentes conexas del grafo.
+
+            Se recibe <component> como un arreglo de al menos extension()
+            posiciones, en el que se coloca, para cada índice, el número de
+            la componente a la que pertenece el nodo, numeradas desde 0 en el
+            orden de sus nodos de menor índice.
+
+            Se asume que las conexiones son simétricas, como en la conectividad
+            de una malla; de lo contrario, cada componente contiene los nodos
+            alcanzables desde su primer nodo que no pertenezcan a una anterior.
+
+            Se retorna la cantidad de componentes.
+        */
+        int components(int* component){
+            build_adjacency();
+
+            Perf::count_allocation(sizeof(int)*nvertices);
+            int* queue = (int*) malloc(sizeof(int)*nvertices);
+            for(int i = 0; i < nvertices; i++) component[i] = -1;
+
+            //Cada nodo no asignado inicia una nueva componente, que se completa
+            //con un recorrido en anchura
+            int ncomponents = 0;
+            for(int s = 0; s < nvertices; s++){
+                if(component[s] != -1) continue;
+
+                component[s] = ncomponents;
+                queue[0] = s;
+                int begin = 0, end = 1;
+                while(begin < end){
+                    int v = queue[begin++];
+                    for(int k = offsets[v]; k < offsets[v+1]; k++){
+                        int w = targets[k];
+                        if(component[w] == -1){
+                            component[w] = ncomponents;
+                            queue[end++] = w;
+                        }
+                    }
+                }
+                ncomponents++;
+            }
+
+            free(queue);
+            return ncomponents;
+        }
+
+        /*
+            Función que calcula los caminos más cortos desde el nodo con índice
+            <source> hacia todos los demás, mediante el algoritmo de Dijkstra.
+
+            Se recibe <weight> como una función que, dados dos nodos conectados,
+            retorna el peso no negativo de su conexión, por ejemplo la distancia
+            entre dos nodos de una malla.
+
+            Se reciben <dist> y <previous> como arreglos de al menos extension()
+            posiciones. En <dist> se coloca, para cada índice, la longitud del
+            camino más corto desde <source>, o -1 si no es alcanzable, y en
+            <previous> el índice del nodo anterior en dicho camino, o -1 para
+            <source> y los no alcanzables. <previous> puede ser NULL si no se
+            necesita.
+
+            Los nodos pendientes se mantienen en un montículo binario ordenado
+            por distancia. En lugar de actualizar la distancia de un nodo dentro
+            del montículo, se inserta de nuevo, y las entradas obsoletas se
+            descartan al extraerlas; así el montículo tiene a lo sumo edges()+1
+            entradas.
+        */
+        template <typename Weight>
+        void dijkstra(int source, Weight weight, double* dist, int* previous){
+            build_adjacency();
+
+            struct Entry{
+                double key;
+                int v;
+            };
+
+            Perf::count_allocation(sizeof(Entry)*(nedges+1) + sizeof(bool)*nvertices, 2);
+            Entry* heap = (Entry*) malloc(sizeof(Entry)*(nedges+1));
+            bool* done = (bool*) calloc(nvertices, sizeof(bool));
+            int nheap = 0;
+
+            for(int i = 0; i < nvertices; i++){
+                dist[i] = -1;
+                if(previous != NULL) previous[i] = -1;
+            }
+
+            dist[source] = 0;
+            heap[nheap++] = {0, source};
+
+            while(nheap > 0){
+                //Se extrae la entrada de menor distancia, colocando la última
+                //en la raíz y hundiéndola hasta su lugar
+                Entry top = heap[0];
+                Entry last = heap[--nheap];
+                int i = 0;
+                while(2*i+1 < nheap){
+                    int c = 2*i+1;
+                    if(c+1 < nheap && heap[c+1].key < heap[c].key) c++;
+                    if(!(heap[c].key < last.key)) break;
+                    heap[i] = heap[c];
+                    i = c;
+                }
+                if(nheap > 0) heap[i] = last;
+
+                //Las entradas obsoletas corresponden a nodos ya resueltos
+                int v = top.v;
+                if(done[v]) continue;
+                done[v] = true;
+
+                for(int k = offsets[v]; k < offsets[v+1]; k++){
+                    int w = targets[k];
+                    if(done[w]) continue;
+
+                    double d = top.key + weight(vertices[v], vertices[w]);
+                    if(dist[w] < 0 || d < dist[w]){
+                        dist[w] = d;
+                        if(previous != NULL) previous[w] = v;
+
+                        //Se inserta la nueva entrada al final y se eleva
+                        //hasta su lugar
+                        int j = nheap++;
+                        while(j > 0 && d < heap[(j-1)/2].key){
+                            heap[j] = heap[(j-1)/2];
+                            j = (j-1)/2;
+                        }
+                        heap[j] = {d, w};
+                    }
+                }
             }
 
-            //Se retorna el dato del nodo del grafo solicitado
-            return Gcopy->data;
+            free(heap);
+            free(done);
+        }
+
+        /*
+            Función que calcula los caminos más cortos desde el nodo con índice
+            <source>, como la anterior, pero con todas las conexiones de peso 1.
+        */
+        void dijkstra(int source, double* dist, int* previous){
+            dijkstra(source, [](NodeG<T>*, NodeG<T>*){ return 1.0; }, dist, previous);
+        }
+
+        /*
+            Función que obtiene un ordenamiento de los nodos del grafo que
+            reduce el ancho de banda de su matriz de adyacencia, mediante el
+            algoritmo Reverse Cuthill-McKee.
+
+            Se recibe <order> como un arreglo de al menos extension() posiciones,
+            en el que se colocan los índices de todos los nodos en el nuevo orden.
+
+            Cada componente conexa se recorre en anchura a partir de un nodo
+            pseudo-periférico, visitando las conexiones de cada nodo en orden
+            creciente de grado, y al final se invierte el orden completo. Así,
+            los nodos conectados entre sí quedan en posiciones cercanas.
+
+            Se asume que las conexiones son simétricas y sin repeticiones.
+        */
+        void reverse_cuthill_mckee(int* order){
+            build_adjacency();
+
+            Perf::count_allocation(sizeof(int)*nvertices + sizeof(bool)*nvertices, 2);
+            int* mark = (int*) malloc(sizeof(int)*nvertices);
+            bool* placed = (bool*) calloc(nvertices, sizeof(bool));
+            for(int i = 0; i < nvertices; i++) mark[i] = -1;
+
+            //<stamp> identifica cada recorrido de búsqueda del nodo inicial, de
+            //modo que <mark> no necesita reiniciarse entre recorridos
+            int stamp = 0;
+            int cont = 0;
+
+            for(int s = 0; s < nvertices; s++){
+                if(placed[s]) continue;
+
+                //Se busca un nodo pseudo-periférico de la componente de <s>:
+                //partiendo de <s>, se recorre la componente por niveles y se
+                //pasa al nodo de menor grado del último nivel, mientras la
+                //cantidad de niveles siga aumentando
+                int root = s, depth = -1;
+                while(true){
+                    int begin = cont, end = cont + 1, levels = 0;
+                    order[cont] = root;
+                    mark[root] = stamp;
+                    int last_begin = begin;
+                    while(begin < end){
+                        int next = end;
+                        last_begin = begin;
+                        for(int f = begin; f < end; f++){
+                            int v = order[f];
+                            for(int k = offsets[v]; k < offsets[v+1]; k++)
+                                if(mark[targets[k]] != stamp){
+                                    mark[targets[k]] = stamp;
+                                    order[next++] = targets[k];
+                                }
+                        }
+                        begin = end;
+                        end = next;
+                        levels++;
+                    }
+                    stamp++;
+
+                    if(levels <= depth) break;
+                    depth = levels;
+
+                    int candidate = order[last_begin];
+                    for(int f = last_begin; f < end; f++)
+                        if(degree(order[f]) < degree(candidate)) candidate = order[f];
+                    if(candidate == root) break;
+                    root = candidate;
+                }
+
+                //Recorrido de Cuthill-McKee desde el nodo encontrado. <order> se
+                //utiliza como cola a partir de la posición <cont>
+                int head = cont;
+                order[cont++] = root;
+                placed[root] = true;
+                while(head < cont){
+                    int v = order[head++];
+                    int first = cont;
+                    for(int k = offsets[v]; k < offsets[v+1]; k++){
+                        int w = targets[k];
+                        if(placed[w]) continue;
+                        placed[w] = true;
+
+                        //Las conexiones nuevas se insertan ordenadas por grado,
+                        //conservando el orden original entre grados iguales
+                        int j = cont++;
+                        while(j > first && degree(order[j-1]) > degree(w)){
+                            order[j] = order[j-1];
+                            j--;
+                        }
+                        order[j] = w;
+                    }
+                }
+            }
+
+            //Se invierte el orden obtenido
+            for(int i = 0, j = nvertices - 1; i < j; i++, j--){
+                int temp = order[i];
+                order[i] = order[j];
+                order[j] = temp;
+            }
+
+            free(mark);
+            free(placed);
+        }
+
+        /*
+            Función que retorna la cantidad de conexiones del nodo con índice
+            <index>. Debe utilizarse después de invocar build_adjacency().
+        */
+        int degree(int index){
+            return offsets[index+1] - offsets[index];
         }
 };
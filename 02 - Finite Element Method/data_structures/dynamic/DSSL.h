@@ -3,8 +3,13 @@
 
     Se define la implementación como independiente del tipo de dato
     a almacenar mediante el uso de template.
+
+    El segundo "meta-parámetro", <Allocator>, indica el asignador de memoria
+    para los nodos (ver "allocators.h"). Por defecto se utiliza
+    MallocAllocator, que reserva cada nodo por separado; con PoolAllocator los
+    nodos se reservan en bloques contiguos y se liberan todos juntos.
 */
-template <typename T>
+template <typename T, class Allocator = MallocAllocator>
 /*
     En C++, la implementación se maneja como una herencia,
     de modo que DSSL hereda de:
@@ -12,6 +17,8 @@ template <typename T>
           básica de una estructura de datos dinámica.
         - insertable, ya que permite la inserción de datos sin
           necesidad de indexamiento.
+        - appendable, ya que permite añadir datos al final de la
+          lista.
         - measurable, ya que es posible obtener la longitud de una
           lista enlazada simple.
         - positionable, ya que es posible indexar una lista enlazada
@@ -29,7 +36,7 @@ template <typename T>
     también es un template, por lo que el "meta-parámetro" es el
     tipo de dato genérico local <T>.
 */
-class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public positionable<T>,public reversible {
+class DSSL: public dynamicDS<T>,public insertable<T>,public appendable<T>,public measurable,public positionable<T>,public reversible {
     private:
         /*
             Como atributo privado local se manejará la lista enlazada
@@ -40,6 +47,20 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
         */
         NodeSL<T>* L;
 
+        //Asignador de memoria propio de la estructura para sus nodos
+        Allocator alloc;
+
+        /*
+            Se mantienen además, como atributos privados, un puntero al
+            último nodo de la lista y la cantidad de nodos almacenados.
+
+            Ambos se actualizan en cada operación que modifica la lista, de
+            modo que obtener la longitud y añadir un dato al final de la
+            lista no requieren recorrerla por completo.
+        */
+        NodeSL<T>* tail;
+        int length;
+
         /*
             Función que crea espacio en memoria para un NodeSL<type>,
             es decir, un Nodo para una lista enlazada simple de tipo
@@ -52,7 +73,8 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             //sizeof( NodeSL<type> ) ya que se necesita espacio para
             //un Nodo para listas enlazadas simples para almacenar un
             //dato de tipo <type>
-            return malloc(sizeof(NodeSL<T>));
+            //El espacio se solicita al asignador de la estructura
+            return alloc.allocate(sizeof(NodeSL<T>));
         }
 
     public:
@@ -72,6 +94,15 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             <type>.
         */
         void destroy() override {
+            //Si el asignador libera todos los nodos de una sola vez, no es
+            //necesario recorrer la lista
+            if(alloc.release()){
+                L = NULL;
+                tail = NULL;
+                length = 0;
+                return;
+            }
+
             //Variable auxiliar para el proceso
             NodeSL<T>* temp;
 
@@ -88,9 +119,13 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
 
                 //A través de la variable auxiliar, liberamos
                 //el nodo previamente "rescatado"
-                free(temp);
+                alloc.deallocate(temp);
             }
 
+            //La lista queda vacía, por lo que no hay último nodo
+            tail = NULL;
+            length = 0;
+
             //Al final del proceso, L habrá quedado apuntando a NULL,
             //lo cual está bien ya que se interpreta como una lista
             //vacía, y eso es coherente con la operación realizada.
@@ -236,6 +271,9 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             //Para inicializar una lista enlazada simple basta con
             //que el puntero al inicio de la lista apunte a NULL
             L = NULL;
+            //La lista vacía no tiene último nodo y su longitud es 0
+            tail = NULL;
+            length = 0;
         }
 
         /*
@@ -264,6 +302,43 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
 
             //Se define el inicio de la lista como el nuevo nodo
             L = temp;
+            //Si la lista estaba vacía, el nuevo nodo es también el último
+            if(tail == NULL) tail = temp;
+            //La lista tiene ahora un dato más
+            length++;
+        }
+
+        /*
+            Función para añadir un valor <value> de tipo <type>
+            al final de la lista enlazada simple local de tipo <type>.
+
+            Gracias a la referencia al último nodo, no es necesario
+            recorrer la lista.
+        */
+        void push_back(T value) override {
+            //Se crea un nuevo nodo para la lista enlazada simple
+            //que alojará el nuevo valor <value>
+            NodeSL<T>* temp = (NodeSL<T>*) createNode();
+            //Se coloca el valor <value> en el nuevo nodo
+            temp->data = value;
+            //Como el nuevo nodo se colocará al final de la lista,
+            //no tiene nodo siguiente
+            temp->next = NULL;
+
+            //Se verifica si la lista se encuentra actualmente vacía
+            if(L == NULL)
+                //Si la lista está vacía, el nuevo nodo es también el
+                //inicio de la lista
+                L = temp;
+            else
+                //Si la lista no está vacía, el nuevo nodo se conecta
+                //como siguiente del último nodo actual
+                tail->next = temp;
+
+            //El nuevo nodo es ahora el último de la lista
+            tail = temp;
+            //La lista tiene ahora un dato más
+            length++;
         }
         
         /*
@@ -271,26 +346,9 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             simple local de tipo <type>.
         */
         int extension() override {
-            //Se inicializa un contador en 0
-            int cont = 0;
-
-            //Se copia el puntero al inicio de la lista enlazada
-            //simple para no perder la referencia durante el
-            //proceso de recorrido
-            NodeSL<T>* Lcopy = L;
-
-            //Se recorre la lista hasta el final
-            while(Lcopy != NULL){
-                //Si entramos al while, hay un nodo no evaluado
-                //Se actualiza el contador
-                cont++;
-
-                //Se avanza al siguiente nodo de la lista
-                Lcopy = Lcopy->next;
-            }
-
-            //Se retorna el resultado
-            return cont;
+            //La longitud se mantiene actualizada en cada modificación
+            //de la lista, por lo que basta con retornarla
+            return length;
         }
         
         /*
@@ -323,6 +381,12 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             //El nuevo nodo siguiente del "nodo anterior" es el nuevo
             //nodo
             Lcopy->next = temp;
+
+            //Si el "nodo anterior" era el último de la lista, el nuevo
+            //nodo pasa a ser el último
+            if(Lcopy == tail) tail = temp;
+            //La lista tiene ahora un dato más
+            length++;
         }
 
         /*
@@ -338,6 +402,10 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             //proceso de recorrido
             NodeSL<T>* Lcopy = L;
 
+            //Si se solicita el último dato, se obtiene directamente
+            //del último nodo sin recorrer la lista
+            if(pos == length-1) return tail->data;
+
             //Se avanza en la lista hasta la posición indicada por
             //el parámetro <pos>
             for(int i = 0; i < pos; i++) Lcopy = Lcopy->next;
@@ -352,63 +420,40 @@ class DSSL: public dynamicDS<T>,public insertable<T>,public measurable,public po
             simple de tipo <type>.
         */
         void reverse() override {
-            //Se prepara un puntero a Nodo de lista enlazada simple para
-            //datos de tipo <type> que servirá para apuntar al inicio de
-            //una nueva lista que contendrá los datos de la lista actual
-            //en orden invertido
-            NodeSL<T>* new_one = NULL;
+            //La inversión se realiza en el lugar, reconectando los nodos
+            //existentes sin reservar ni liberar memoria.
+
+            //Puntero al inicio de la parte ya invertida de la lista,
+            //que al comenzar se encuentra vacía
+            NodeSL<T>* prev = NULL;
 
             //Se copia el puntero al inicio de la lista enlazada
             //simple para no perder la referencia durante el
             //proceso de recorrido
             NodeSL<T>* Lcopy = L;
 
-            //Se prepara un puntero a nodo de lista enlazada simple
-            //de tipo <type> adicional que servirá como variable auxiliar
+            //Variable auxiliar para no perder el resto de la lista
             NodeSL<T>* temp;
 
+            //El nodo inicial actual será el último al terminar
+            tail = L;
+
             //Se recorre la lista hasta el final
             while(Lcopy != NULL){
-                /*Se crea un nodo para la nueva lista, manteniendo que
-                  sea para una lista enlazada simple para datos de tipo
-                  <type>.
-                  Dado que createNode() retorna un puntero "crudo", es
-                  necesario hacer el casting correspondiente para darle
-                  formato al bloque de memoria otorgado.               */
-                temp = (NodeSL<T>*) createNode();
-
-                //Se coloca en el nuevo nodo el dato ubicado en el nodo
-                //actual del recorrido de la lista local
-                temp->data = Lcopy->data;
-
-                //Se procede a insertar el nuevo nodo al inicio de la
-                //nueva lista
-                //Se verifica primero si la nueva lista se encuentra vacía
-                if(new_one == NULL)
-                    //Si la nueva lista se encuentra vacía, el nodo siguiente
-                    //al nuevo nodo creado aún no existe, por lo que se define
-                    //como NULL
-                    temp->next = NULL;
-                else
-                    //Si la nueva lista no está vacía, entonces el nodo siguiente
-                    //al nuevo nodo creado es el nodo que actualmente se encuentra
-                    //al inicio de la nueva lista
-                    temp->next = new_one;
-
-                //El nuevo inicio de la nueva lista es ahora el nuevo nodo creado
-                new_one = temp;
-
-                //Se avanza al siguiente nodo de la lista local
-                Lcopy = Lcopy->next;
-            }
+                //Se "rescata" el nodo siguiente antes de reconectar
+                temp = Lcopy->next;
 
-            //La lista local en su estado actual ya no será utilizada, por lo que
-            //se invoca a la función destroy() para liberar todo el espacio de
-            //memoria que le corresponde
-            destroy();
+                //El nodo actual pasa a apuntar a la parte ya invertida
+                Lcopy->next = prev;
+
+                //El nodo actual es ahora el inicio de la parte invertida
+                prev = Lcopy;
+
+                //Se avanza al nodo "rescatado"
+                Lcopy = temp;
+            }
 
-            //La nueva lista local será ahora la nueva lista creada, que contiene
-            //los datos de la lista original en el orden inverso
-            L = new_one;
+            //El inicio de la lista es ahora el que era su último nodo
+            L = prev;
         }
 };
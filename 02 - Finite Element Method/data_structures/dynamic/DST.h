@@ -3,8 +3,23 @@
 
     Se define la implementación como independiente del tipo de dato
     a almacenar mediante el uso de template.
+
+    El segundo "meta-parámetro", <Allocator>, indica el asignador de memoria
+    para los nodos (ver "allocators.h"). Por defecto se utiliza
+    MallocAllocator, que reserva cada nodo por separado; con PoolAllocator los
+    nodos se reservan en bloques contiguos y se liberan todos juntos.
+
+    El árbol puede crearse en modo balanceado (AVL), en cuyo caso cada
+    inserción aplica las rotaciones necesarias para que la altura del árbol
+    se mantenga en O(log n) aun cuando los datos se insertan ordenados, como
+    ocurre típicamente con los IDs de los nodos de una malla.
+
+    Cada nodo almacena la altura y la cantidad de nodos de su sub-árbol, por
+    lo que la altura del árbol se obtiene sin recorrerlo, y las búsquedas y
+    conteos descienden por un solo camino siguiendo el orden del árbol. La
+    inserción y la liberación se realizan de forma iterativa, sin recursión.
 */
-template <typename type>
+template <typename type, class Allocator = MallocAllocator>
 /*
     En C++, la implementación se maneja como una herencia,
     de modo que DST hereda de:
@@ -36,6 +51,12 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
         */
         NodeT<type>* T;
 
+        //Indica si el árbol se mantiene balanceado (AVL) en cada inserción
+        bool balanced;
+
+        //Asignador de memoria propio de la estructura para sus nodos
+        Allocator alloc;
+
         /*
             Función que crea espacio en memoria para un NodeT<type>,
             es decir, un Nodo para un árbol binario de búsqueda de tipo
@@ -48,25 +69,152 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             //sizeof( NodeT<type> ) ya que se necesita espacio para
             //un Nodo para árboles binarios de búsqueda para almacenar un
             //dato de tipo <type>
-            return malloc(sizeof(NodeT<type>));
+            //El espacio se solicita al asignador de la estructura
+            return alloc.allocate(sizeof(NodeT<type>));
         }
 
         /*=== Funciones auxiliares para el manejo de árboles binarios de búsqueda ===*/
         /*
-            Función auxiliar para calcular la altura de un árbol binario de búsqueda
+            Función auxiliar que retorna la altura de un árbol binario de búsqueda
             de tipo <type>.
 
-            Se recibe <tree> como el árbol cuya altura se desea calcular.
+            Se recibe <tree> como el árbol cuya altura se desea obtener. La altura
+            de cada sub-árbol se almacena en su nodo raíz, y la de un árbol vacío
+            es 0.
         */
         int height(NodeT<type>* tree){
-            //Si el árbol está vacío su altura es 0
-            if(tree == NULL) return 0;
-
-            //Si el árbol no está vacío, se calcula la altura del sub-árbol
-            //izquierdo y la altura del sub-árbol derecho, luego se determina
-            //cuál de estos resultados es el más grande y se retorna sumándole 1,
-            //para incluir el nodo actual en el conteo
-            return max( 1 + height(tree->left) , 1 + height(tree->right) );
+            return (tree == NULL) ? 0 : tree->height;
+        }
+
+        /*
+            Función auxiliar que retorna la cantidad de nodos de un árbol binario
+            de búsqueda de tipo <type>, la cual se almacena en su nodo raíz.
+        */
+        int size(NodeT<type>* tree){
+            return (tree == NULL) ? 0 : tree->size;
+        }
+
+        /*
+            Función auxiliar que recalcula la altura y la cantidad de nodos
+            almacenadas en el nodo <tree> a partir de las de sus hijos.
+        */
+        void update(NodeT<type>* tree){
+            tree->height = 1 + max( height(tree->left) , height(tree->right) );
+            tree->size = 1 + size(tree->left) + size(tree->right);
+        }
+
+        /*
+            Función auxiliar que reemplaza, en el padre de <old_node>, la conexión
+            hacia <old_node> por una conexión hacia <new_node>. Si <old_node> es
+            la raíz, <new_node> pasa a ser la raíz del árbol.
+        */
+        void replace_child(NodeT<type>* old_node, NodeT<type>* new_node){
+            NodeT<type>* parent = old_node->parent;
+            new_node->parent = parent;
+
+            if(parent == NULL) T = new_node;
+            else if(parent->left == old_node) parent->left = new_node;
+            else parent->right = new_node;
+        }
+
+        /*
+            Funciones auxiliares para las rotaciones del árbol balanceado.
+
+            Se recibe <x> como la raíz del sub-árbol a rotar, y se retorna la
+            nueva raíz del sub-árbol, que es el hijo derecho de <x> en la rotación
+            a la izquierda y el hijo izquierdo de <x> en la rotación a la derecha:
+
+                    x                      y                    x
+                   / \    izquierda       / \    derecha       / \
+                  a   y   ---------->    x   c  ---------->   a   y
+                     / \                / \                      / \
+                    b   c              a   b                    b   c
+
+            Las rotaciones conservan el orden del recorrido In-Order, por lo que
+            el árbol sigue siendo un árbol binario de búsqueda.
+        */
+        NodeT<type>* rotate_left(NodeT<type>* x){
+            NodeT<type>* y = x->right;
+
+            //El sub-árbol <b> pasa a ser el hijo derecho de <x>
+            x->right = y->left;
+            if(y->left != NULL) y->left->parent = x;
+
+            //<y> toma el lugar de <x>, y <x> pasa a ser su hijo izquierdo
+            replace_child(x, y);
+            y->left = x;
+            x->parent = y;
+
+            //Se actualizan las alturas y cantidades, primero las del nodo
+            //que quedó abajo
+            update(x);
+            update(y);
+            return y;
+        }
+
+        NodeT<type>* rotate_right(NodeT<type>* y){
+            NodeT<type>* x = y->left;
+
+            //El sub-árbol <b> pasa a ser el hijo izquierdo de <y>
+            y->left = x->right;
+            if(x->right != NULL) x->right->parent = y;
+
+            //<x> toma el lugar de <y>, y <y> pasa a ser su hijo derecho
+            replace_child(y, x);
+            x->right = y;
+            y->parent = x;
+
+            //Se actualizan las alturas y cantidades, primero las del nodo
+            //que quedó abajo
+            update(y);
+            update(x);
+            return x;
+        }
+
+        /*
+            Función auxiliar que, luego de una inserción, recorre el camino desde
+            <tree> hasta la raíz actualizando las alturas almacenadas.
+
+            Si el árbol es balanceado, en cada nodo del camino se verifica además
+            el factor de balance (la diferencia entre las alturas de sus
+            sub-árboles), y si supera 1 en valor absoluto se aplica la rotación
+            simple o doble correspondiente.
+
+            El recorrido se detiene en cuanto la altura de un sub-árbol no cambia,
+            ya que a partir de ahí las alturas de los ancestros tampoco cambian.
+            En el árbol balanceado esto ocurre a más tardar luego de la primera
+            rotación.
+        */
+        void rebalance(NodeT<type>* tree){
+            while(tree != NULL){
+                int old_height = tree->height;
+                update(tree);
+
+                if(balanced){
+                    int factor = height(tree->left) - height(tree->right);
+
+                    //Sub-árbol izquierdo más alto
+                    if(factor > 1){
+                        //Caso izquierda-derecha: rotación doble
+                        if(height(tree->left->left) < height(tree->left->right))
+                            rotate_left(tree->left);
+                        tree = rotate_right(tree);
+                    }
+                    //Sub-árbol derecho más alto
+                    else if(factor < -1){
+                        //Caso derecha-izquierda: rotación doble
+                        if(height(tree->right->right) < height(tree->right->left))
+                            rotate_right(tree->right);
+                        tree = rotate_left(tree);
+                    }
+                }
+
+                //Si la altura del sub-árbol no cambió, no hay nada más que hacer
+                if(tree->height == old_height) break;
+
+                //Se sube al padre del nodo actual
+                tree = tree->parent;
+            }
         }
 
         /*
@@ -77,40 +225,49 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             <tree> como el árbol donde se insertará dicho nodo.
 
             Se asume que se recibe un árbol no vacío.
+
+            Se desciende iterativamente hasta la hoja donde corresponde el nuevo
+            nodo, contándolo en cada sub-árbol por el que se pasa, y luego se
+            actualizan las alturas del camino hasta la raíz.
         */
         void insert_aux(NodeT<type>* tree, NodeT<type>* node){
-            //Si el dato del nuevo nodo es menor o igual al dato
-            //del nodo actual, el nuevo nodo deberá insertarse en el
-            //sub-árbol izquierdo
-            if(node->data <= tree->data)
-                //Se verifica si el sub-árbol izquierdo es una hoja
-                if(tree->left == NULL){
-                    //El nuevo nodo será el nuevo hijo izquierdo
-
-                    //El padre del nuevo nodo es el nodo actual
-                    node->parent = tree;
-                    //El hijo izquierdo del nodo actual es el nuevo nodo
-                    tree->left = node;
-                }else
-                    //Si el sub-árbol izquierdo no es una hoja, se procede
-                    //a insertar el nuevo nodo en dicho sector
-                    insert_aux(tree->left,node);
-            
-            //Si el dato del nuevo nodo es mayor al dato del nodo actual,
-            //el nuevo nodo deberá insertarse en el sub-árbol derecho
-            else
-                //Se verifica si el sub-árbol derecho es una hoja
-                if(tree->right == NULL){
-                    //El nuevo nodo será el nuevo hijo derecho
-
-                    //El padre del nuevo nodo es el nodo actual
-                    node->parent = tree;
-                    //El hijo derecho del nodo actual es el nuevo nodo
-                    tree->right = node;
-                }else
-                    //Si el sub-árbol derecho no es una hoja, se procede
-                    //a insertar el nuevo nodo en dicho sector
-                    insert_aux(tree->right,node);
+            while(true){
+                //El nuevo nodo formará parte del sub-árbol actual
+                tree->size++;
+
+                //Si el dato del nuevo nodo es menor o igual al dato
+                //del nodo actual, el nuevo nodo deberá insertarse en el
+                //sub-árbol izquierdo
+                if(node->data <= tree->data){
+                    //Se verifica si el sub-árbol izquierdo es una hoja
+                    if(tree->left == NULL){
+                        //El nuevo nodo será el nuevo hijo izquierdo
+                        tree->left = node;
+                        break;
+                    }
+                    //Si no es una hoja, se desciende a dicho sector
+                    tree = tree->left;
+                }
+                //Si el dato del nuevo nodo es mayor al dato del nodo actual,
+                //el nuevo nodo deberá insertarse en el sub-árbol derecho
+                else{
+                    //Se verifica si el sub-árbol derecho es una hoja
+                    if(tree->right == NULL){
+                        //El nuevo nodo será el nuevo hijo derecho
+                        tree->right = node;
+                        break;
+                    }
+                    //Si no es una hoja, se desciende a dicho sector
+                    tree = tree->right;
+                }
+            }
+
+            //El padre del nuevo nodo es el nodo actual
+            node->parent = tree;
+
+            //Se actualizan las alturas, y se balancea de ser necesario,
+            //desde el padre del nuevo nodo hasta la raíz
+            rebalance(tree);
         }
 
         /*
@@ -120,19 +277,30 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             Se recibe <tree> como el árbol cuyo espacio en memoria se liberará.
         */
         void destroy_aux(NodeT<type>* tree){
-            //Si el árbol está vacío no hay nada que liberar
-            if(tree == NULL) return;
-
-            //Se libera todo el espacio de memoria utilizado por el sub-árbol
-            //izquierdo
-            destroy_aux(tree->left);
-
-            //Se libera todo el espacio de memoria utilizado por el sub-árbol
-            //derecho
-            destroy_aux(tree->right);
-
-            //Se libera el espacio de memoeria utilizado por el nodo actual
-            free(tree);
+            /*
+                Se recorre el árbol en Post-Order sin recursión, aprovechando
+                los punteros a los padres: se desciende hasta una hoja, se
+                libera, se desconecta de su padre y se continúa desde este.
+                Así cada nodo se libera luego de sus dos sub-árboles.
+            */
+            while(tree != NULL){
+                if(tree->left != NULL) tree = tree->left;
+                else if(tree->right != NULL) tree = tree->right;
+                else{
+                    //El nodo actual es una hoja, se desconecta de su padre
+                    NodeT<type>* parent = tree->parent;
+                    if(parent != NULL){
+                        if(parent->left == tree) parent->left = NULL;
+                        else parent->right = NULL;
+                    }
+
+                    //Se libera el espacio de memoeria utilizado por el nodo actual
+                    alloc.deallocate(tree);
+
+                    //Se continúa desde el padre
+                    tree = parent;
+                }
+            }
         }
 
         /*
@@ -144,40 +312,72 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
 
             Se retorna true si el dato se encuentra en el árbol, y se retorna
             false en caso contrario.
+
+            Dado que el recorrido In-Order del árbol está ordenado, si <value>
+            es menor que el dato del nodo actual solo puede encontrarse en el
+            sub-árbol izquierdo, y si es mayor solo en el sub-árbol derecho, por
+            lo que se desciende por un único camino.
         */
         bool search_aux(NodeT<type>* tree, type value){
-            //Si el árbol está vacío no hay nada que buscar
-            if(tree == NULL) return false;
-
-            //Si el árbol no está vacío, se verifica si el dato actual coincide
-            //con el dato buscado.
-            //De ser así se retorna una respuesta de éxito.
-            if(tree->data == value) return true;
-
-            //De no haberse encontrado el dato en el nodo actual, se retorna el
-            //resultado de buscarlo en el sub-árbol izquierdo y/o el sub-árbol
-            //derecho
-            return search_aux(tree->left,value) || search_aux(tree->right,value);
+            while(tree != NULL){
+                //Se verifica si el dato actual coincide con el dato buscado
+                if(tree->data == value) return true;
+
+                //De lo contrario se desciende hacia el lado que corresponde
+                tree = (value < tree->data) ? tree->left : tree->right;
+            }
+
+            //Se llegó a un sub-árbol vacío sin encontrar el dato
+            return false;
         }
 
         /*
-            Función auxiliar para el conteo de ocurrencias de un dato de tipo
-            <type> en un árbol binario de búsqueda de tipo <type>.
+            Función auxiliar que cuenta los datos de un árbol binario de búsqueda
+            de tipo <type> que son menores que <value>, o menores o iguales si
+            <inclusive> es true.
 
-            Se recibe <value> como el dato cuyas ocurrencias se desean contar,
-            y se recibe <tree> como el árbol donde se hará el proceso.
+            Se recibe <tree> como el árbol donde se hará el conteo.
 
-            Se retorna el resultado del conteo
+            Se desciende por un único camino: cada vez que el dato del nodo
+            actual cumple la condición, se cuentan el nodo y todo su sub-árbol
+            izquierdo de una sola vez, y se continúa por el sub-árbol derecho.
         */
-        int count_aux(NodeT<type>* tree, type value){
-            //Si el árbol está vacío, no hay nada que contar
-            if(tree == NULL) return 0;
-
-            //Si el árbol no está vacío, se cuentan las ocurrencias de <value> en
-            //el sub-árbol izquierda, a esto se le suma el total de ocurrencias de
-            //<value> en el sub-árbol derecho, y finalmente a esto se le suma 1 sólo
-            //si el dato del nodo actual también es una ocurrencia de <value>.
-            return ((tree->data == value)?1:0) + count_aux(tree->left,value) + count_aux(tree->right,value);
+        int count_less(NodeT<type>* tree, type value, bool inclusive){
+            int cont = 0;
+
+            while(tree != NULL){
+                if(tree->data < value || (inclusive && tree->data == value)){
+                    cont += size(tree->left) + 1;
+                    tree = tree->right;
+                }else
+                    tree = tree->left;
+            }
+
+            return cont;
+        }
+
+        /*
+            Función auxiliar que busca en un árbol binario de búsqueda de tipo
+            <type> el menor dato mayor que <value>, o mayor o igual si
+            <inclusive> es true.
+
+            Se recibe <tree> como el árbol donde se hará la búsqueda.
+
+            Se retorna el nodo que contiene dicho dato, o NULL si no existe.
+        */
+        NodeT<type>* bound_aux(NodeT<type>* tree, type value, bool inclusive){
+            NodeT<type>* candidate = NULL;
+
+            while(tree != NULL){
+                if(value < tree->data || (inclusive && tree->data == value)){
+                    //El nodo actual es candidato, y se busca uno menor a la izquierda
+                    candidate = tree;
+                    tree = tree->left;
+                }else
+                    tree = tree->right;
+            }
+
+            return candidate;
         }
 
         /*
@@ -199,17 +399,40 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             //Si el árbol está vacío, se muestra únicamente NULL
             if(tree == NULL){ cout << " NULL "; return; }
 
-            //Si el árbol no está vacío se abre el contenido
-            //y se coloca el dato del nodo actual
-            cout << "[ " << tree->data << " ";
-
-            //Se muestra el contenido del sub-árbol izquierdo
-            show_aux(tree->left);
-            //Se muestra el contenido del sub-árbol derecho
-            show_aux(tree->right);
-
-            //Se cierra el contenido del árbol
-            cout << "]";
+            /*
+                El recorrido se realiza sin recursión, moviéndose por los punteros
+                a los hijos y a los padres. <from> indica desde dónde se llegó al
+                nodo actual:
+                    - Desde su padre: se abre su contenido y se baja al hijo
+                      izquierdo.
+                    - Desde su hijo izquierdo: se baja al hijo derecho.
+                    - Desde su hijo derecho: se cierra su contenido y se sube.
+                Un hijo nulo se muestra directamente como NULL y se continúa como
+                si ya se hubiera regresado de él.
+            */
+            NodeT<type>* stop = tree->parent;
+            NodeT<type>* from = stop;
+
+            while(tree != stop){
+                if(from == tree->parent){
+                    //Se abre el contenido y se coloca el dato del nodo actual
+                    cout << "[ " << tree->data << " ";
+                    //Se baja al sub-árbol izquierdo
+                    if(tree->left != NULL){ from = tree; tree = tree->left; continue; }
+                    cout << " NULL ";
+                    from = NULL;
+                }
+                if(from == tree->left){
+                    //Se baja al sub-árbol derecho
+                    if(tree->right != NULL){ from = tree; tree = tree->right; continue; }
+                    cout << " NULL ";
+                }
+
+                //Se cierra el contenido del nodo actual y se sube a su padre
+                cout << "]";
+                from = tree;
+                tree = tree->parent;
+            }
         }
 
         /*
@@ -248,22 +471,56 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
                 return;
             }
 
-            //Si el árbol no está vacío, se muestra primero el contenido del
-            //nodo actual.
-            //Se tabula una cantidad <level> de veces
-            cout << string(cont,'\t') << "Padre: " << tree->data << ".\n";
-
-            //Se introduce la sección para el contenido del sub-árbol izquierdo
-            //tabulando una cantidad <level> de veces
-            cout << string(cont,'\t') << "Hijo izquierdo:\n";
-            //Se muestra el contenido del sub-árbol izquierdo aumentando el nivel en 1
-            show_aux_verbose(tree->left,cont+1);
-
-            //Se introduce la sección para el contenido del sub-árbol derecho
-            //tabulando una cantidad <level> de veces
-            cout << string(cont,'\t') << "Hijo derecho:\n";
-            //Se muestra el contenido del sub-árbol derecho aumentando el nivel en 1
-            show_aux_verbose(tree->right,cont+1);
+            //El recorrido se realiza sin recursión, de la misma forma que en
+            //show_aux(), aumentando el nivel <cont> al bajar y disminuyéndolo
+            //al subir
+            NodeT<type>* stop = tree->parent;
+            NodeT<type>* from = stop;
+
+            while(tree != stop){
+                if(from == tree->parent){
+                    //Se muestra primero el contenido del nodo actual.
+                    //Se tabula una cantidad <level> de veces
+                    cout << string(cont,'\t') << "Padre: " << tree->data << ".\n";
+
+                    //Se introduce la sección para el contenido del sub-árbol izquierdo
+                    //tabulando una cantidad <level> de veces
+                    cout << string(cont,'\t') << "Hijo izquierdo:\n";
+                    //Se muestra el contenido del sub-árbol izquierdo aumentando el nivel en 1
+                    if(tree->left != NULL){ from = tree; tree = tree->left; cont++; continue; }
+                    cout << string(cont+1,'\t') << "Hijo nulo.\n";
+                    from = NULL;
+                }
+                if(from == tree->left){
+                    //Se introduce la sección para el contenido del sub-árbol derecho
+                    //tabulando una cantidad <level> de veces
+                    cout << string(cont,'\t') << "Hijo derecho:\n";
+                    //Se muestra el contenido del sub-árbol derecho aumentando el nivel en 1
+                    if(tree->right != NULL){ from = tree; tree = tree->right; cont++; continue; }
+                    cout << string(cont+1,'\t') << "Hijo nulo.\n";
+                }
+
+                //Se sube al padre del nodo actual disminuyendo el nivel en 1
+                from = tree;
+                tree = tree->parent;
+                cont--;
+            }
+        }
+
+        /*
+            Función auxiliar que crea un nuevo nodo con el mismo contenido que el
+            nodo <node>, incluyendo su altura y cantidad de nodos, conectado al
+            padre <parent> y sin hijos.
+        */
+        NodeT<type>* copy_node(NodeT<type>* node, NodeT<type>* parent){
+            NodeT<type>* temp = (NodeT<type>*) createNode();
+            temp->data   = node->data;
+            temp->height = node->height;
+            temp->size   = node->size;
+            temp->parent = parent;
+            temp->left   = NULL;
+            temp->right  = NULL;
+            return temp;
         }
 
     public:
@@ -283,11 +540,13 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             <type>.
         */
         void destroy() override {
-            //Se envía el árbol binario de búsqueda local a la función
-            //auxiliar para liberación de memoria
-            destroy_aux(T);
+            //Si el asignador libera todos los nodos de una sola vez, no es
+            //necesario recorrer el árbol; de lo contrario se envía el árbol
+            //binario de búsqueda local a la función auxiliar para liberación
+            //de memoria
+            if(!alloc.release()) destroy_aux(T);
             //Se define el árbol como vacío
-            T == NULL;
+            T = NULL;
         }
 
         /*
@@ -304,16 +563,50 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             return search_aux(T,value);
         }
 
+        /*
+            Función que obtiene el menor dato del árbol binario de búsqueda
+            local que es mayor o igual a <value>, y lo almacena en <res>.
+
+            Se retorna false si no existe tal dato.
+        */
+        bool lower_bound(type value, type* res){
+            NodeT<type>* node = bound_aux(T, value, true);
+            if(node == NULL) return false;
+            *res = node->data;
+            return true;
+        }
+
+        /*
+            Función que obtiene el menor dato del árbol binario de búsqueda
+            local que es estrictamente mayor a <value>, y lo almacena en <res>.
+
+            Se retorna false si no existe tal dato.
+        */
+        bool upper_bound(type value, type* res){
+            NodeT<type>* node = bound_aux(T, value, false);
+            if(node == NULL) return false;
+            *res = node->data;
+            return true;
+        }
+
+        /*
+            Función que determina la cantidad de datos del árbol binario de
+            búsqueda local que se encuentran en el rango [<low>, <high>].
+        */
+        int count_range(type low, type high){
+            if(high < low) return 0;
+            return count_less(T, high, true) - count_less(T, low, false);
+        }
+
         /*
             Función que determina la cantidad de ocurrencias de un valor
             <value> de tipo <type> en un árbol binario de búsqueda de tipo
             <type>.
         */
         int count(type value) override {
-            //Se envía el árbol binario de búsqueda local y el dato cuyas
-            //ocurrencias se contarán a la función auxiliar para conteo de
-            //ocurrencias
-            return count_aux(T,value);
+            //Las ocurrencias de <value> son los datos menores o iguales a
+            //<value> que no son estrictamente menores
+            return count_less(T,value,true) - count_less(T,value,false);
         }
 
         /*
@@ -369,6 +662,26 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             //Para inicializar un árbol binario de búsqueda basta con
             //que el puntero al inicio del árbol apunte a NULL
             T = NULL;
+            //Por defecto el árbol no se balancea
+            balanced = false;
+        }
+
+        /*
+            Función para inicializar el árbol binario de búsqueda
+            de tipo <type>, indicando con <balanced> si debe mantenerse
+            balanceado (AVL).
+        */
+        void create(bool balanced){
+            create();
+            this->balanced = balanced;
+        }
+
+        /*
+            Función que indica si el árbol binario de búsqueda local
+            se mantiene balanceado.
+        */
+        bool is_balanced(){
+            return balanced;
         }
 
         /*
@@ -385,6 +698,9 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
             //hijos en NULL
             temp->left   = NULL;
             temp->right  = NULL;
+            //Una hoja tiene altura 1, y su sub-árbol tiene un solo nodo
+            temp->height = 1;
+            temp->size   = 1;
 
             //Se verifica si el árbol se encuentra actualmente vacío
             if(T == NULL){
@@ -400,6 +716,42 @@ class DST: public dynamicDS<type>,public insertable<type>,public measurable {
                 insert_aux(T,temp);
         }
 
+        /*
+            Función que copia en el árbol binario de búsqueda local, que se
+            asume vacío, el árbol <tree>, nodo por nodo y con su misma forma.
+
+            La copia toma tiempo lineal, a diferencia de insertar los datos uno
+            por uno, y se realiza sin recursión: se avanza en Pre-Order por el
+            árbol original y por la copia a la vez, bajando a cada hijo que aún
+            no se ha copiado y subiendo por los padres cuando no queda ninguno.
+        */
+        void copy(NodeT<type>* tree){
+            if(tree == NULL) return;
+
+            //Se copia la raíz
+            T = copy_node(tree, NULL);
+
+            NodeT<type>* O = tree;  //Nodo actual del árbol original
+            NodeT<type>* C = T;     //Nodo correspondiente en la copia
+
+            while(true){
+                if(O->left != NULL && C->left == NULL){
+                    //Se copia el hijo izquierdo y se baja a él
+                    C->left = copy_node(O->left, C);
+                    O = O->left; C = C->left;
+                }else if(O->right != NULL && C->right == NULL){
+                    //Se copia el hijo derecho y se baja a él
+                    C->right = copy_node(O->right, C);
+                    O = O->right; C = C->right;
+                }else{
+                    //El sub-árbol actual ya fue copiado por completo, se sube
+                    //al padre a menos que se haya regresado a la raíz
+                    if(O == tree) break;
+                    O = O->parent; C = C->parent;
+                }
+            }
+        }
+
         /*
             Función que retorna la altura del árbol binario de búsqueda
             local de tipo <type>.
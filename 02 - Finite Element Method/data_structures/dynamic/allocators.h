@@ -0,0 +1,164 @@
+/*
+    Asignadores de memoria para los nodos de las estructuras de datos
+    dinámicas.
+
+    Cada estructura dinámica (DSSL, DSDL, DST y DSG) recibe como segundo
+    "meta-parámetro" la clase del asignador a utilizar, y mantiene una
+    instancia propia del mismo. Todo asignador ofrece:
+        - allocate(bytes), que retorna espacio para un nodo de <bytes> bytes.
+        - deallocate(p), que devuelve el nodo <p> al asignador.
+        - release(), que se invoca al destruir la estructura. Retorna true si
+          libera de una sola vez todos los nodos entregados, en cuyo caso la
+          estructura no necesita recorrerse para liberarlos uno por uno.
+
+    Se proveen dos asignadores:
+        - MallocAllocator, el asignador por defecto, que reserva y libera cada
+          nodo por separado con malloc y free.
+        - PoolAllocator, que reserva los nodos en bloques contiguos y recicla
+          los nodos devueltos mediante una lista de nodos libres.
+
+    SDDS crea y manipula siempre las variantes con el asignador por defecto,
+    por lo que las variantes con PoolAllocator se utilizan directamente a
+    través de su clase concreta, por ejemplo DSSL<int, PoolAllocator>.
+*/
+
+/*
+    Asignador por defecto: cada nodo se reserva con malloc y se libera
+    con free.
+*/
+class MallocAllocator{
+    public:
+        void* allocate(size_t bytes){
+            //Se registra la reserva para las mediciones de desempeño
+            Perf::count_allocation(bytes);
+            return malloc(bytes);
+        }
+
+        void deallocate(void* p){
+            free(p);
+        }
+
+        bool release(){
+            //Los nodos se liberan uno por uno, por lo que la estructura
+            //debe recorrerse
+            return false;
+        }
+};
+
+/*
+    Asignador por bloques.
+
+    Los nodos se toman de bloques contiguos reservados con malloc. El primer
+    bloque tiene capacidad para POOL_FIRST_BLOCK nodos, y cada bloque nuevo
+    duplica la capacidad del anterior hasta POOL_MAX_BLOCK nodos, de modo que
+    las estructuras pequeñas no desperdician memoria y las grandes realizan
+    pocas reservas.
+
+    Los nodos devueltos con deallocate() se colocan en una lista de nodos
+    libres, enlazada a través del propio espacio del nodo, y se reutilizan
+    en las siguientes reservas.
+
+    Al destruir la estructura, release() libera todos los bloques de una sola
+    vez.
+
+    Se asume que todos los nodos solicitados a un mismo asignador son del
+    mismo tamaño, lo cual se cumple ya que cada estructura utiliza un único
+    tipo de nodo.
+*/
+class PoolAllocator{
+    private:
+        //Capacidad, en nodos, del primer bloque y del bloque más grande
+        inline static const int POOL_FIRST_BLOCK = 64;
+        inline static const int POOL_MAX_BLOCK = 65536;
+
+        /*
+            Cada bloque inicia con una cabecera que lo enlaza al bloque
+            reservado anteriormente, para poder liberarlos todos al final.
+            La cabecera ocupa el tamaño de un max_align_t para que los nodos
+            que le siguen queden correctamente alineados.
+        */
+        union Block{
+            Block* next;
+            max_align_t align;
+        };
+
+        //Lista de nodos libres, enlazados a través de su propio espacio
+        struct FreeNode{
+            FreeNode* next;
+        };
+
+        Block* blocks = NULL;       //Último bloque reservado
+        FreeNode* free_list = NULL; //Nodos devueltos disponibles
+        char* cursor = NULL;        //Siguiente nodo sin usar del último bloque
+        char* end = NULL;           //Final del último bloque
+        size_t node_size = 0;       //Tamaño de cada nodo, alineado
+        int capacity = 0;           //Capacidad del último bloque
+
+        /*
+            Función que reserva un nuevo bloque, con el doble de capacidad
+            que el anterior.
+        */
+        void grow(){
+            capacity = (capacity == 0) ? POOL_FIRST_BLOCK : min(2*capacity, POOL_MAX_BLOCK);
+
+            size_t bytes = sizeof(Block) + node_size*capacity;
+            //Se registra la reserva para las mediciones de desempeño,
+            //contando una sola reserva por bloque
+            Perf::count_allocation(bytes);
+            Block* b = (Block*) malloc(bytes);
+
+            b->next = blocks;
+            blocks = b;
+            cursor = (char*) (b + 1);
+            end = cursor + node_size*capacity;
+        }
+
+    public:
+        void* allocate(size_t bytes){
+            //En la primera reserva se fija el tamaño de los nodos, de modo que
+            //puedan alojar el enlace de la lista de nodos libres y mantengan
+            //la alineación requerida
+            if(node_size == 0){
+                size_t a = alignof(max_align_t);
+                node_size = max(bytes, sizeof(FreeNode));
+                node_size = (node_size + a - 1)/a*a;
+            }
+
+            //Se reutiliza primero un nodo devuelto, si lo hay
+            if(free_list != NULL){
+                FreeNode* node = free_list;
+                free_list = free_list->next;
+                return node;
+            }
+
+            //De lo contrario se toma el siguiente nodo del último bloque,
+            //reservando uno nuevo si se ha llenado
+            if(cursor == end) grow();
+            void* node = cursor;
+            cursor += node_size;
+            return node;
+        }
+
+        void deallocate(void* p){
+            //El nodo se coloca al inicio de la lista de nodos libres
+            FreeNode* node = (FreeNode*) p;
+            node->next = free_list;
+            free_list = node;
+        }
+
+        bool release(){
+            //Se liberan todos los bloques, y con ellos todos los nodos
+            while(blocks != NULL){
+                Block* b = blocks;
+                blocks = blocks->next;
+                free(b);
+            }
+
+            //El asignador queda listo para volver a utilizarse
+            free_list = NULL;
+            cursor = end = NULL;
+            capacity = 0;
+
+            return true;
+        }
+};
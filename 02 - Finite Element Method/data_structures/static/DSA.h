@@ -154,6 +154,8 @@ class DSA: public staticDS_1D<T>,public measurable,public positionable<T>,public
             /*sizeof(T)*size para generar tantos espacios
               como los indicados por el tamaño del arreglo.*/
             array = (T*) malloc(sizeof(T)*n);
+            //Se registra la reserva para las mediciones de desempeño
+            Perf::count_allocation(sizeof(T)*n);
         }
 
         /*
@@ -195,6 +197,7 @@ class DSA: public staticDS_1D<T>,public measurable,public positionable<T>,public
             //Se crea un nuevo arreglo de datos de tipo <T>
             //del mismo tamaño del original.
             T* array2 = (T*) malloc(sizeof(T)*size);
+            Perf::count_allocation(sizeof(T)*size);
 
             //Se recorre el arreglo original en reversa desde
             //la última posición.
@@ -41,10 +41,20 @@ class DSM: public staticDS_2D<T> {
         Los otros atributos privados locales son el número de filas <nrows>
         y el número de columnas <ncols> de la matriz, como datos acompañantes
         para controlar procesos de recorrido.
+
+        Por último, <columns> es NULL en una matriz, y solo se utiliza en las
+        vistas de matriz (ver DSMV.h), que extienden a DSM: en ellas, cada
+        puntero de <matrix> apunta a una fila de la matriz observada, y
+        <columns> contiene los índices, en dicha fila, de las columnas de la
+        vista. Así, una vista se indexa con las mismas funciones insert() y
+        extract() que una matriz.
     */
     private:
         T** matrix;
         int nrows, ncols;
+        int* columns;
+
+        template <typename> friend class DSMV;
 
     //Se procede a la implementación como tal de los métodos de la interfaz
     //override indica la respectiva sobreescritura de cada método
@@ -186,6 +196,7 @@ class DSM: public staticDS_2D<T> {
             //de columnas de la matriz
             nrows = dim.n;
             ncols = dim.m;
+            columns = NULL;
 
             //Se construye primero el arreglo principal:
 
@@ -208,6 +219,10 @@ class DSM: public staticDS_2D<T> {
                 //sizeof(type)*ncols para generar tantos espacios
                 //como los indicados por el número de columnas de la matriz.
                 *(matrix+i) = (T*) malloc(sizeof(T)*ncols);
+
+            //Se registran las reservas para las mediciones de desempeño:
+            //el arreglo principal y una reserva por cada fila
+            Perf::count_allocation(sizeof(T*)*nrows + sizeof(T)*ncols*nrows, nrows+1);
         }
 
         /*
@@ -237,8 +252,9 @@ class DSM: public staticDS_2D<T> {
         */
         void insert(Data pos, T value) override {
             //Se extraen la fila y la columna de <pos> y se usan para indexar
-            //la matriz
-            matrix[pos.n][pos.m] = value;
+            //la matriz, traduciendo la columna en el caso de una vista
+            if(columns == NULL) matrix[pos.n][pos.m] = value;
+            else matrix[pos.n][columns[pos.m]] = value;
         }
 
         /*
@@ -252,7 +268,8 @@ class DSM: public staticDS_2D<T> {
         */
         T extract(Data pos) override {
             //Se extraen la fila y la columna de <pos> y se usan para indexar
-            //la matriz
-            return matrix[pos.n][pos.m];
+            //la matriz, traduciendo la columna en el caso de una vista
+            if(columns == NULL) return matrix[pos.n][pos.m];
+            return matrix[pos.n][columns[pos.m]];
         }
 };
@@ -0,0 +1,150 @@
+/*
+    Implementación para una vista de matriz, es decir, una matriz que no
+    almacena datos propios, sino que observa un subconjunto de las filas y
+    de las columnas de una matriz DSM ya existente.
+
+    La vista se define mediante dos conjuntos de índices: las filas de la
+    matriz observada que conforman la vista, en orden, y sus columnas. La
+    celda (i,j) de la vista corresponde entonces a la celda ( rows[i],
+    cols[j] ) de la matriz observada:
+
+                    Matriz observada        rows = { 0, 2 }
+                    [ a  b  c ]             cols = { 1, 2 }
+                    [ d  e  f ]   =====>
+                    [ g  h  i ]             Vista:  [ b  c ]
+                                                    [ h  i ]
+
+    De este modo, seleccionar un bloque o un menor de una matriz cuesta
+    únicamente la memoria de los índices, del orden de filas + columnas, en
+    lugar de copiar todas sus celdas. Las inserciones en la vista modifican
+    directamente la matriz observada.
+
+    Se define la implementación como independiente del tipo de
+    dato a almacenar mediante el uso de template.
+*/
+template <typename T>
+/*
+    La vista hereda de DSM, por lo que es una matriz en todo sentido: tiene
+    categoría MATRIX y cualquier función de SDDS o de Math que recibe una
+    matriz la acepta directamente.
+
+    De DSM se reutilizan sus atributos: el arreglo principal <matrix> de la
+    vista contiene los punteros a las filas observadas, en el orden de la
+    vista, y <columns> los índices de las columnas observadas, por lo que la
+    vista no sobreescribe insert() ni extract(), y cada acceso a una celda
+    requiere únicamente un índice adicional respecto a una matriz.
+*/
+class DSMV: public DSM<T> {
+    /*
+        Como atributos privados locales se manejan <base>, la estructura DS a
+        partir de la cual se construyó la vista, que puede ser una matriz o a
+        su vez otra vista, y <owner>, que indica si la vista es responsable de
+        liberar <base> al ser liberada ella misma.
+    */
+    private:
+        DS<T>* base;
+        bool owner;
+
+        /*
+            Función auxiliar que retorna la celda (i,j) de la vista.
+        */
+        T cell(int i, int j){
+            return this->matrix[i][this->columns[j]];
+        }
+
+    //Se sobreescriben los métodos de DSM que recorren la matriz completa
+    public:
+        /*
+            Función para liberar el espacio en memoria utilizado por la vista,
+            es decir, sus índices. La matriz base solo se libera si la vista es
+            su propietaria.
+        */
+        void destroy() override {
+            free(this->matrix);
+            free(this->columns);
+            if(owner) base->destroy();
+        }
+
+        /*
+            Función que determina si un valor <value> de tipo <T>
+            se encuentra o no dentro de la vista.
+        */
+        bool search(T value) override {
+            for(int i = 0; i < this->nrows*this->ncols; i++)
+                if(cell(i/this->ncols, i%this->ncols) == value) return true;
+            return false;
+        }
+
+        /*
+            Función que determina la cantidad de ocurrencias de un valor
+            <value> de tipo <T> en la vista.
+        */
+        int count(T value) override {
+            int cont = 0;
+            for(int i = 0; i < this->nrows*this->ncols; i++)
+                if(cell(i/this->ncols, i%this->ncols) == value) cont++;
+            return cont;
+        }
+
+        /*
+            Función que muestra el contenido de la vista, con el mismo formato
+            que una matriz DSM.
+        */
+        void show(bool verbose) override {
+            int nrows = this->nrows, ncols = this->ncols;
+            if(verbose)
+                for(int i = 0; i < nrows*ncols; i++)
+                    cout << "Element in cell [ " << i/ncols+1 << ", " << i%ncols+1 << " ] is: " << cell(i/ncols, i%ncols) << "\n";
+            else{
+                cout << "[\n";
+                for(int i = 0; i < nrows; i++){
+                    cout << "[ ";
+                    for(int j = 0; j < ncols-1; j++)
+                        cout << cell(i,j) << ", ";
+                    cout << cell(i,ncols-1) << " ]\n";
+                }
+                cout << "]\n";
+            }
+        }
+
+        /*
+            Función para crear el espacio en memoria de los índices de una vista
+            con <dim>.n filas y <dim>.m columnas: un puntero por fila y un índice
+            por columna. La vista queda sin matriz observada hasta que se invoque
+            observe().
+        */
+        void create(Data dim) override {
+            this->nrows = dim.n;
+            this->ncols = dim.m;
+            this->matrix = (T**) malloc(sizeof(T*)*dim.n);
+            this->columns = (int*) malloc(sizeof(int)*dim.m);
+            base = NULL;
+            owner = false;
+
+            //Se registran las reservas de los índices para las mediciones de desempeño
+            Perf::count_allocation(sizeof(T*)*dim.n + sizeof(int)*dim.m, 2);
+        }
+
+        /*
+            Procedimiento que define la matriz <original> como la base de la vista,
+            donde <rows> y <cols> contienen, en orden, los índices de las filas y
+            de las columnas de <original> que conforman la vista. Los índices se
+            copian, por lo que el llamador conserva la propiedad de sus arreglos.
+
+            Si <original> es a su vez una vista, los índices se componen con los de
+            ella, de modo que la nueva vista observa directamente la matriz DSM
+            original y cada extracción sigue siendo un único acceso.
+
+            Si <owns> es true, la vista se vuelve propietaria de <original>, y la
+            liberará al ser liberada ella misma.
+        */
+        void observe(DS<T>* original, int* rows, int* cols, bool owns){
+            DSM<T>* observed = (DSM<T>*) original;
+            for(int i = 0; i < this->nrows; i++)
+                this->matrix[i] = observed->matrix[rows[i]];
+            for(int j = 0; j < this->ncols; j++)
+                this->columns[j] = observed->columns == NULL ? cols[j] : observed->columns[cols[j]];
+            base = original;
+            owner = owns;
+        }
+};
@@ -81,7 +81,7 @@ class Element{
             SDDS<FEMNode*>::insert(nodes,index,node);
         }
         FEMNode* get_Node(int index){
-            FEMNode* res;
+            FEMNode* res = NULL;
             SDDS<FEMNode*>::extract(nodes,index,&res);
             return res;
         }
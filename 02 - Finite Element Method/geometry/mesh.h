@@ -10,6 +10,8 @@ enum parameter {DENSITY,SPECIFIC_HEAT,THERMAL_CONDUCTIVITY,HEAT_SOURCE,DIRICHLET
 enum quantity  {NUM_NODES,NUM_ELEMENTS,NUM_DIRICHLET_BCs,NUM_NEUMANN_BCs};
 //Enumeración para identificar el escenario de trabajo con condiciones de contorno
 enum condition {DIRICHLET,NEUMANN};
+//Enumeración para identificar el tipo de análisis: evolución en el tiempo, o directamente el estado estacionario
+enum analysis  {TRANSIENT,STEADY};
 
 /*
     Clase utilizada para representar una malla bidimensional de triángulos.
@@ -49,6 +51,11 @@ class Mesh{
             - Una estructura para definir un arreglo para almacenar todos los nodos
               de la malla que tendrán asignada una condición de contorno de Neumann.
               Su longitud la definirá una de las cantidades recibidas en la entrada.
+            - Una estructura para definir un arreglo con la numeración interna de
+              los nodos, en caso de que hayan sido renumerados: la posición i
+              contiene el ID interno del nodo cuyo ID en GiD es i+1. Mientras los
+              nodos no sean renumerados, es NULL.
+            - El tipo de análisis solicitado, transitorio por defecto.
         */
         DS<float>* parameters;
         DS<int>* quantities;
@@ -56,6 +63,88 @@ class Mesh{
         DS<Element*>* elements;
         DS<FEMNode*>* dirichlet_conditions;
         DS<FEMNode*>* neumann_conditions;
+        DS<int>* numbering;
+        analysis type;
+
+        /*
+            Función de comparación de dos claves enteras largas, en el formato
+            que requieren qsort() y bsearch().
+        */
+        static int compare_keys(const void* p, const void* q){
+            long a = *(const long*) p, b = *(const long*) q;
+            return (a > b) - (a < b);
+        }
+
+        /*
+            Función que recorre en anchura el grafo de los elementos, en el que dos
+            elementos son vecinos si comparten algún nodo, a partir del elemento en la
+            posición <seed>. Se visitan únicamente los elementos con <mark> igual a
+            <from>, cambiándolo a <to>, y se colocan en <order> en el orden de visita.
+
+            <start> e <incident> describen los elementos de cada nodo: los del nodo con
+            ID i+1 se encuentran en las posiciones start[i] a start[i+1]-1 de <incident>.
+
+            Si algún elemento del subconjunto no es alcanzable desde <seed>, el recorrido
+            continúa desde el siguiente elemento no visitado de <list>, de modo que al
+            terminar <order> contiene los <count> elementos de <list>.
+        */
+        void order_elements(int seed, int* list, int count, int from, int to, int* start, int* incident, int* mark, int* order){
+            int head = 0, tail = 0, next = 0;
+            mark[seed] = to;
+            order[tail++] = seed;
+            while(tail < count){
+                if(head == tail){
+                    while(mark[list[next]] != from) next++;
+                    mark[list[next]] = to;
+                    order[tail++] = list[next];
+                }
+                Element* elem = get_element_at(order[head++]);
+                for(int a = 0; a < 3; a++){
+                    int i = elem->get_Node(a)->get_ID() - 1;
+                    for(int k = start[i]; k < start[i+1]; k++)
+                        if(mark[incident[k]] == from){
+                            mark[incident[k]] = to;
+                            order[tail++] = incident[k];
+                        }
+                }
+            }
+        }
+
+        /*
+            Procedimiento que divide los <count> elementos de <list> en <nparts>
+            subdominios, numerados a partir de <first>, colocando el subdominio de
+            cada elemento en <part>.
+
+            El subconjunto se recorre en anchura dos veces: la primera desde un
+            elemento cualquiera, para encontrar un elemento en su periferia (el último
+            visitado), y la segunda desde ese elemento. Los elementos quedan ordenados
+            por su distancia a la periferia, y se dividen en dos mitades contiguas de
+            ese orden, proporcionales a la cantidad de subdominios de cada mitad, que a
+            su vez se dividen de la misma forma hasta llegar a un subdominio.
+
+            <tag> es un contador que se incrementa para marcar en <mark> los elementos
+            de cada subconjunto sin interferir con los demás.
+
+            Un subconjunto vacío no tiene elementos que asignar, por lo que se ignora.
+        */
+        void bisect(int* list, int count, int first, int nparts, int* part, int* start, int* incident, int* mark, int* order, int* tag){
+            if(count == 0) return;
+            if(nparts == 1){
+                for(int k = 0; k < count; k++) part[list[k]] = first;
+                return;
+            }
+
+            int members = ++(*tag), visited = ++(*tag), sorted = ++(*tag);
+            for(int k = 0; k < count; k++) mark[list[k]] = members;
+            order_elements(list[0], list, count, members, visited, start, incident, mark, order);
+            order_elements(order[count-1], list, count, visited, sorted, start, incident, mark, order);
+            for(int k = 0; k < count; k++) list[k] = order[k];
+
+            int left = nparts/2;
+            int half = (int) ((long) count*left/nparts);
+            bisect(list, half, first, left, part, start, incident, mark, order, tag);
+            bisect(list + half, count - half, first + left, nparts - left, part, start, incident, mark, order, tag);
+        }
 
     public:
         /********** Constructor ************/
@@ -67,20 +156,33 @@ class Mesh{
         Mesh(){
             SDDS<float>::create(&parameters,10,ARRAY);
             SDDS<int>::create(&quantities,4,ARRAY);
+            numbering = NULL;
+            type = TRANSIENT;
         }
 
         /********** Destructor ************/
         /*
-            El destructor libera el espacio en memoria asignado para todas las
-            estructuras de datos de los atributos privados.
+            El destructor libera el espacio en memoria asignado para todos los
+            nodos y elementos de la malla, y para todas las estructuras de datos
+            de los atributos privados.
+
+            Los arreglos de condiciones de contorno contienen nodos que ya se
+            encuentran en el arreglo de nodos, por lo que no se liberan dos veces.
         */
         ~Mesh(){
+            int n;
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&n);
+            for(int i = 0; i < n; i++) delete get_element_at(i);
+            SDDS<int>::extract(quantities,NUM_NODES,&n);
+            for(int i = 0; i < n; i++) delete get_node_at(i);
+
             SDDS<float>::destroy(parameters);
             SDDS<int>::destroy(quantities);
             SDDS<FEMNode*>::destroy(nodes);
             SDDS<Element*>::destroy(elements);
             SDDS<FEMNode*>::destroy(dirichlet_conditions);
             SDDS<FEMNode*>::destroy(neumann_conditions);
+            if(numbering != NULL) SDDS<int>::destroy(numbering);
         }
 
         /********** Operaciones sobre la malla y sus datos ************/
@@ -124,6 +226,14 @@ class Mesh{
             SDDS<float>::insert(parameters,INITIAL_TIME,t_0);
             SDDS<float>::insert(parameters,FINAL_TIME,t_f);
         }
+        /*
+            Función para colocar un parámetro específico en el arreglo de
+            parámetros, indicando su posición con un dato de enumeración
+            <parameter>.
+        */
+        void set_parameter_at(int indicator, float value){
+            SDDS<float>::insert(parameters,indicator,value);
+        }
         /*
             Función para extraer un parámetro específico del arreglo de
             parámetros.
@@ -165,6 +275,17 @@ class Mesh{
             return qty;
         }
 
+        /*
+            Funciones para colocar y consultar el tipo de análisis del problema,
+            haciendo uso de la enumeración <analysis>.
+        */
+        void set_analysis(analysis a){
+            type = a;
+        }
+        analysis get_analysis(){
+            return type;
+        }
+
         /*
             Función para ingresar al arreglo de nodos de la malla
             un nuevo nodo en una posición específica.
@@ -195,6 +316,15 @@ class Mesh{
             //Si no se encontró, se retorna un puntero nulo
             return NULL;
         }
+        /*
+            Función que retorna el nodo ubicado en la posición <pos>
+            del arreglo de nodos de la malla, sin importar su ID.
+        */
+        FEMNode* get_node_at(int pos){
+            FEMNode* node;
+            SDDS<FEMNode*>::extract(nodes,pos,&node);
+            return node;
+        }
 
         /*
             Función para ingresar al arreglo de elementos de la malla
@@ -217,7 +347,7 @@ class Mesh{
             SDDS<int>::extract(quantities,NUM_ELEMENTS,&n);
             //Se recorre el arreglo de elementos
             for(int i = 0; i < n; i++){
-                Element* elem;
+                Element* elem = NULL;
                 //Se extrae el elemento actual
                 SDDS<Element*>::extract(elements,i,&elem);
                 //Si el elemento actual tiene un ID igual al recibido, se retorna
@@ -226,6 +356,15 @@ class Mesh{
             //Si no se encontró, se retorna un puntero nulo
             return NULL;
         }
+        /*
+            Función que retorna el elemento ubicado en la posición <pos>
+            del arreglo de elementos de la malla, sin importar su ID.
+        */
+        Element* get_element_at(int pos){
+            Element* elem = NULL;
+            SDDS<Element*>::extract(elements,pos,&elem);
+            return elem;
+        }
 
         /*
             Función para ingresar al arreglo de condiciones de Dirichlet
@@ -259,6 +398,10 @@ class Mesh{
             <indices> es el arreglo a llenar, mientras que <mode> es
             un dato de enumeración <condition> que indica el tipo de
             condición de contorno de interés.
+
+            <indices> también puede ser un árbol binario de búsqueda,
+            en cuyo caso los identificadores se insertan en él para
+            consultar luego la pertenencia en tiempo logarítmico.
         */
         void get_condition_indices(DS<int>* indices, condition mode){
             int n;
@@ -291,8 +434,452 @@ class Mesh{
             for(int i = 0; i < n; i++){
                 //Se extrae el nodo actual
                 SDDS<FEMNode*>::extract(conditions,i,&node);
-                //Se coloca el ID del nodo actual en el arreglo de enteros
-                SDDS<int>::insert(indices,i,node->get_ID());
+                //Se coloca el ID del nodo actual en el arreglo de enteros,
+                //o se inserta en el árbol
+                if(indices->getCategory() == BINARY_SEARCH_TREE)
+                    SDDS<int>::insert(indices,node->get_ID());
+                else
+                    SDDS<int>::insert(indices,i,node->get_ID());
+            }
+        }
+
+        /*
+            Función que construye el grafo de conectividad de los nodos de la
+            malla: cada nodo de la malla es un nodo del grafo, con su ID como
+            identificador, y dos nodos están conectados si comparten algún
+            elemento.
+
+            Se recibe <graph> por referencia para instanciar en él el grafo.
+        */
+        void build_node_graph(DS<FEMNode*>** graph){
+            int nnodes, nelems;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+
+            SDDS<FEMNode*>::create(graph, GRAPH);
+            for(int i = 0; i < nnodes; i++){
+                FEMNode* node = get_node_at(i);
+                SDDS<FEMNode*>::insert(*graph, node->get_ID(), node);
+            }
+
+            //Se prepara una lista de IDs de nodos vecinos para cada nodo,
+            //en la posición de su ID menos 1
+            DS<int>** neighbors = (DS<int>**) malloc(sizeof(DS<int>*)*nnodes);
+            for(int i = 0; i < nnodes; i++)
+                SDDS<int>::create(&neighbors[i], SINGLE_LINKED_LIST);
+
+            //Cada par de nodos de un elemento se registra como vecinos en
+            //ambos sentidos, omitiendo los pares ya registrados por otro elemento
+            for(int e = 0; e < nelems; e++){
+                Element* elem = get_element_at(e);
+                for(int a = 0; a < 3; a++)
+                    for(int b = 0; b < 3; b++){
+                        if(a == b) continue;
+                        int ida = elem->get_Node(a)->get_ID(), idb = elem->get_Node(b)->get_ID();
+
+                        bool found;
+                        SDDS<int>::search(neighbors[ida-1], idb, &found);
+                        if(!found) SDDS<int>::push_back(neighbors[ida-1], idb);
+                    }
+            }
+
+            //Se definen las conexiones del grafo y se liberan las listas
+            for(int i = 0; i < nnodes; i++){
+                SDDS<FEMNode*>::define_connections(*graph, get_node_at(i)->get_ID(), neighbors[i]);
+                SDDS<int>::destroy(neighbors[i]);
+                delete neighbors[i];
+            }
+            free(neighbors);
+        }
+
+        /*
+            Función que renumera los nodos de la malla con el algoritmo Reverse
+            Cuthill-McKee sobre su grafo de conectividad, de modo que los nodos
+            que comparten un elemento reciban IDs cercanos. Así se reduce el
+            ancho de banda de las matrices globales, cuyas filas y columnas
+            corresponden a los IDs de los nodos.
+
+            Los nodos cambian su ID por el nuevo, por lo que todo el proceso
+            posterior (ensamblaje, condiciones de contorno) trabaja con la
+            numeración interna. La relación con los IDs originales de GiD se
+            conserva en el arreglo de numeración, que se utiliza al escribir
+            los resultados.
+
+            Se asume que los IDs de los nodos son los números de 1 a n.
+        */
+        void renumber_nodes(){
+            int nnodes;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+
+            DS<FEMNode*>* graph;
+            build_node_graph(&graph);
+            DSG<FEMNode*>* D = (DSG<FEMNode*>*) graph;
+
+            int* order = (int*) malloc(sizeof(int)*nnodes);
+            D->reverse_cuthill_mckee(order);
+
+            //Primero se registra la nueva numeración según los IDs actuales,
+            //que en una primera renumeración son los de GiD, y luego se asignan
+            //los nuevos IDs
+            DS<int>* renumbering;
+            SDDS<int>::create(&renumbering, nnodes, ARRAY);
+            for(int k = 0; k < nnodes; k++)
+                SDDS<int>::insert(renumbering, D->vertex(order[k])->data->get_ID() - 1, k + 1);
+            for(int k = 0; k < nnodes; k++)
+                D->vertex(order[k])->data->set_ID(k + 1);
+
+            //Si los nodos ya habían sido renumerados, se componen ambas
+            //numeraciones para seguir refiriendo a los IDs de GiD
+            if(numbering == NULL) numbering = renumbering;
+            else{
+                for(int i = 0; i < nnodes; i++){
+                    int current, renumbered;
+                    SDDS<int>::extract(numbering, i, &current);
+                    SDDS<int>::extract(renumbering, current - 1, &renumbered);
+                    SDDS<int>::insert(numbering, i, renumbered);
+                }
+                SDDS<int>::destroy(renumbering);
+            }
+
+            free(order);
+            SDDS<FEMNode*>::destroy(graph);
+            delete graph;
+        }
+
+        /*
+            Función que retorna el arreglo de numeración interna de los nodos,
+            o NULL si los nodos no han sido renumerados.
+        */
+        DS<int>* get_numbering(){
+            return numbering;
+        }
+
+        /*
+            Función que construye una nueva malla, más fina, dividiendo cada triángulo
+            de la malla en cuatro triángulos semejantes, unidos por los puntos medios
+            de sus lados:
+
+                            n2                              n2
+                            /\                              /\
+                           /  \                            /  \
+                          /    \                      m20 /____\ m12
+                         /      \          ==>           /\    /\
+                        /        \                      /  \  /  \
+                       /__________\                    /____\/____\
+                     n0            n1                n0     m01    n1
+
+            Los nodos de la malla original conservan su posición y su ID en la nueva
+            malla, y a continuación se agrega un nodo por cada lado, en el punto medio
+            del mismo. Los parámetros y el tipo de análisis se copian de la malla
+            original.
+
+            Un nodo nuevo recibe una condición de contorno cuando su lado pertenece a
+            un único elemento, es decir, se encuentra sobre el contorno, y sus dos
+            extremos tienen esa misma condición. Las condiciones de Neumann se aplican
+            como valores nodales (ver FEM::built_T_Neumann()), es decir, como el flujo
+            que entra por la porción del contorno que corresponde a cada nodo; al
+            dividir los lados del contorno esa porción se reduce a la mitad, por lo
+            que el valor de Neumann de la nueva malla es la mitad del original, y el
+            flujo total se conserva.
+
+            Se coloca en <parents> un arreglo nuevo con los IDs de los dos extremos del
+            lado de cada nodo nuevo: los del nodo en la posición n+k de la nueva malla
+            se encuentran en las posiciones 2k y 2k+1, donde n es la cantidad de nodos
+            de la malla original.
+
+            Se asume que los IDs de los nodos son los números de 1 a n.
+        */
+        Mesh* refine(int** parents){
+            int nnodes, nelems, ndirichlet, nneumann;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+            SDDS<int>::extract(quantities,NUM_DIRICHLET_BCs,&ndirichlet);
+            SDDS<int>::extract(quantities,NUM_NEUMANN_BCs,&nneumann);
+
+            //Se identifica cada lado de cada elemento con la clave menor*n + mayor, a partir de
+            //los IDs de sus extremos, y se ordenan las claves para agrupar los lados repetidos
+            long* keys = (long*) malloc(sizeof(long)*3*nelems);
+            for(int e = 0; e < nelems; e++){
+                Element* elem = get_element_at(e);
+                for(int s = 0; s < 3; s++){
+                    long a = elem->get_Node(s)->get_ID() - 1, b = elem->get_Node((s+1)%3)->get_ID() - 1;
+                    keys[3*e+s] = min(a,b)*nnodes + max(a,b);
+                }
+            }
+            long* sorted = (long*) malloc(sizeof(long)*3*nelems);
+            for(int k = 0; k < 3*nelems; k++) sorted[k] = keys[k];
+            qsort(sorted, 3*nelems, sizeof(long), compare_keys);
+
+            //Se conservan las claves distintas, junto con la cantidad de elementos de cada lado
+            int nedges = 0;
+            int* uses = (int*) malloc(sizeof(int)*3*nelems);
+            for(int k = 0; k < 3*nelems; k++){
+                if(nedges > 0 && sorted[nedges-1] == sorted[k]) uses[nedges-1]++;
+                else{ sorted[nedges] = sorted[k]; uses[nedges] = 1; nedges++; }
+            }
+
+            //Se marcan los nodos con cada condición de contorno, según su ID
+            bool* is_dirichlet = (bool*) calloc(nnodes, sizeof(bool));
+            bool* is_neumann = (bool*) calloc(nnodes, sizeof(bool));
+            for(int i = 0; i < ndirichlet; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(dirichlet_conditions,i,&node);
+                is_dirichlet[node->get_ID() - 1] = true;
+            }
+            for(int i = 0; i < nneumann; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(neumann_conditions,i,&node);
+                is_neumann[node->get_ID() - 1] = true;
+            }
+
+            //Se cuentan las condiciones de los nodos nuevos
+            int new_dirichlet = ndirichlet, new_neumann = nneumann;
+            *parents = (int*) malloc(sizeof(int)*2*nedges);
+            for(int k = 0; k < nedges; k++){
+                int a = sorted[k]/nnodes, b = sorted[k]%nnodes;
+                (*parents)[2*k] = a+1; (*parents)[2*k+1] = b+1;
+                if(uses[k] == 1 && is_dirichlet[a] && is_dirichlet[b]) new_dirichlet++;
+                if(uses[k] == 1 && is_neumann[a] && is_neumann[b]) new_neumann++;
+            }
+
+            Mesh* fine = new Mesh();
+            for(int p = 0; p < 10; p++) fine->set_parameter_at(p, get_parameter((parameter) p));
+            fine->set_parameter_at(NEUMANN_VALUE, get_parameter(NEUMANN_VALUE)/2);
+            fine->set_quantities(nnodes + nedges, 4*nelems, new_dirichlet, new_neumann);
+            fine->init_geometry();
+            fine->set_analysis(type);
+
+            //Nodos de la malla original, en las mismas posiciones y con los mismos IDs.
+            //<position> indica la posición del nodo con cada ID
+            int* position = (int*) malloc(sizeof(int)*nnodes);
+            for(int i = 0; i < nnodes; i++){
+                FEMNode* node = get_node_at(i);
+                position[node->get_ID() - 1] = i;
+                Point* P = new Point();
+                P->set_x(node->get_Point()->get_x());
+                P->set_y(node->get_Point()->get_y());
+                fine->add_node(new FEMNode(node->get_ID(), P), i);
+            }
+            //Nodos nuevos, en el punto medio de cada lado
+            for(int k = 0; k < nedges; k++){
+                Point* A = fine->get_node_at(position[(*parents)[2*k] - 1])->get_Point();
+                Point* B = fine->get_node_at(position[(*parents)[2*k+1] - 1])->get_Point();
+                Point* P = new Point();
+                P->set_x((A->get_x() + B->get_x())/2);
+                P->set_y((A->get_y() + B->get_y())/2);
+                fine->add_node(new FEMNode(nnodes + k + 1, P), nnodes + k);
+            }
+
+            //Cuatro elementos nuevos por cada elemento original
+            for(int e = 0; e < nelems; e++){
+                Element* elem = get_element_at(e);
+                FEMNode* n[3];
+                FEMNode* m[3];      //m[s] es el punto medio del lado s, del nodo s al nodo s+1
+                for(int s = 0; s < 3; s++){
+                    n[s] = fine->get_node_at(position[elem->get_Node(s)->get_ID() - 1]);
+                    long* found = (long*) bsearch(&keys[3*e+s], sorted, nedges, sizeof(long), compare_keys);
+                    m[s] = fine->get_node_at(nnodes + (int)(found - sorted));
+                }
+                fine->add_element(new Element(4*e+1, n[0], m[0], m[2]), 4*e);
+                fine->add_element(new Element(4*e+2, m[0], n[1], m[1]), 4*e+1);
+                fine->add_element(new Element(4*e+3, m[2], m[1], n[2]), 4*e+2);
+                fine->add_element(new Element(4*e+4, m[0], m[1], m[2]), 4*e+3);
+            }
+
+            //Condiciones de contorno: las de la malla original, seguidas de las de los nodos nuevos
+            int d = 0, q = 0;
+            for(int i = 0; i < nnodes; i++){
+                if(is_dirichlet[i]) fine->add_dirichlet_cond(fine->get_node_at(position[i]), d++);
+                if(is_neumann[i]) fine->add_neumann_cond(fine->get_node_at(position[i]), q++);
+            }
+            for(int k = 0; k < nedges; k++){
+                int a = (*parents)[2*k] - 1, b = (*parents)[2*k+1] - 1;
+                if(uses[k] == 1 && is_dirichlet[a] && is_dirichlet[b]) fine->add_dirichlet_cond(fine->get_node_at(nnodes + k), d++);
+                if(uses[k] == 1 && is_neumann[a] && is_neumann[b]) fine->add_neumann_cond(fine->get_node_at(nnodes + k), q++);
+            }
+
+            free(keys); free(sorted); free(uses); free(position);
+            free(is_dirichlet); free(is_neumann);
+            return fine;
+        }
+
+        /*
+            Función que divide los elementos de la malla en <nparts> subdominios de
+            tamaños similares, por bisección recursiva del grafo de los elementos (ver
+            bisect()), procurando que los subdominios compartan pocos nodos entre sí.
+            Cada mitad es un tramo contiguo del recorrido en anchura, por lo que los
+            subdominios suelen ser conexos, pero no se garantiza. Se retorna un arreglo
+            nuevo con el subdominio, de 0 a <nparts>-1, del elemento en cada posición.
+
+            Cada subdominio debe tener al menos un elemento, por lo que <nparts> no
+            puede ser mayor a la cantidad de elementos de la malla; en ese caso se
+            informa y se termina el programa.
+
+            Se asume que los IDs de los nodos son los números de 1 a n.
+        */
+        int* partition(int nparts){
+            int nnodes, nelems;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+
+            if(nparts > nelems){
+                cout << "The mesh has " << nelems << " elements and cannot be divided into " << nparts << " subdomains. :(\n";
+                exit(EXIT_FAILURE);
+            }
+
+            //Se listan los elementos de cada nodo, contándolos primero para ubicar
+            //el inicio de la lista de cada uno
+            int* start = (int*) calloc(nnodes+1, sizeof(int));
+            for(int e = 0; e < nelems; e++)
+                for(int a = 0; a < 3; a++) start[get_element_at(e)->get_Node(a)->get_ID()]++;
+            for(int i = 0; i < nnodes; i++) start[i+1] += start[i];
+            int* incident = (int*) malloc(sizeof(int)*3*nelems);
+            int* cursor = (int*) malloc(sizeof(int)*nnodes);
+            for(int i = 0; i < nnodes; i++) cursor[i] = start[i];
+            for(int e = 0; e < nelems; e++)
+                for(int a = 0; a < 3; a++) incident[cursor[get_element_at(e)->get_Node(a)->get_ID() - 1]++] = e;
+
+            int* part = (int*) malloc(sizeof(int)*nelems);
+            int* list = (int*) malloc(sizeof(int)*nelems);
+            int* mark = (int*) calloc(nelems, sizeof(int));
+            int* order = (int*) malloc(sizeof(int)*nelems);
+            for(int e = 0; e < nelems; e++) list[e] = e;
+            int tag = 0;
+            bisect(list, nelems, 0, nparts, part, start, incident, mark, order, &tag);
+
+            free(start); free(incident); free(cursor);
+            free(list); free(mark); free(order);
+            return part;
+        }
+
+        /*
+            Función que retorna un arreglo nuevo con el subdominio "dueño" del nodo
+            con ID i+1 en la posición i, para la división <part> de los elementos
+            obtenida con partition(). El dueño de un nodo es el menor de los
+            subdominios de sus elementos, de modo que cada nodo compartido por varios
+            subdominios tiene un único dueño.
+        */
+        int* node_owners(int* part){
+            int nnodes, nelems;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+
+            int* owner = (int*) malloc(sizeof(int)*nnodes);
+            for(int i = 0; i < nnodes; i++) owner[i] = -1;
+            for(int e = 0; e < nelems; e++)
+                for(int a = 0; a < 3; a++){
+                    int i = get_element_at(e)->get_Node(a)->get_ID() - 1;
+                    if(owner[i] < 0 || part[e] < owner[i]) owner[i] = part[e];
+                }
+            return owner;
+        }
+
+        /*
+            Función que construye una nueva malla con los elementos del subdominio <p>
+            de la división <part>, y únicamente los nodos de esos elementos, numerados
+            de 1 en adelante en el orden de sus IDs en la malla original. Se coloca en
+            <global_ids> un arreglo nuevo con el ID en la malla original del nodo en
+            cada posición de la nueva malla. Los parámetros y el tipo de análisis se
+            copian de la malla original.
+
+            Los nodos conservan sus condiciones de Dirichlet. Las condiciones de
+            Neumann, que se aplican como valores nodales, se asignan únicamente en el
+            subdominio dueño del nodo según <owner> (ver node_owners()), de modo que
+            la suma de los vectores b de todos los subdominios sea el vector b global.
+        */
+        Mesh* submesh(int* part, int* owner, int p, int** global_ids){
+            int nnodes, nelems, ndirichlet, nneumann;
+            SDDS<int>::extract(quantities,NUM_NODES,&nnodes);
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+            SDDS<int>::extract(quantities,NUM_DIRICHLET_BCs,&ndirichlet);
+            SDDS<int>::extract(quantities,NUM_NEUMANN_BCs,&nneumann);
+
+            //Se marcan los nodos de los elementos del subdominio, y se les asigna su
+            //ID en la nueva malla en el orden de sus IDs originales
+            int* local = (int*) calloc(nnodes, sizeof(int));
+            int sub_elems = 0, sub_nodes = 0;
+            for(int e = 0; e < nelems; e++){
+                if(part[e] != p) continue;
+                sub_elems++;
+                for(int a = 0; a < 3; a++) local[get_element_at(e)->get_Node(a)->get_ID() - 1] = 1;
+            }
+            *global_ids = (int*) malloc(sizeof(int)*nnodes);
+            for(int i = 0; i < nnodes; i++)
+                if(local[i]){
+                    (*global_ids)[sub_nodes] = i+1;
+                    local[i] = ++sub_nodes;
+                }
+
+            //Se cuentan las condiciones de contorno de los nodos del subdominio
+            int sub_dirichlet = 0, sub_neumann = 0;
+            for(int i = 0; i < ndirichlet; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(dirichlet_conditions,i,&node);
+                if(local[node->get_ID() - 1]) sub_dirichlet++;
+            }
+            for(int i = 0; i < nneumann; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(neumann_conditions,i,&node);
+                if(local[node->get_ID() - 1] && owner[node->get_ID() - 1] == p) sub_neumann++;
+            }
+
+            Mesh* sub = new Mesh();
+            for(int k = 0; k < 10; k++) sub->set_parameter_at(k, get_parameter((parameter) k));
+            sub->set_quantities(sub_nodes, sub_elems, sub_dirichlet, sub_neumann);
+            sub->init_geometry();
+            sub->set_analysis(type);
+
+            //Nodos del subdominio, en la posición de su nuevo ID menos 1
+            for(int i = 0; i < nnodes; i++){
+                FEMNode* node = get_node_at(i);
+                int ID = local[node->get_ID() - 1];
+                if(!ID) continue;
+                Point* P = new Point();
+                P->set_x(node->get_Point()->get_x());
+                P->set_y(node->get_Point()->get_y());
+                sub->add_node(new FEMNode(ID, P), ID - 1);
+            }
+
+            //Elementos del subdominio, con IDs de 1 en adelante
+            for(int e = 0, k = 0; e < nelems; e++){
+                if(part[e] != p) continue;
+                Element* elem = get_element_at(e);
+                FEMNode* n[3];
+                for(int a = 0; a < 3; a++) n[a] = sub->get_node_at(local[elem->get_Node(a)->get_ID() - 1] - 1);
+                sub->add_element(new Element(k+1, n[0], n[1], n[2]), k);
+                k++;
+            }
+
+            //Condiciones de contorno, en el mismo orden que en la malla original
+            for(int i = 0, d = 0; i < ndirichlet; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(dirichlet_conditions,i,&node);
+                if(local[node->get_ID() - 1]) sub->add_dirichlet_cond(sub->get_node_at(local[node->get_ID() - 1] - 1), d++);
+            }
+            for(int i = 0, q = 0; i < nneumann; i++){
+                FEMNode* node;
+                SDDS<FEMNode*>::extract(neumann_conditions,i,&node);
+                if(local[node->get_ID() - 1] && owner[node->get_ID() - 1] == p) sub->add_neumann_cond(sub->get_node_at(local[node->get_ID() - 1] - 1), q++);
+            }
+
+            free(local);
+            return sub;
+        }
+
+        /*
+            Función que retorna el ancho de banda de las matrices globales con
+            la numeración actual de los nodos, es decir, la mayor diferencia
+            entre los IDs de dos nodos de un mismo elemento.
+        */
+        int bandwidth(){
+            int nelems, width = 0;
+            SDDS<int>::extract(quantities,NUM_ELEMENTS,&nelems);
+            for(int e = 0; e < nelems; e++){
+                Element* elem = get_element_at(e);
+                for(int a = 0; a < 3; a++)
+                    for(int b = a+1; b < 3; b++)
+                        width = max(width, abs(elem->get_Node(a)->get_ID() - elem->get_Node(b)->get_ID()));
             }
+            return width;
         }
 };
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+    Funciones para guardar y recuperar checkpoints del proceso transitorio.
+
+    Un checkpoint es un archivo binario con extensión ".ckpt" que contiene
+    todo el estado necesario para reanudar el ciclo de tiempo:
+        - Un encabezado de verificación ("FEMCKPT4").
+        - La cantidad de nodos libres, para validar que el checkpoint
+          corresponde a la malla en proceso.
+        - Si los nodos de la malla fueron renumerados, ya que <T> se guarda
+          en la numeración interna y solo puede recuperarse con la misma.
+        - El tamaño en bytes del tipo real con el que se compiló el proceso
+          (ver precision_utilities.h), ya que <T> se guarda con ese tipo.
+        - El tiempo <t> del siguiente paso a calcular.
+        - El paso de tiempo <dt> con el que se calcula el siguiente paso, que
+          con el paso de tiempo adaptativo difiere del indicado en el archivo
+          de entrada.
+        - La cantidad <step> de resultados ya escritos en el archivo de salida.
+        - La cantidad <offset> de bytes válidos en el archivo de salida, es
+          decir, la posición del cursor de salida al terminar el último
+          resultado escrito.
+        - El vector columna <T> de temperaturas de los nodos libres.
+
+    Para que un fallo durante la escritura no deje un checkpoint corrupto, el
+    archivo se escribe primero con extensión ".ckpt.tmp" y luego se renombra,
+    reemplazando de forma atómica al checkpoint anterior.
+*/
+
+//Encabezado de verificación de los archivos de checkpoint
+const char CHECKPOINT_MAGIC[8] = {'F','E','M','C','K','P','T','4'};
+
+/*
+    Función para guardar un checkpoint del proceso.
+
+    Se reciben <filename> como el nombre del archivo de entrada sin extensión,
+    <T> como el vector columna de temperaturas de los nodos libres, <t> como
+    el tiempo del siguiente paso a calcular, <dt> como el paso de tiempo con el
+    que se calcula, <step> como la cantidad de resultados escritos, <offset> como
+    la posición del cursor del archivo de salida, y <renumbered> para indicar si
+    los nodos de la malla fueron renumerados.
+*/
+void write_checkpoint(char* filename, DS<real>* T, float t, float dt, int step, long offset, bool renumbered){
+    string checkpoint_file = add_extension(filename, ".ckpt");
+    string temp_file = checkpoint_file + ".tmp";
+
+    ofstream ckptFile( temp_file, ios::binary );
+
+    //Si la apertura falló, se informa pero no se detiene el proceso,
+    //ya que el cálculo en sí no se ve afectado
+    if( !ckptFile.is_open() ){
+        cout << "Problem opening the checkpoint file. :(\n";
+        return;
+    }
+
+    //Se extrae la cantidad de nodos libres
+    int nrows, ncols;
+    SDDS<real>::extension(T, &nrows, &ncols);
+
+    //Se escriben el encabezado y los datos de control
+    ckptFile.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    ckptFile.write((char*) &nrows,  sizeof(int));
+    ckptFile.write((char*) &renumbered, sizeof(bool));
+    char precision = sizeof(real);
+    ckptFile.write(&precision, sizeof(char));
+    ckptFile.write((char*) &t,      sizeof(float));
+    ckptFile.write((char*) &dt,     sizeof(float));
+    ckptFile.write((char*) &step,   sizeof(int));
+    ckptFile.write((char*) &offset, sizeof(long));
+
+    //Se escribe el vector de temperaturas
+    for(int i = 0; i < nrows; i++){
+        real value;
+        SDDS<real>::extract(T, i, 0, &value);
+        ckptFile.write((char*) &value, sizeof(real));
+    }
+
+    ckptFile.close();
+
+    //Sólo si la escritura fue exitosa se reemplaza el checkpoint anterior
+    if( ckptFile.good() )
+        rename(temp_file.c_str(), checkpoint_file.c_str());
+    else
+        cout << "Problem writing the checkpoint file. :(\n";
+}
+
+/*
+    Función para recuperar el último checkpoint del proceso.
+
+    Se reciben <filename> como el nombre del archivo de entrada sin extensión,
+    <T> como el vector columna de temperaturas de los nodos libres, ya creado
+    con sus dimensiones correctas, en el cual se colocarán las temperaturas
+    guardadas, y <renumbered> para indicar si los nodos de la malla fueron
+    renumerados.
+
+    Se reciben por referencia <t>, <dt>, <step> y <offset> para almacenar el
+    tiempo del siguiente paso, el paso de tiempo con el que se calcula, la
+    cantidad de resultados escritos y la posición del cursor del archivo de
+    salida.
+
+    Se retorna true si el checkpoint se pudo recuperar, y false si no existe o
+    no corresponde a la malla en proceso, a su numeración o a la precisión
+    del ejecutable.
+*/
+bool read_checkpoint(char* filename, DS<real>* T, bool renumbered, float* t, float* dt, int* step, long* offset){
+    string checkpoint_file = add_extension(filename, ".ckpt");
+    ifstream ckptFile( checkpoint_file, ios::binary );
+
+    if( !ckptFile.is_open() ) return false;
+
+    //Se verifica el encabezado
+    char magic[8];
+    ckptFile.read(magic, sizeof(magic));
+    if( !ckptFile || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 ) return false;
+
+    //Se verifica que la cantidad de nodos libres coincida con la de la malla
+    int nrows, ncols, saved_rows;
+    SDDS<real>::extension(T, &nrows, &ncols);
+    ckptFile.read((char*) &saved_rows, sizeof(int));
+    if( !ckptFile || saved_rows != nrows ) return false;
+
+    //Se verifica que la numeración de los nodos coincida
+    bool saved_renumbered;
+    ckptFile.read((char*) &saved_renumbered, sizeof(bool));
+    if( !ckptFile || saved_renumbered != renumbered ) return false;
+
+    //Se verifica que la precisión coincida con la del ejecutable
+    char saved_precision;
+    ckptFile.read(&saved_precision, sizeof(char));
+    if( !ckptFile || saved_precision != (char) sizeof(real) ) return false;
+
+    //Se leen los datos de control
+    ckptFile.read((char*) t,      sizeof(float));
+    ckptFile.read((char*) dt,     sizeof(float));
+    ckptFile.read((char*) step,   sizeof(int));
+    ckptFile.read((char*) offset, sizeof(long));
+
+    //Se lee el vector de temperaturas
+    for(int i = 0; i < nrows; i++){
+        real value;
+        ckptFile.read((char*) &value, sizeof(real));
+        SDDS<real>::insert(T, i, 0, value);
+    }
+
+    //Si el archivo estaba truncado, el checkpoint no es válido
+    return (bool) ckptFile;
+}
+
+/*
+    Función para eliminar el checkpoint de un proceso que ha terminado
+    exitosamente, a fin de que un reinicio posterior no lo reanude.
+*/
+void remove_checkpoint(char* filename){
+    string checkpoint_file = add_extension(filename, ".ckpt");
+    remove(checkpoint_file.c_str());
+}
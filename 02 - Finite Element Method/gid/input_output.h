@@ -124,6 +124,20 @@ void read_input_file(Mesh* G, char* filename){
             G->add_neumann_cond( G->get_node(index), i );
         }
 
+        //El bloque del tipo de análisis es opcional, los archivos que no lo incluyen
+        //corresponden a un análisis transitorio. Se salta la línea de cierre del bloque
+        //de datos de las condiciones de Neumann, y si le sigue el encabezado del bloque
+        //del tipo de análisis, se extrae el tipo indicado
+        datFile >> line;
+        if( datFile >> line && line == "Analysis" ){
+            datFile >> line;
+            if(line == "Steady") G->set_analysis(STEADY);
+            else if(line != "Transient"){
+                cout << "Unknown analysis type in the input file: " << line << " :(\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+
         //Se cierra al archivo ya que ha terminado el proceso de lectura
         datFile.close();
 
@@ -136,66 +150,278 @@ void read_input_file(Mesh* G, char* filename){
 }
 
 /*
-    Función para crear el archivo de salida del programa que contendrá
-    los resultados del proceso de aplicación del Método de los Elementos
-    Finitos.
+    Enumeración para identificar las columnas de la tabla de casos de un barrido
+    de parámetros, es decir, los parámetros del problema que cada caso modifica.
+*/
+enum sweep_column {SWEEP_HEAT_SOURCE,SWEEP_DIRICHLET_VALUE,SWEEP_NEUMANN_VALUE,SWEEP_INITIAL_TEMPERATURE,NUM_SWEEP_COLUMNS};
+
+/*
+    Función para obtener la tabla de casos de un barrido de parámetros.
+
+    El archivo <filename>, cuyo nombre se recibe con su extensión, contiene un caso
+    por línea con cuatro valores, en el orden de la enumeración <sweep_column>:
 
-    Se recibe <R> como una lista enlazada simple de matrices, donde cada
-    una de ellas contiene los resultados de temperatura en los nodos de la
-    malla para cada uno de los pasos de tiempo del proceso.
+            <Q> <Td> <Tn> <initial_T>
 
-    Se recibe <filename> como el nombre del archivo de salida sin extensión.
+    Las líneas vacías y las que inician con '#' se ignoran.
+
+    Se retorna una matriz de dimensiones c x 4, donde c es la cantidad de casos.
 */
-void write_output_file(DS<DS<float>*>* R, char* filename){
-    //Se anexa al nombre del archivo de salida su extensión, y se abre para escritura
-    string output_file = add_extension(filename, ".post.res");
-    ofstream postResFile( output_file );
+DS<float>* read_sweep_file(char* filename){
+    ifstream sweepFile( filename );
 
-    //Se verifica si la apertura del archivo fue exitosa
-    if( postResFile.is_open() ){
-        //Se coloca el encabezado de archivo tal como lo solicita GiD
-        postResFile << "GiD Post Results File 1.0\n";
-
-        //Se extrae la longitud de la lista de resultados
-        int length;
-        SDDS<DS<float>*>::extension(R, &length);
-
-        //Se recorre la lista de resultados
-        for(int i = 0; i < length; i++){
-            //Se extrae el resultado actual, el cual es una matriz de dimensiones
-            //n x 1, donde n es el total de nodos en la malla
-            DS<float>* temp;
-            SDDS<DS<float>*>::extract(R,i,&temp);
-
-            //Se colocan los encabezados para el resultado actual
-            postResFile << "Result \"Temperature\" \"Load Case 1\" " << i+1 << " Scalar OnNodes\n";
-            postResFile << "ComponentNames \"T\"\n";
-            postResFile << "Values\n";
-
-            //Se extraen las dimensiones de la matriz actual de resultados
-            int nrows, ncols;
-            SDDS<float>::extension(temp, &nrows, &ncols);
-
-            //Sabiendo que la matriz es un vector columna, se recorre de manera
-            //similar a un arreglo
-            for(int f = 0; f < nrows; f++){
-                //Se extrae el resultado actual
-                float value;
-                SDDS<float>::extract(temp, f, 0, &value);   //Todo se encuentra en la primera, y única, columna
-
-                //Se coloca el resultado actual precedido de un correlativo
-                postResFile << f+1 << "     " << value << "\n";
+    //Si la apertura falló, se informa y se termina el programa
+    if( !sweepFile.is_open() ){
+        cout << "Problem opening the sweep file. :(\n";
+        exit(EXIT_FAILURE);
+    }
+
+    //Los casos se acumulan en una lista, ya que su cantidad no se conoce de antemano
+    DS<float>* values;
+    SDDS<float>::create(&values, SINGLE_LINKED_LIST);
+
+    string line;
+    int ncases = 0;
+    while( getline(sweepFile, line) ){
+        //Se ignoran las líneas vacías y los comentarios
+        size_t first = line.find_first_not_of(" \t\r");
+        if(first == string::npos || line[first] == '#') continue;
+
+        istringstream row(line);
+        float value;
+        for(int c = 0; c < NUM_SWEEP_COLUMNS; c++){
+            if( !(row >> value) ){
+                cout << "Problem reading case " << ncases+1 << " of the sweep file. :(\n";
+                exit(EXIT_FAILURE);
             }
+            SDDS<float>::push_back(values, value);
+        }
+        ncases++;
+    }
+    sweepFile.close();
+
+    if(ncases == 0){
+        cout << "The sweep file has no cases. :(\n";
+        exit(EXIT_FAILURE);
+    }
+
+    //Se traslada la lista a la tabla de casos
+    DS<float>* cases;
+    SDDS<float>::create(&cases, ncases, NUM_SWEEP_COLUMNS, MATRIX);
+    for(int i = 0; i < ncases*NUM_SWEEP_COLUMNS; i++){
+        float value;
+        SDDS<float>::extract(values, i, &value);
+        SDDS<float>::insert(cases, i/NUM_SWEEP_COLUMNS, i%NUM_SWEEP_COLUMNS, value);
+    }
+    SDDS<float>::destroy(values);
+
+    return cases;
+}
+
+/*
+    Función para crear un archivo de entrada, con el mismo formato que genera
+    GiD, a partir de una malla ya construida. Es la operación inversa de
+    read_input_file, y se utiliza para guardar mallas generadas por programa.
+
+    Se recibe <G> como el objeto Mesh con todos los datos de la malla, y se
+    recibe <filename> como el nombre del archivo a crear sin extensión.
+*/
+void write_input_file(Mesh* G, char* filename){
+    string input_file = add_extension(filename, ".dat");
+    ofstream datFile( input_file );
+
+    //Si la apertura falló, se informa y se termina el programa
+    if( !datFile.is_open() ){
+        cout << "Problem creating the input file. :(\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int nnodes = G->get_quantity(NUM_NODES);
+    int nelems = G->get_quantity(NUM_ELEMENTS);
+    int ndirichlet = G->get_quantity(NUM_DIRICHLET_BCs);
+    int nneumann = G->get_quantity(NUM_NEUMANN_BCs);
+
+    //Se colocan los parámetros y las cantidades en el mismo orden en que se leen
+    datFile << G->get_parameter(DENSITY) << " " << G->get_parameter(SPECIFIC_HEAT) << " "
+            << G->get_parameter(THERMAL_CONDUCTIVITY) << " " << G->get_parameter(HEAT_SOURCE) << "\n";
+    datFile << G->get_parameter(DIRICHLET_VALUE) << " " << G->get_parameter(NEUMANN_VALUE) << " "
+            << G->get_parameter(INITIAL_TEMPERATURE) << "\n";
+    datFile << G->get_parameter(TIME_STEP) << " " << G->get_parameter(INITIAL_TIME) << " "
+            << G->get_parameter(FINAL_TIME) << "\n";
+    datFile << nnodes << " " << nelems << " " << ndirichlet << " " << nneumann << "\n\n";
+
+    //Bloque de datos de los nodos de la malla
+    datFile << "Coordinates\n";
+    for(int i = 0; i < nnodes; i++){
+        FEMNode* node = G->get_node_at(i);
+        datFile << node->get_ID() << " " << node->get_Point()->get_x() << " " << node->get_Point()->get_y() << "\n";
+    }
+    datFile << "EndCoordinates\n\n";
+
+    //Bloque de datos de los elementos de la malla
+    datFile << "Elements\n";
+    for(int i = 0; i < nelems; i++){
+        Element* elem = G->get_element_at(i);
+        datFile << elem->get_ID() << " " << elem->get_Node(0)->get_ID() << " "
+                << elem->get_Node(1)->get_ID() << " " << elem->get_Node(2)->get_ID() << "\n";
+    }
+    datFile << "EndElements\n\n";
+
+    //Bloques de datos de las condiciones de contorno
+    DS<int>* indices;
+    int index;
+
+    datFile << "Dirichlet\n";
+    SDDS<int>::create(&indices, ndirichlet, ARRAY);
+    G->get_condition_indices(indices, DIRICHLET);
+    for(int i = 0; i < ndirichlet; i++){
+        SDDS<int>::extract(indices, i, &index);
+        datFile << index << "\n";
+    }
+    SDDS<int>::destroy(indices);
+    datFile << "EndDirichlet\n\n";
+
+    datFile << "Neumann\n";
+    SDDS<int>::create(&indices, nneumann, ARRAY);
+    G->get_condition_indices(indices, NEUMANN);
+    for(int i = 0; i < nneumann; i++){
+        SDDS<int>::extract(indices, i, &index);
+        datFile << index << "\n";
+    }
+    SDDS<int>::destroy(indices);
+    datFile << "EndNeumann\n";
+
+    //El bloque del tipo de análisis solo se coloca para el análisis estacionario,
+    //ya que su ausencia indica un análisis transitorio
+    if(G->get_analysis() == STEADY)
+        datFile << "\nAnalysis\nSteady\nEndAnalysis\n";
+
+    datFile.close();
+}
+
+/*
+    Función para crear el archivo de malla de post-proceso de GiD, con extensión
+    ".post.msh", a partir de la malla <G>. GiD lo utiliza en lugar de la malla del
+    pre-proceso al leer el archivo de resultados del mismo nombre, lo cual permite
+    visualizar resultados calculados sobre una malla refinada (ver Mesh::refine()).
+
+    Se recibe <filename> como el nombre del archivo sin extensión.
+*/
+void write_post_mesh(Mesh* G, char* filename){
+    string mesh_file = add_extension(filename, ".post.msh");
+    ofstream mshFile( mesh_file );
+
+    //Si la apertura falló, se informa y se termina el programa
+    if( !mshFile.is_open() ){
+        cout << "Problem creating the post-process mesh file. :(\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int nnodes = G->get_quantity(NUM_NODES);
+    int nelems = G->get_quantity(NUM_ELEMENTS);
+
+    mshFile << "MESH \"Heat2D\" dimension 2 ElemType Triangle Nnode 3\n";
+    mshFile << "Coordinates\n";
+    for(int i = 0; i < nnodes; i++){
+        FEMNode* node = G->get_node_at(i);
+        mshFile << node->get_ID() << " " << node->get_Point()->get_x() << " " << node->get_Point()->get_y() << "\n";
+    }
+    mshFile << "End Coordinates\n";
+
+    mshFile << "Elements\n";
+    for(int i = 0; i < nelems; i++){
+        Element* elem = G->get_element_at(i);
+        mshFile << elem->get_ID() << " " << elem->get_Node(0)->get_ID() << " "
+                << elem->get_Node(1)->get_ID() << " " << elem->get_Node(2)->get_ID() << "\n";
+    }
+    mshFile << "End Elements\n";
+
+    mshFile.close();
+}
+
+/*
+    Función que coloca en el archivo de salida el encabezado
+    tal como lo solicita GiD.
+
+    Se recibe <postResFile> como el archivo de salida ya abierto.
+*/
+void write_output_header(ofstream* postResFile){
+    *postResFile << "GiD Post Results File 1.0\n";
+}
 
-            //Se coloca un cierre para el resultado actual
-            postResFile << "End values\n";
+/*
+    Función que coloca en el archivo de salida los resultados de un
+    paso de tiempo.
+
+    Se recibe <postResFile> como el archivo de salida ya abierto, se
+    recibe <T> como una matriz de dimensiones n x 1, donde n es el total
+    de nodos en la malla, que contiene los resultados de temperatura del
+    paso, y se recibe <step> como el correlativo del paso, comenzando en 1.
+
+    Si los nodos de la malla fueron renumerados, se recibe <numbering> como
+    el arreglo de numeración de la malla (ver Mesh::get_numbering()), de modo
+    que cada resultado se coloque con el ID del nodo en GiD. Si es NULL, la
+    fila f de <T> corresponde al nodo con ID f+1.
+*/
+void write_output_step(ofstream* postResFile, DS<real>* T, int step, DS<int>* numbering = NULL){
+    //Se colocan los encabezados para el resultado actual
+    *postResFile << "Result \"Temperature\" \"Load Case 1\" " << step << " Scalar OnNodes\n";
+    *postResFile << "ComponentNames \"T\"\n";
+    *postResFile << "Values\n";
+
+    //Se extraen las dimensiones de la matriz de resultados
+    int nrows, ncols;
+    SDDS<real>::extension(T, &nrows, &ncols);
+
+    //Sabiendo que la matriz es un vector columna, se recorre de manera
+    //similar a un arreglo
+    for(int f = 0; f < nrows; f++){
+        //Se determina la fila del nodo con ID f+1 en GiD
+        int row = f;
+        if(numbering != NULL){
+            SDDS<int>::extract(numbering, f, &row);
+            row--;
         }
 
-        //Se cierra al archivo ya que ha terminado el proceso de escritura
-        postResFile.close();
+        //Se extrae el resultado actual
+        real value;
+        SDDS<real>::extract(T, row, 0, &value);    //Todo se encuentra en la primera, y única, columna
+
+        //Se coloca el resultado actual precedido de un correlativo
+        *postResFile << f+1 << "     " << value << "\n";
     }
+
+    //Se coloca un cierre para el resultado actual
+    *postResFile << "End values\n";
+}
+
+/*
+    Función para abrir el archivo de salida del programa a fin de ir
+    colocando en él los resultados conforme se calculan.
+
+    Se recibe <postResFile> como el archivo a abrir, <filename> como el
+    nombre del archivo de salida sin extensión, y <offset> como la cantidad
+    de bytes del archivo existente que se desean conservar:
+        - Si <offset> es 0, se crea un archivo nuevo y se coloca su encabezado.
+        - Si <offset> es mayor que 0, se recorta el archivo existente a dicha
+          cantidad de bytes, descartando cualquier resultado escrito después
+          del último checkpoint, y se abre para continuar escribiendo al final.
+*/
+void open_output_file(ofstream* postResFile, char* filename, long offset){
+    string output_file = add_extension(filename, ".post.res");
+
+    if(offset == 0){
+        postResFile->open( output_file );
+        if( postResFile->is_open() ) write_output_header(postResFile);
+    }else{
+        //Se recorta el archivo a la posición indicada
+        error_code ec;
+        filesystem::resize_file(output_file, offset, ec);
+        if(!ec) postResFile->open( output_file, ios::app );
+    }
+
     //Si la apertura falló, se informa y se termina el programa
-    else{
+    if( !postResFile->is_open() ){
         cout << "Problem opening the output file. :(\n";
         exit(EXIT_FAILURE);
     }
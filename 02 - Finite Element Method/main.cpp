@@ -1,16 +1,38 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#ifdef FEM_USE_MPI
+    #include <mpi.h>
+#endif
 #define PAUSE int n; cin >> n;
 
 using namespace std;
 
+#include "utilities/precision_utilities.h"
 #include "data_structures/SDDS.h"
 #include "geometry/mesh.h"
 #include "gid/input_output.h"
+#include "gid/checkpoint.h"
+#include "utilities/log_utilities.h"
+#include "utilities/options_utilities.h"
 #include "utilities/math_utilities.h"
+#include "utilities/expression_utilities.h"
+#include "utilities/skyline_utilities.h"
+#include "utilities/matrix_free_utilities.h"
+#include "utilities/iterative_utilities.h"
+#include "utilities/amg_utilities.h"
+#include "utilities/distributed_utilities.h"
 #include "utilities/FEM_utilities.h"
+#include "utilities/gmg_utilities.h"
 
 /*
     Este archivo hace uso de la clase SDDS, la cual se ha
@@ -37,6 +59,10 @@ using namespace std;
           instanciación vacía de la misma haciendo uso
           de un constructor genérico.
 
+    El atributo se declara thread_local en SDDS, para que
+    cada hilo tenga su propia copia (ver distributed_utilities.h),
+    y C++ requiere que la asignación lo indique también.
+
     Por último, dado que SDDS es un template, es necesario
     realizar esta instanciación establecienco el "meta-parámetro";
     sin embargo, ya que el proceso no ha comenzado aún no está
@@ -44,23 +70,995 @@ using namespace std;
     se "acarrea" el template.
 */
 template <typename T>
-Data SDDS<T>::ref = Data();
+thread_local Data SDDS<T>::ref = Data();
 
-void free_list(DS<DS<float>*>* L){
+void free_list(DS<DS<real>*>* L){
     //Se calcula la longitud de la lista
-    int length;
-    SDDS<DS<float>*>::extension(L, &length);
+    int length = 0;
+    SDDS<DS<real>*>::extension(L, &length);
     //Se recorre la lista
     for(int i = 0; i < length; i++){
         //Se extrae la matriz actual
-        DS<float>* temp;
-        SDDS<DS<float>*>::extract(L,i,&temp);
+        DS<real>* temp = NULL;
+        SDDS<DS<real>*>::extract(L,i,&temp);
 
         //Se libera el espacio en memoria de la matriz actual
-        SDDS<float>::destroy(temp);
+        SDDS<real>::destroy(temp);
     }
     //Se libera el espacio en memoria de la lista de resultados
-    SDDS<DS<float>*>::destroy(L);
+    SDDS<DS<real>*>::destroy(L);
+}
+
+/*
+    Procedimiento que libera las <nmeshes> mallas de <meshes>, junto con los
+    arreglos de extremos <parents> de las mallas refinadas, y ambos arreglos.
+*/
+void free_meshes(Mesh** meshes, int** parents, int nmeshes){
+    for(int m = 0; m < nmeshes; m++) delete meshes[m];
+    for(int m = 0; m < nmeshes-1; m++) free(parents[m]);
+    free(meshes);
+    free(parents);
+}
+
+/*
+    Función que construye el sistema global del problema para el estado actual
+    de la malla <G>: calcula los sistemas locales de todos los elementos, los
+    ensambla, y aplica las condiciones de Neumann (<T_N>) y de Dirichlet
+    (<dirichlet_indices>).
+
+    Se colocan en <K> y <b> la matriz K y el vector b globales, ya reducidos a los
+    "nodos libres". Si <M> no es NULL, se coloca en él la matriz M global, también
+    reducida; el análisis estacionario no la utiliza, por lo que en ese caso no se
+    calcula.
+*/
+void build_global_system(Mesh* G, DS<real>* T_N, DS<int>* dirichlet_indices, DS<real>** M, DS<real>** K, DS<real>** b){
+    int nelems = G->get_quantity(NUM_ELEMENTS);
+    int nnodes = G->get_quantity(NUM_NODES);
+    int free_nodes = nnodes - G->get_quantity(NUM_DIRICHLET_BCs);
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+    DS<DS<real>*> *M_locals = NULL, *K_locals, *b_locals;
+
+    //Se preparan los arreglos para almacenar todas las matrices locales de todos los elementos
+    //La longitud de los 3 arreglos es igual a la cantidad de elementos
+    if(M != NULL) SDDS<DS<real>*>::create(&M_locals, nelems, ARRAY);
+    SDDS<DS<real>*>::create(&K_locals, nelems, ARRAY);
+    SDDS<DS<real>*>::create(&b_locals, nelems, ARRAY);
+
+    {
+        ScopedTimer timer(PHASE_LOCAL_SYSTEMS);
+        //Se recorren los elementos
+        for(int e = 0; e < nelems; e++){
+            LOG_DEBUG("\t\tWorking with ELEMENT = " << e+1 << ":\n");
+            //Se interpreta el contador como un ID de elemento, con la salvedad
+            //que el contador comienza en 0 y los IDs comienzan en 1
+
+            //Se extrae el elemento actual, se envía e+1 para compensar la diferencia en los conteos
+            Element* current_elem = G->get_element(e+1);
+
+            LOG_DEBUG("\t\tCalculating local systems... ");
+            //Se calcula la M local y se añade al listado de matrices M. Se envían la densidad y el calor específico del material
+            if(M != NULL)
+                SDDS<DS<real>*>::insert(M_locals, e, FEM::calculate_local_M<real>(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT), current_elem));
+            //Se calcula la K local y se añade al listado de matrices K. Se envía la conductividad térmica del material
+            SDDS<DS<real>*>::insert(K_locals, e, FEM::calculate_local_K<real>(G->get_parameter(THERMAL_CONDUCTIVITY), current_elem));
+            //Se calcula la b local y se añade al listado de matrices b. Se envía la fuente de calor
+            SDDS<DS<real>*>::insert(b_locals, e, FEM::calculate_local_b<real>(G->get_parameter(HEAT_SOURCE), current_elem));
+            LOG_DEBUG("OK\n\n");
+        }
+    }
+
+    LOG_DEBUG("\tCreating global system...\n");
+
+    {
+        ScopedTimer timer(PHASE_ASSEMBLY);
+        //Se crean las matrices globales, y se inicializan todas sus posiciones con 0
+        if(M != NULL){ SDDS<real>::create(M, nnodes, nnodes, MATRIX); Math::zeroes(*M); }
+        SDDS<real>::create(K, nnodes, nnodes, MATRIX); Math::zeroes(*K);
+        SDDS<real>::create(b, nnodes, 1, MATRIX);      Math::zeroes(*b);
+
+        //Se recorren los listados de matrices locales, un elemento a la vez
+        for(int e = 0; e < nelems; e++){
+            LOG_DEBUG("\t\tAssembling ELEMENT = " << e+1 << ":\n");
+            //Se extrae el elemento actual, se envía e+1 para compensar la diferencia en los conteos
+            Element* current_elem = G->get_element(e+1);
+            DS<real> *temp;
+
+            LOG_DEBUG("\t\tAssembling local matrices... ");
+            //Se extrae la matriz M del elemento actual y se envía a ensamblaje
+            if(M != NULL){
+                SDDS<DS<real>*>::extract(M_locals,e,&temp);
+                FEM::assembly(*M, temp, current_elem, true);  //Se indica que ensamblará una matriz 3 x 3
+            }
+
+            //Se extrae la matriz K del elemento actual y se envía a ensamblaje
+            SDDS<DS<real>*>::extract(K_locals,e,&temp);
+            FEM::assembly(*K, temp, current_elem, true);
+
+            //Se extrae la matriz b del elemento actual y se envía a ensamblaje
+            SDDS<DS<real>*>::extract(b_locals,e,&temp);
+            FEM::assembly(*b, temp, current_elem, false); //Se indica que ensamblará una matriz 3 x 1
+            LOG_DEBUG("OK\n\n");
+        }
+    }
+
+    //Las matrices locales ya no serán utilizadas, por lo que se libera su espacio en memoria
+    if(M != NULL) free_list(M_locals);
+    free_list(K_locals);
+    free_list(b_locals);
+
+    LOG_DEBUG("\tApplying Neumann conditions... ");
+    {
+        ScopedTimer timer(PHASE_NEUMANN);
+        //Se agrega la matriz de valores de Neumann a la matriz b global
+        Math::sum_in_place(*b,T_N);
+    }
+    LOG_DEBUG("OK\n\n");
+
+    LOG_DEBUG("\tApplying Dirichlet conditions... ");
+    {
+        ScopedTimer timer(PHASE_DIRICHLET);
+        //Se modifican las matrices globales para aplicar las condiciones de Dirichlet
+        FEM::apply_Dirichlet(nnodes, free_nodes, b, *K, Td, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, K, dirichlet_indices);
+        if(M != NULL) FEM::apply_Dirichlet(nnodes, free_nodes, M, dirichlet_indices);
+    }
+    LOG_DEBUG("OK\n\n");
+}
+
+/*
+    Función que calcula la razón de cambio de las temperaturas de los "nodos
+    libres" en el tiempo, de acuerdo a la ecuación de transferencia de calor:
+
+                    dT/dt = M^(-1) * ( b - K * T )
+
+    Se reciben <K> y <b> como el sistema global ya reducido, <M_skyline> como la
+    factorización de Cholesky de la matriz M, y <T> como las temperaturas
+    actuales. Se retorna un nuevo vector columna con la razón de cambio.
+
+    El lado derecho b - K * T se evalúa como una sola expresión diferida (ver
+    expression_utilities.h), sin construir el producto K * T por separado.
+*/
+DS<real>* temperature_rate(DS<real>* K, DS<real>* b, Skyline* M_skyline, DS<real>* T){
+    DS<real>* rate = Lazy::evaluate(Lazy::of(b) - Lazy::of(K)*Lazy::of(T));
+    M_skyline->solve(rate);
+    return rate;
+}
+
+/*
+    Procedimiento que resuelve el sistema K * X = <B> del análisis estacionario,
+    donde <K> es la matriz K global ya reducida y <B> tiene una columna por lado
+    derecho. La solución se almacena en la misma matriz <B>.
+
+    El solucionador se elige con la opción --solver de <opts>:
+        - Cholesky en almacenamiento skyline, que resuelve todas las columnas con
+          un solo recorrido del factor.
+        - Cholesky en precisión mixta, que factoriza en float y refina todas las
+          columnas a la vez en double hasta la tolerancia del gradiente conjugado.
+        - Multigrid algebraico, por sí solo o como precondicionador del gradiente
+          conjugado. La jerarquía se construye una sola vez y se reutiliza en todas
+          las columnas, partiendo cada una de cero.
+*/
+void solve_stiffness(DS<real>* K, DS<real>* B, Options* opts){
+    if(opts->solver == SOLVER_CHOLESKY){
+        /*
+            K es definida positiva siempre que exista al menos un nodo con condición
+            de Dirichlet.
+        */
+        Skyline* K_skyline = new Skyline(K);
+        if(!K_skyline->factorize()){
+            cerr << "The stiffness matrix is not positive definite, the steady state requires Dirichlet conditions. :(\n";
+            exit(EXIT_FAILURE);
+        }
+        K_skyline->solve(B);
+        delete K_skyline;
+        return;
+    }
+
+    if(opts->solver == SOLVER_CHOLESKY_IR){
+        RefinedCholesky* K_refined = new RefinedCholesky(K);
+        if(!K_refined->factorize()){
+            cerr << "The stiffness matrix is not positive definite, the steady state requires Dirichlet conditions. :(\n";
+            exit(EXIT_FAILURE);
+        }
+
+        float residual;
+        int iterations = K_refined->solve(B, opts->cg_tolerance, 50, &residual);
+        LOG_PROGRESS("\tIterative refinement: " << iterations << " iterations, relative residual " << residual << "\n");
+        if(!(residual <= opts->cg_tolerance))
+            cerr << "Warning: the iterative refinement stopped at relative residual " << residual << ", above the requested tolerance.\n";
+        delete K_refined;
+        return;
+    }
+
+    AMG* hierarchy = new AMG(K);
+    LOG_PROGRESS("\tAlgebraic multigrid: " << hierarchy->levels() << " levels, operator complexity " << hierarchy->complexity() << "\n");
+
+    int n = hierarchy->size(), ncols;
+    SDDS<real>::extension(B, &n, &ncols);
+    real* rhs = (real*) malloc(sizeof(real)*n);
+    real* x = (real*) malloc(sizeof(real)*n);
+    MultigridPreconditioner* P = new MultigridPreconditioner(hierarchy);
+
+    for(int c = 0; c < ncols; c++){
+        for(int i = 0; i < n; i++){
+            SDDS<real>::extract(B, i, c, &rhs[i]);
+            x[i] = 0;
+        }
+
+        float residual;
+        int iterations;
+        if(opts->solver == SOLVER_AMG)
+            iterations = hierarchy->solve(rhs, x, opts->cg_tolerance, 200, &residual);
+        else
+            iterations = Iterative::conjugate_gradient(hierarchy, P, rhs, x, n, opts->cg_tolerance, 200, &residual);
+        LOG_PROGRESS("\t" << ((opts->solver == SOLVER_AMG) ? "V-cycles" : "Conjugate gradient") << ": " << iterations << " iterations, relative residual " << residual << "\n");
+        if(!(residual <= opts->cg_tolerance))
+            cerr << "Warning: the iterative solver stopped at relative residual " << residual << ", above the requested tolerance.\n";
+
+        for(int i = 0; i < n; i++) SDDS<real>::insert(B, i, c, x[i]);
+    }
+
+    free(rhs); free(x);
+    delete P;
+    delete hierarchy;
+}
+
+/*
+    Procedimiento que avanza en el tiempo con paso de tiempo adaptativo, desde las
+    temperaturas <T> hasta el tiempo final, o hasta alcanzar el estado estacionario.
+
+    Cada paso se calcula con Forward Euler, al igual que con paso de tiempo fijo:
+
+                    T^(i+1) = T^i + delta_t * r^i,      r^i = M^(-1) * ( b - K * T^i )
+
+    y su error se estima comparándolo con el paso del método de Heun, de segundo
+    orden, que utiliza además la razón de cambio r* en el punto calculado:
+
+                    error = || (delta_t/2) * ( r* - r^i ) ||
+
+    Si el error relativo a las temperaturas supera la tolerancia, el paso se
+    rechaza y se repite con un paso de tiempo menor; de lo contrario se acepta, y
+    r* se reutiliza como la razón de cambio del siguiente paso, por lo que cada
+    paso aceptado requiere una sola solución con M. En ambos casos el siguiente
+    paso de tiempo se escala por 0.9*sqrt(tolerancia/error), limitado entre 0.2 y
+    5 veces el actual, ya que el error de Forward Euler es proporcional a delta_t^2.
+
+    El proceso termina antes del tiempo final cuando el cambio relativo de las
+    temperaturas en un paso aceptado, medido con el paso de Heun, es menor a la
+    tolerancia de estado estacionario de <opts>.
+
+    M, K y b no dependen del tiempo ni de las temperaturas, por lo que el sistema
+    global y la factorización de M se construyen una sola vez.
+
+    Se reciben, además de los datos de la malla y los vectores del procedimiento
+    principal, <t> como el tiempo del siguiente paso a calcular, <dt> como el paso
+    de tiempo inicial, y <step> como la cantidad de resultados ya escritos.
+*/
+void adaptive_loop(Mesh* G, DS<real>* T, DS<real>* T_full, DS<real>* T_N, DS<int>* dirichlet_indices, ofstream* postResFile, float t, float dt, int* step, Options* opts){
+    DS<real> *M, *K, *b;
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+    float tf = G->get_parameter(FINAL_TIME);
+    float tol = opts->tolerance;
+    //Tiempo de las temperaturas actuales
+    float t_now = t - dt;
+    int accepted = 0, rejected = 0;
+
+    build_global_system(G, T_N, dirichlet_indices, &M, &K, &b);
+
+    Skyline* M_skyline;
+    DS<real>* rate;
+    {
+        ScopedTimer timer(PHASE_SOLVE);
+        M_skyline = new Skyline(M);
+        if(!M_skyline->factorize()){
+            cerr << "The mass matrix is not positive definite. :(\n";
+            exit(EXIT_FAILURE);
+        }
+        rate = temperature_rate(K, b, M_skyline, T);
+    }
+    SDDS<real>::destroy(M);
+
+    //El proceso avanza mientras falte más de una fracción despreciable del intervalo
+    while( tf - t_now > 1e-6*max(fabs(tf), dt) ){
+        //El último paso se recorta para terminar exactamente en el tiempo final
+        float h = min(dt, tf - t_now);
+
+        DS<real> *T_next, *rate_next;
+        float error, change;
+        {
+            ScopedTimer timer(PHASE_SOLVE);
+            //Paso de Forward Euler
+            T_next = Lazy::evaluate(h*Lazy::of(rate) + Lazy::of(T));
+
+            //Estimación del error con el paso de Heun
+            rate_next = temperature_rate(K, b, M_skyline, T_next);
+            float scale = max(Math::max_norm(T_next), (real) 1);
+            error = 0.5*h*Math::max_difference(rate_next, rate)/scale;
+            //El cambio de las temperaturas en el paso se mide con el paso de Heun, que
+            //promedia las razones de cambio y así descarta las oscilaciones que Forward
+            //Euler presenta en su límite de estabilidad, donde r* es cercano a -r^i
+            change = 0.5*h*Lazy::max_norm(Lazy::of(rate_next) + Lazy::of(rate))/scale;
+        }
+
+        //Factor de ajuste del paso de tiempo
+        float factor = (error > 0) ? 0.9*sqrt(tol/error) : 5;
+        factor = min(5.0f, max(0.2f, factor));
+
+        if(error > tol){
+            //Se rechaza el paso, y se repite con un paso de tiempo menor
+            LOG_DEBUG("\tStep rejected at TIME = " << t_now << "s with dt = " << h << "s (error " << error << ")\n");
+            SDDS<real>::destroy(T_next);
+            SDDS<real>::destroy(rate_next);
+            dt = h*factor;
+            rejected++;
+            continue;
+        }
+
+        //Se acepta el paso
+        accepted++;
+        t_now += h;
+        Math::zeroes(T);
+        Math::sum_in_place(T, T_next);
+        SDDS<real>::destroy(T_next);
+        SDDS<real>::destroy(rate);
+        rate = rate_next;
+        dt = h*factor;
+
+        LOG_PROGRESS("\tStep " << *step << ": reached TIME = " << t_now << "s with dt = " << h << "s\n");
+
+        {
+            ScopedTimer timer(PHASE_OUTPUT);
+            FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+            write_output_step(postResFile, T_full, ++(*step), G->get_numbering());
+            postResFile->flush();
+        }
+
+        //Cada <checkpoint_every> pasos se guarda el estado del proceso
+        if(opts->checkpoint_every > 0 && (*step-1) % opts->checkpoint_every == 0){
+            ScopedTimer timer(PHASE_OUTPUT);
+            write_checkpoint(opts->filename, T, t_now + dt, dt, *step, (long) postResFile->tellp(), opts->renumber);
+        }
+
+        //Si las temperaturas prácticamente no cambiaron, se ha alcanzado el estado estacionario
+        if(change < opts->steady_tolerance){
+            LOG_PROGRESS("\tSteady state reached at TIME = " << t_now << "s\n");
+            break;
+        }
+    }
+
+    LOG_PROGRESS("\t" << accepted << " steps accepted, " << rejected << " rejected\n");
+
+    SDDS<real>::destroy(rate);
+    SDDS<real>::destroy(K);
+    SDDS<real>::destroy(b);
+    delete M_skyline;
+}
+
+/*
+    Función que construye, en un arreglo nuevo, el vector b global reducido a
+    los "nodos libres" para el operador sin ensamblar <op>: la fuente de calor
+    más las condiciones de Neumann (<T_N>). A diferencia de build_global_system(),
+    no incluye el vector de las condiciones de Dirichlet, ya que el operador
+    aplica K_fd * Td junto con K_ff * T.
+*/
+real* matrix_free_load(Mesh* G, ElementOperator* op, DS<real>* T_N, DS<int>* dirichlet_indices){
+    int nnodes = G->get_quantity(NUM_NODES);
+    real* b = (real*) malloc(sizeof(real)*op->size());
+    op->load_vector(G->get_parameter(HEAT_SOURCE), b);
+
+    //Los nodos libres se recorren en el orden de sus IDs, igual que en el operador
+    for(int i = 0, f = 0; i < nnodes; i++){
+        bool is_dirichlet;
+        SDDS<int>::search(dirichlet_indices, i+1, &is_dirichlet);
+        if(is_dirichlet) continue;
+        real Tn;
+        SDDS<real>::extract(T_N, i, 0, &Tn);
+        b[f++] += Tn;
+    }
+    return b;
+}
+
+/*
+    Procedimiento que resuelve el problema sin ensamblar la matriz K, calculando
+    cada producto K * T elemento por elemento con ElementOperator.
+
+    En el análisis estacionario se resuelve K_ff * T = b - K_fd * Td con gradiente
+    conjugado precondicionado con Jacobi, partiendo de las temperaturas <T>, hasta
+    el residuo relativo indicado en <opts>.
+
+    En el análisis transitorio se avanza con Forward Euler y paso de tiempo fijo,
+    igual que el ciclo principal:
+
+                T^(i+1) = T^i + M^(-1) * delta_t * ( b - K_ff * T^i - K_fd * Td )
+
+    M se ensambla directamente en almacenamiento skyline a partir de los factores
+    del operador, y se factoriza una sola vez, ya que ninguna de las matrices
+    depende del tiempo.
+
+    Se reciben los mismos datos que adaptive_loop(), con <t> como el tiempo del
+    siguiente paso a calcular.
+*/
+void matrix_free_loop(Mesh* G, DS<real>* T, DS<real>* T_full, DS<real>* T_N, DS<int>* dirichlet_indices, ofstream* postResFile, float t, float dt, int* step, Options* opts){
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+    float tf = G->get_parameter(FINAL_TIME);
+    bool steady = G->get_analysis() == STEADY;
+
+    ElementOperator* op;
+    real* b;
+    {
+        ScopedTimer timer(PHASE_LOCAL_SYSTEMS);
+        op = new ElementOperator(G, dirichlet_indices, G->get_parameter(THERMAL_CONDUCTIVITY));
+        b = matrix_free_load(G, op, T_N, dirichlet_indices);
+    }
+    int n = op->size();
+
+    real* x = (real*) malloc(sizeof(real)*n);
+    real* y = (real*) malloc(sizeof(real)*n);
+    for(int i = 0; i < n; i++) SDDS<real>::extract(T, i, 0, &x[i]);
+
+    if(steady){
+        ScopedTimer timer(PHASE_SOLVE);
+        //Se descuenta del lado derecho el aporte de los nodos con condición de Dirichlet
+        real* zero = (real*) calloc(n, sizeof(real));
+        op->apply(zero, y, Td);
+        for(int i = 0; i < n; i++) b[i] -= y[i];
+        free(zero);
+
+        JacobiPreconditioner* P = new JacobiPreconditioner(op);
+        float residual;
+        int iterations = Iterative::conjugate_gradient(op, P, b, x, n, opts->cg_tolerance, 10*n, &residual);
+        LOG_PROGRESS("\tConjugate gradient: " << iterations << " iterations, relative residual " << residual << "\n");
+        if(!(residual <= opts->cg_tolerance))
+            cerr << "Warning: the conjugate gradient did not reach the requested tolerance.\n";
+        delete P;
+
+        for(int i = 0; i < n; i++) SDDS<real>::insert(T, i, 0, x[i]);
+        {
+            ScopedTimer timer(PHASE_OUTPUT);
+            FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+            write_output_step(postResFile, T_full, ++(*step), G->get_numbering());
+        }
+    }
+    else{
+        Skyline* M_skyline;
+        {
+            ScopedTimer timer(PHASE_ASSEMBLY);
+            M_skyline = op->mass_matrix(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT));
+        }
+        {
+            ScopedTimer timer(PHASE_SOLVE);
+            if(!M_skyline->factorize()){
+                cerr << "The mass matrix is not positive definite. :(\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        DS<real>* delta;
+        SDDS<real>::create(&delta, n, 1, MATRIX);
+
+        while( t <= tf ){
+            LOG_PROGRESS("\tStep " << *step << ": working at TIME = " << t << "s\n");
+            {
+                ScopedTimer timer(PHASE_SOLVE);
+                //delta_t * ( b - K * T ), con el producto calculado elemento por elemento
+                op->apply(x, y, Td);
+                for(int i = 0; i < n; i++) SDDS<real>::insert(delta, i, 0, dt*(b[i] - y[i]));
+                Perf::count_flops(2LL*n);
+                //Se resuelve M * delta = delta_t * ( b - K * T ) y se avanza al siguiente tiempo
+                M_skyline->solve(delta);
+                for(int i = 0; i < n; i++){
+                    real d;
+                    SDDS<real>::extract(delta, i, 0, &d);
+                    x[i] += d;
+                    SDDS<real>::insert(T, i, 0, x[i]);
+                }
+            }
+
+            {
+                ScopedTimer timer(PHASE_OUTPUT);
+                FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+                write_output_step(postResFile, T_full, ++(*step), G->get_numbering());
+                postResFile->flush();
+            }
+
+            t = t + dt;
+
+            //Cada <checkpoint_every> pasos se guarda el estado del proceso
+            if(opts->checkpoint_every > 0 && (*step-1) % opts->checkpoint_every == 0){
+                ScopedTimer timer(PHASE_OUTPUT);
+                write_checkpoint(opts->filename, T, t, dt, *step, (long) postResFile->tellp(), opts->renumber);
+            }
+        }
+
+        SDDS<real>::destroy(delta);
+        delete M_skyline;
+    }
+
+    free(x); free(y); free(b);
+    delete op;
+}
+
+/*
+    Procedimiento que resuelve el análisis estacionario sobre la malla más fina de
+    <meshes> con multigrid geométrico (ver GeometricMultigrid), por sí solo o como
+    precondicionador del gradiente conjugado según la opción --solver de <opts>.
+
+    Ninguna matriz densa interviene: el lado derecho b - K_fd * Td se calcula con
+    el operador sin ensamblar de la malla fina, igual que en matrix_free_loop(), y
+    la matriz K de la malla fina se ensambla en formato disperso. La solución se
+    coloca en <T>, cuyos datos iniciales son la aproximación inicial.
+*/
+void geometric_multigrid_solve(Mesh** meshes, int** parents, int nmeshes, DS<real>* T, DS<real>* T_N, DS<int>* dirichlet_indices, Options* opts){
+    Mesh* G = meshes[nmeshes-1];
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+
+    ElementOperator* op;
+    real* b;
+    GeometricMultigrid* hierarchy;
+    {
+        ScopedTimer timer(PHASE_ASSEMBLY);
+        op = new ElementOperator(G, dirichlet_indices, G->get_parameter(THERMAL_CONDUCTIVITY));
+        b = matrix_free_load(G, op, T_N, dirichlet_indices);
+        hierarchy = new GeometricMultigrid(meshes, parents, nmeshes);
+    }
+    LOG_PROGRESS("\tGeometric multigrid: " << hierarchy->levels() << " levels, operator complexity " << hierarchy->complexity() << "\n");
+
+    ScopedTimer timer(PHASE_SOLVE);
+    int n = op->size();
+    real* x = (real*) malloc(sizeof(real)*n);
+    real* y = (real*) malloc(sizeof(real)*n);
+
+    //Se descuenta del lado derecho el aporte de los nodos con condición de Dirichlet
+    for(int i = 0; i < n; i++) x[i] = 0;
+    op->apply(x, y, Td);
+    for(int i = 0; i < n; i++){
+        b[i] -= y[i];
+        SDDS<real>::extract(T, i, 0, &x[i]);
+    }
+
+    float residual;
+    int iterations;
+    if(opts->solver == SOLVER_GMG)
+        iterations = hierarchy->solve(b, x, opts->cg_tolerance, 200, &residual);
+    else{
+        MultigridPreconditioner* P = new MultigridPreconditioner(hierarchy);
+        iterations = Iterative::conjugate_gradient(hierarchy, P, b, x, n, opts->cg_tolerance, 200, &residual);
+        delete P;
+    }
+    LOG_PROGRESS("\t" << ((opts->solver == SOLVER_GMG) ? "V-cycles" : "Conjugate gradient") << ": " << iterations << " iterations, relative residual " << residual << "\n");
+    if(!(residual <= opts->cg_tolerance))
+        cerr << "Warning: the iterative solver stopped at relative residual " << residual << ", above the requested tolerance.\n";
+
+    for(int i = 0; i < n; i++) SDDS<real>::insert(T, i, 0, x[i]);
+
+    free(x); free(y); free(b);
+    delete hierarchy;
+    delete op;
+}
+
+/*
+    Estructura DistributedProblem utilizada para compartir con los subdominios
+    de la solución distribuida los datos del problema completo: la malla <G>,
+    la división <part> de sus elementos y los dueños <owner> de sus nodos, junto
+    con los mismos datos que recibe matrix_free_loop(). Únicamente el subdominio
+    0 modifica <T> y <T_full> y escribe los resultados.
+*/
+typedef struct DistributedProblem{
+    Mesh* G;
+    int* part;
+    int* owner;
+    DS<real>* T;
+    DS<real>* T_full;
+    DS<int>* dirichlet_indices;
+    ofstream* postResFile;
+    float t;
+    float dt;
+    int* step;
+    Options* opts;
+} DistributedProblem;
+
+/*
+    Procedimiento que ejecuta un subdominio de la solución distribuida, con
+    <comm> como su comunicador y <context> como el DistributedProblem común.
+
+    El subdominio construye su propia malla con Mesh::submesh() y ensambla su
+    sistema con build_global_system(), es decir, con FEM::assembly() sobre sus
+    propios elementos y con sus propias condiciones de contorno, y lo almacena en
+    formato disperso. Las matrices K y M globales son la suma de las de todos los
+    subdominios, por lo que ningún subdominio las construye completas.
+
+    En el análisis estacionario se resuelve K * T = b con gradiente conjugado
+    distribuido, precondicionado con Jacobi. En el transitorio se avanza con
+    Forward Euler y paso de tiempo fijo, igual que el ciclo principal, resolviendo
+    en cada paso:
+
+                M * delta = delta_t * ( b - K * T^i ),      T^(i+1) = T^i + delta
+
+    también con gradiente conjugado distribuido, partiendo del delta del paso
+    anterior. M está bien condicionada, por lo que bastan pocas iteraciones.
+
+    Cada resultado se reúne en el subdominio 0, que lo escribe en el archivo de
+    salida y guarda los checkpoints.
+*/
+void distributed_worker(Communicator* comm, void* context){
+    DistributedProblem* problem = (DistributedProblem*) context;
+    Mesh* G = problem->G;
+    Options* opts = problem->opts;
+    bool root = comm->rank() == 0;
+    //Únicamente el subdominio 0 muestra mensajes de progreso
+    if(!root) Log::set_level(LEVEL_QUIET);
+
+    bool steady = G->get_analysis() == STEADY;
+    float Td = G->get_parameter(DIRICHLET_VALUE);
+    float tf = G->get_parameter(FINAL_TIME);
+    float t = problem->t, dt = problem->dt;
+    int step = *(problem->step);
+
+    //Malla, interfaz y sistema del subdominio
+    int* global_ids;
+    Mesh* sub = G->submesh(problem->part, problem->owner, comm->rank(), &global_ids);
+    Interface* I = new Interface(comm, G, problem->part, problem->owner, sub, global_ids);
+    int shared = (int) comm->sum((double) I->owned_interface());
+    LOG_PROGRESS("\t" << comm->size() << " subdomains, " << shared << " of " << I->global_size() << " free nodes on the interface\n");
+
+    DS<real> *T_N, *M, *K, *b;
+    DS<int> *neumann_indices, *dirichlet_indices;
+    SDDS<real>::create(&T_N, sub->get_quantity(NUM_NODES), 1, MATRIX);
+    SDDS<int>::create(&neumann_indices, sub->get_quantity(NUM_NEUMANN_BCs), ARRAY);
+    sub->get_condition_indices(neumann_indices, NEUMANN);
+    FEM::built_T_Neumann(T_N, sub->get_parameter(NEUMANN_VALUE), neumann_indices);
+    SDDS<int>::create(&dirichlet_indices, BINARY_SEARCH_TREE, true);
+    sub->get_condition_indices(dirichlet_indices, DIRICHLET);
+
+    build_global_system(sub, T_N, dirichlet_indices, steady ? NULL : &M, &K, &b);
+
+    int n = I->size();
+    SparseMatrix* K_sparse;
+    real* rhs = (real*) malloc(sizeof(real)*n);
+    real* x = (real*) malloc(sizeof(real)*n);
+    {
+        ScopedTimer timer(PHASE_ASSEMBLY);
+        K_sparse = new SparseMatrix(K);
+        //El vector b del subdominio es parcial, se completa con la interfaz
+        for(int i = 0; i < n; i++) SDDS<real>::extract(b, i, 0, &rhs[i]);
+        I->assemble(rhs);
+    }
+    I->scatter(problem->T, x);
+    DistributedOperator* K_op = new DistributedOperator(K_sparse, I);
+
+    if(steady){
+        {
+            ScopedTimer timer(PHASE_SOLVE);
+            JacobiPreconditioner* P = new JacobiPreconditioner(K_op);
+            float residual;
+            int iterations = Distributed::conjugate_gradient(K_op, P, rhs, x, opts->cg_tolerance, 10*I->global_size(), &residual);
+            LOG_PROGRESS("\tConjugate gradient: " << iterations << " iterations, relative residual " << residual << "\n");
+            if(root && !(residual <= opts->cg_tolerance))
+                cerr << "Warning: the conjugate gradient did not reach the requested tolerance.\n";
+            delete P;
+        }
+
+        ScopedTimer timer(PHASE_OUTPUT);
+        I->gather(x, root ? problem->T : NULL);
+        if(root){
+            FEM::build_full_T(problem->T_full, problem->T, Td, problem->dirichlet_indices);
+            write_output_step(problem->postResFile, problem->T_full, step+1, G->get_numbering());
+        }
+        step++;
+    }
+    else{
+        SparseMatrix* M_sparse;
+        {
+            ScopedTimer timer(PHASE_ASSEMBLY);
+            M_sparse = new SparseMatrix(M);
+        }
+        DistributedOperator* M_op = new DistributedOperator(M_sparse, I);
+        JacobiPreconditioner* P = new JacobiPreconditioner(M_op);
+        real* y = (real*) malloc(sizeof(real)*n);
+        real* delta = (real*) calloc(n, sizeof(real));
+
+        while( t <= tf ){
+            LOG_PROGRESS("\tStep " << step << ": working at TIME = " << t << "s\n");
+            {
+                ScopedTimer timer(PHASE_SOLVE);
+                //delta_t * ( b - K * T ), en y
+                K_op->apply(x, y);
+                for(int i = 0; i < n; i++) y[i] = dt*(rhs[i] - y[i]);
+                Perf::count_flops(2LL*n);
+
+                float residual;
+                int iterations = Distributed::conjugate_gradient(M_op, P, y, delta, opts->cg_tolerance, 10*I->global_size(), &residual);
+                LOG_PROGRESS("\tConjugate gradient: " << iterations << " iterations, relative residual " << residual << "\n");
+                if(root && !(residual <= opts->cg_tolerance))
+                    cerr << "Warning: the conjugate gradient did not reach the requested tolerance.\n";
+                for(int i = 0; i < n; i++) x[i] += delta[i];
+            }
+
+            {
+                ScopedTimer timer(PHASE_OUTPUT);
+                I->gather(x, root ? problem->T : NULL);
+                if(root){
+                    FEM::build_full_T(problem->T_full, problem->T, Td, problem->dirichlet_indices);
+                    write_output_step(problem->postResFile, problem->T_full, step+1, G->get_numbering());
+                    problem->postResFile->flush();
+                }
+                step++;
+            }
+
+            t = t + dt;
+
+            //Cada <checkpoint_every> pasos se guarda el estado del proceso
+            if(root && opts->checkpoint_every > 0 && (step-1) % opts->checkpoint_every == 0){
+                ScopedTimer timer(PHASE_OUTPUT);
+                write_checkpoint(opts->filename, problem->T, t, dt, step, (long) problem->postResFile->tellp(), opts->renumber);
+            }
+        }
+
+        free(y); free(delta);
+        delete P;
+        delete M_op;
+        delete M_sparse;
+        SDDS<real>::destroy(M);
+    }
+
+    if(root) *(problem->step) = step;
+
+    free(rhs); free(x); free(global_ids);
+    delete K_op;
+    delete K_sparse;
+    delete I;
+    delete sub;
+    SDDS<real>::destroy(K); SDDS<real>::destroy(b); SDDS<real>::destroy(T_N);
+    SDDS<int>::destroy(neumann_indices); SDDS<int>::destroy(dirichlet_indices);
+}
+
+/*
+    Procedimiento que resuelve el problema dividiendo la malla <G> en la cantidad
+    de subdominios indicada en <opts> (ver Mesh::partition()), y ejecutando cada
+    uno con distributed_worker(), en un hilo o en un proceso de MPI según la
+    implementación de Communicator.
+
+    Se reciben los mismos datos que matrix_free_loop(), con <t> como el tiempo del
+    siguiente paso a calcular.
+*/
+void distributed_loop(Mesh* G, DS<real>* T, DS<real>* T_full, DS<int>* dirichlet_indices, ofstream* postResFile, float t, float dt, int* step, Options* opts){
+    DistributedProblem problem;
+    {
+        ScopedTimer timer(PHASE_MESH_READ);
+        problem.part = G->partition(opts->partitions);
+        problem.owner = G->node_owners(problem.part);
+    }
+    problem.G = G;
+    problem.T = T;
+    problem.T_full = T_full;
+    problem.dirichlet_indices = dirichlet_indices;
+    problem.postResFile = postResFile;
+    problem.t = t;
+    problem.dt = dt;
+    problem.step = step;
+    problem.opts = opts;
+
+    Communicator::run(opts->partitions, distributed_worker, &problem);
+
+    free(problem.part);
+    free(problem.owner);
+}
+
+/*
+    Procedimiento que coloca en los archivos de salida <files> de un barrido de
+    parámetros los resultados de un paso para todos los casos.
+
+    Se recibe <T> como la matriz de temperaturas de los "nodos libres", con una
+    columna por caso, y <cases> como la tabla de casos, de la cual se extrae el
+    valor de Dirichlet de cada uno. <T_case> y <T_full> son vectores columna
+    auxiliares de los nodos libres y de todos los nodos respectivamente.
+*/
+void write_sweep_step(ofstream* files, DS<real>* T, DS<float>* cases, DS<real>* T_case, DS<real>* T_full, DS<int>* dirichlet_indices, int step, DS<int>* numbering){
+    int free_nodes, ncases;
+    SDDS<real>::extension(T, &free_nodes, &ncases);
+
+    for(int c = 0; c < ncases; c++){
+        //Se extrae la columna del caso actual
+        real value;
+        float Td;
+        for(int i = 0; i < free_nodes; i++){
+            SDDS<real>::extract(T, i, c, &value);
+            SDDS<real>::insert(T_case, i, 0, value);
+        }
+        SDDS<float>::extract(cases, c, SWEEP_DIRICHLET_VALUE, &Td);
+
+        //Se construyen y escriben los resultados completos del caso
+        FEM::build_full_T(T_full, T_case, Td, dirichlet_indices);
+        write_output_step(&files[c], T_full, step, numbering);
+        files[c].flush();
+    }
+}
+
+/*
+    Procedimiento que resuelve en un solo proceso todos los casos de la tabla de
+    barrido de parámetros indicada en <opts>, sobre la malla <G>. Se retorna la
+    cantidad de resultados escritos para cada caso.
+
+    Los casos difieren únicamente en la fuente de calor Q, el valor de Dirichlet
+    Td, el valor de Neumann Tn y la temperatura inicial, ninguno de los cuales
+    afecta a M ni a K, por lo que ambas matrices se ensamblan, se reducen y se
+    factorizan una sola vez. Además, el vector b es lineal en Q, Tn y Td:
+
+            b = Q * b_Q + Tn * b_N + Td * b_D
+
+    Donde b_Q es el vector b ensamblado con una fuente de calor unitaria, b_N es el
+    vector de Neumann con valor unitario, y b_D es el vector adicional de Dirichlet
+    (-K_fd * 1) con valor unitario, todos ya reducidos a los "nodos libres". Así,
+    los tres vectores se construyen una sola vez, y el vector b de cada caso es una
+    combinación de ellos.
+
+    Los vectores b y T de todos los casos se colocan como columnas de las matrices
+    B y T, de modo que todos los casos avanzan juntos en el tiempo, con un solo
+    producto K * T y una sola sustitución con la factorización de M por paso:
+
+            T^(i+1) = T^i + M^(-1) * delta_t * ( B - K * T^i )
+
+    En el análisis estacionario se resuelve una sola vez K * T = B.
+*/
+int sweep_loop(Mesh* G, Options* opts){
+    int nelems = G->get_quantity(NUM_ELEMENTS);
+    int nnodes = G->get_quantity(NUM_NODES);
+    int free_nodes = nnodes - G->get_quantity(NUM_DIRICHLET_BCs);
+    bool steady = G->get_analysis() == STEADY;
+
+    //Se obtiene la tabla de casos
+    DS<float>* cases = read_sweep_file(opts->sweep_file);
+    int ncases, ncols;
+    SDDS<float>::extension(cases, &ncases, &ncols);
+    LOG_PROGRESS("OK\nSweeping " << ncases << " parameter sets... ");
+
+    //Se preparan los índices de las condiciones de contorno, al igual que en el procedimiento principal
+    DS<int> *dirichlet_indices, *neumann_indices;
+    SDDS<int>::create(&neumann_indices, G->get_quantity(NUM_NEUMANN_BCs), ARRAY);
+    G->get_condition_indices(neumann_indices, NEUMANN);
+    SDDS<int>::create(&dirichlet_indices, BINARY_SEARCH_TREE, true);
+    G->get_condition_indices(dirichlet_indices, DIRICHLET);
+
+    //Se ensamblan M, K y b_Q, calculando y ensamblando cada sistema local a la vez
+    DS<real> *M, *K, *b_Q, *b_N, *b_D;
+    {
+        ScopedTimer timer(PHASE_ASSEMBLY);
+        if(!steady){ SDDS<real>::create(&M, nnodes, nnodes, MATRIX); Math::zeroes(M); }
+        SDDS<real>::create(&K, nnodes, nnodes, MATRIX);   Math::zeroes(K);
+        SDDS<real>::create(&b_Q, nnodes, 1, MATRIX);      Math::zeroes(b_Q);
+
+        for(int e = 0; e < nelems; e++){
+            Element* current_elem = G->get_element(e+1);
+            DS<real>* local;
+            if(!steady){
+                local = FEM::calculate_local_M<real>(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT), current_elem);
+                FEM::assembly(M, local, current_elem, true);
+                SDDS<real>::destroy(local);
+            }
+            local = FEM::calculate_local_K<real>(G->get_parameter(THERMAL_CONDUCTIVITY), current_elem);
+            FEM::assembly(K, local, current_elem, true);
+            SDDS<real>::destroy(local);
+            local = FEM::calculate_local_b<real>(1, current_elem);
+            FEM::assembly(b_Q, local, current_elem, false);
+            SDDS<real>::destroy(local);
+        }
+    }
+
+    {
+        ScopedTimer timer(PHASE_NEUMANN);
+        SDDS<real>::create(&b_N, nnodes, 1, MATRIX);
+        FEM::built_T_Neumann(b_N, 1, neumann_indices);
+    }
+
+    {
+        ScopedTimer timer(PHASE_DIRICHLET);
+        //Con Td = 0 la aplicación de Dirichlet a un vector solo lo reduce, y sobre un
+        //vector nulo con Td = 1 produce el vector adicional unitario
+        SDDS<real>::create(&b_D, nnodes, 1, MATRIX); Math::zeroes(b_D);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &b_Q, K, 0, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &b_N, K, 0, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &b_D, K, 1, dirichlet_indices);
+        FEM::apply_Dirichlet(nnodes, free_nodes, &K, dirichlet_indices);
+        if(!steady) FEM::apply_Dirichlet(nnodes, free_nodes, &M, dirichlet_indices);
+    }
+
+    //Se construyen B y las temperaturas iniciales de todos los casos
+    DS<real> *B, *T;
+    SDDS<real>::create(&B, free_nodes, ncases, MATRIX);
+    SDDS<real>::create(&T, free_nodes, ncases, MATRIX);
+    for(int c = 0; c < ncases; c++){
+        float Q, Td, Tn, T0;
+        real q, n, d;
+        SDDS<float>::extract(cases, c, SWEEP_HEAT_SOURCE, &Q);
+        SDDS<float>::extract(cases, c, SWEEP_DIRICHLET_VALUE, &Td);
+        SDDS<float>::extract(cases, c, SWEEP_NEUMANN_VALUE, &Tn);
+        SDDS<float>::extract(cases, c, SWEEP_INITIAL_TEMPERATURE, &T0);
+        for(int i = 0; i < free_nodes; i++){
+            SDDS<real>::extract(b_Q, i, 0, &q);
+            SDDS<real>::extract(b_N, i, 0, &n);
+            SDDS<real>::extract(b_D, i, 0, &d);
+            SDDS<real>::insert(B, i, c, Q*q + Tn*n + Td*d);
+            SDDS<real>::insert(T, i, c, T0);
+        }
+    }
+    SDDS<real>::destroy(b_Q); SDDS<real>::destroy(b_N); SDDS<real>::destroy(b_D);
+
+    //Se abre un archivo de salida por caso
+    ofstream* files = new ofstream[ncases];
+    for(int c = 0; c < ncases; c++){
+        string name = string(opts->filename) + "_" + to_string(c+1);
+        open_output_file(&files[c], name.data(), 0);
+    }
+
+    DS<real> *T_case, *T_full;
+    SDDS<real>::create(&T_case, free_nodes, 1, MATRIX);
+    SDDS<real>::create(&T_full, nnodes, 1, MATRIX);
+    int step = 0;
+
+    if(steady){
+        LOG_PROGRESS("OK\n\nSolving steady state...\n");
+        {
+            //Todos los casos se resuelven a la vez con un solo solucionador de K
+            ScopedTimer timer(PHASE_SOLVE);
+            solve_stiffness(K, B, opts);
+            Math::zeroes(T);
+            Math::sum_in_place(T, B);
+        }
+        ScopedTimer timer(PHASE_OUTPUT);
+        write_sweep_step(files, T, cases, T_case, T_full, dirichlet_indices, ++step, G->get_numbering());
+    }
+    else{
+        {
+            ScopedTimer timer(PHASE_OUTPUT);
+            write_sweep_step(files, T, cases, T_case, T_full, dirichlet_indices, ++step, G->get_numbering());
+        }
+
+        //Se factoriza la matriz M una sola vez para todos los pasos y todos los casos
+        Skyline* factor;
+        {
+            ScopedTimer timer(PHASE_SOLVE);
+            factor = new Skyline(M);
+            if(!factor->factorize()){
+                cerr << "The mass matrix is not positive definite. :(\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        LOG_PROGRESS("OK\n\nObtaining time parameters and starting loop...\n");
+
+        float dt = G->get_parameter(TIME_STEP);
+        float t = G->get_parameter(INITIAL_TIME) + dt;
+        float tf = G->get_parameter(FINAL_TIME);
+        while( t <= tf ){
+            LOG_PROGRESS("\tStep " << step << ": working at TIME = " << t << "s\n");
+            {
+                ScopedTimer timer(PHASE_SOLVE);
+                //Se calcula M^(-1) * delta_t * ( B - K * T ) para todos los casos a la vez
+                DS<real>* temp = Lazy::evaluate(dt*(Lazy::of(B) - Lazy::of(K)*Lazy::of(T)));
+                factor->solve(temp);
+                Math::sum_in_place(T, temp);
+                SDDS<real>::destroy(temp);
+            }
+            {
+                ScopedTimer timer(PHASE_OUTPUT);
+                write_sweep_step(files, T, cases, T_case, T_full, dirichlet_indices, ++step, G->get_numbering());
+            }
+            t = t + dt;
+        }
+        delete factor;
+    }
+
+    LOG_PROGRESS("\nClosing output files... ");
+    for(int c = 0; c < ncases; c++) files[c].close();
+    delete[] files;
+
+    //Se libera el espacio en memoria de todas las estructuras del barrido
+    if(!steady) SDDS<real>::destroy(M);
+    SDDS<real>::destroy(K); SDDS<real>::destroy(B); SDDS<real>::destroy(T);
+    SDDS<real>::destroy(T_case); SDDS<real>::destroy(T_full); SDDS<float>::destroy(cases);
+    SDDS<int>::destroy(dirichlet_indices); SDDS<int>::destroy(neumann_indices);
+
+    return step;
 }
 
 /*
@@ -79,30 +1077,119 @@ void free_list(DS<DS<float>*>* L){
 
     Se hace uso de la clase utilitaria FEM para todos los procedimientos propios
     del Método de los Elementos Finitos en 2D.
+
+    Si el archivo de entrada o la opción --steady solicitan un análisis
+    estacionario, no se avanza en el tiempo: se resuelve una única vez el
+    sistema K * T = b, y el archivo de salida contiene un único resultado.
+
+    Con la opción --adaptive, el paso de tiempo se ajusta en cada paso de
+    acuerdo a una estimación del error, y el proceso termina en cuanto se
+    alcanza el estado estacionario (ver adaptive_loop()).
+
+    Con la opción --matrix-free, la matriz K no se ensambla y sus productos se
+    calculan elemento por elemento (ver matrix_free_loop()).
+
+    Con la opción --partitions, la malla se divide en subdominios que ensamblan
+    y resuelven el sistema de forma distribuida (ver distributed_loop()).
+
+    Con la opción --solver, el sistema del análisis estacionario se resuelve con
+    multigrid algebraico en lugar de Cholesky (ver solve_stiffness()).
+
+    Con la opción --refine, el problema se resuelve sobre una malla más fina que
+    la del archivo de entrada, obtenida dividiendo cada triángulo en cuatro, y con
+    --solver gmg su estado estacionario se resuelve con multigrid geométrico sobre
+    todas las mallas intermedias (ver geometric_multigrid_solve()).
+
+    Con la opción --sweep, en lugar del problema del archivo de entrada se
+    resuelven todos los casos de una tabla de parámetros (ver sweep_loop()).
+
+    Los resultados de cada tiempo se colocan en el archivo de salida conforme
+    se calculan, y cada cierta cantidad de pasos se guarda un checkpoint con
+    el estado del proceso, de modo que con la opción --restart un proceso
+    interrumpido se reanude desde el último checkpoint en lugar de comenzar
+    desde cero.
+
+    Cada fase del proceso se mide con la clase utilitaria Perf, y al finalizar
+    se genera un reporte de desempeño en el archivo <filename>.perf.json.
 */
 int main(int argc, char** argv){
 
-    cout << "Initializing process...\nCreating auxiliar variables... ";
+    //Se inicia el entorno de comunicación de la solución distribuida (MPI, si se compiló con él)
+    Communicator::initialize(&argc, &argv);
+    //Se interpretan las opciones recibidas en la línea de comandos
+    Options opts = parse_options(argc, argv);
+    //Con varios procesos de MPI, únicamente el proceso principal muestra mensajes y escribe archivos
+    if(!Communicator::is_root()) opts.verbosity = LEVEL_QUIET;
+    if(Communicator::processes() > 1 && opts.partitions != Communicator::processes()){
+        cerr << "Running on " << Communicator::processes() << " MPI processes requires --partitions " << Communicator::processes() << ". :(\n";
+        exit(EXIT_FAILURE);
+    }
+    //Se define el nivel de detalle de los mensajes del proceso
+    Log::set_level(opts.verbosity);
+    //Los mensajes no se mezclan con salida de C, por lo que se evita el costo
+    //de sincronizar cout con stdio en cada operación
+    ios::sync_with_stdio(false);
+
+    LOG_PROGRESS("Initializing process...\nCreating auxiliar variables... ");
     
-    DS<float> *T, *T_full, *T_N, *M, *K, *b;
+    DS<real> *T, *T_full, *T_N, *M, *K, *b;
     DS<int> *dirichlet_indices, *neumann_indices;
 
-    DS<DS<float>*> *Result,*M_locals,*K_locals,*b_locals;
-
-    //Se crea la lista para almacenar los resultados de cada tiempo
-    SDDS<DS<float>*>::create(&Result,SINGLE_LINKED_LIST);
-
-    cout << "OK\nReading input file and creating geometry object... ";
+    LOG_PROGRESS("OK\nReading input file and creating geometry object... ");
 
     //Se instancia un objeto Mesh
     Mesh* G = new Mesh();
-    //Se recibe en la línea de comando como segundo parámetro el nombre del
-    //archivo de entrada sin extensión, se envía este dato junto con el objeto
-    //Mesh para obtener todos los datos de la malla, la geometría y el problema
-    //en general
-    read_input_file(G, argv[1]);
+    //Se recibe en la línea de comando el nombre del archivo de entrada sin
+    //extensión, se envía este dato junto con el objeto Mesh para obtener todos
+    //los datos de la malla, la geometría y el problema en general
+    {
+        ScopedTimer timer(PHASE_MESH_READ);
+        read_input_file(G, opts.filename);
+    }
+    //La opción --steady solicita el análisis estacionario aunque el archivo de entrada no lo indique
+    if(opts.steady) G->set_analysis(STEADY);
+    bool steady = G->get_analysis() == STEADY;
+
+    //Si se solicitó, se refina la malla <refine> veces, conservando todas las mallas
+    //intermedias para el multigrid geométrico. El proceso continúa sobre la malla más
+    //fina, que se escribe en el archivo de malla de post-proceso para GiD
+    int nmeshes = opts.refine + 1;
+    Mesh** meshes = (Mesh**) malloc(sizeof(Mesh*)*nmeshes);
+    int** parents = (int**) malloc(sizeof(int*)*nmeshes);
+    meshes[0] = G;
+    if(opts.refine > 0){
+        LOG_PROGRESS("OK\nRefining mesh... ");
+        ScopedTimer timer(PHASE_MESH_READ);
+        for(int m = 1; m < nmeshes; m++)
+            meshes[m] = meshes[m-1]->refine(&parents[m-1]);
+        G = meshes[nmeshes-1];
+        if(Communicator::is_root()) write_post_mesh(G, opts.filename);
+        LOG_PROGRESS(meshes[0]->get_quantity(NUM_NODES) << " -> " << G->get_quantity(NUM_NODES) << " nodes ");
+    }
+
+    //Si se solicitó, se renumeran los nodos para reducir el ancho de banda de las
+    //matrices globales. Los resultados se escriben luego con los IDs de GiD
+    if(opts.renumber){
+        LOG_PROGRESS("OK\nRenumbering nodes (Reverse Cuthill-McKee)... ");
+        ScopedTimer timer(PHASE_MESH_READ);
+        int before = G->bandwidth();
+        G->renumber_nodes();
+        LOG_PROGRESS("bandwidth " << before << " -> " << G->bandwidth() << " ");
+    }
+
+    //En un barrido de parámetros, los casos se resuelven con un proceso propio
+    if(opts.sweep_file != NULL){
+        int step = sweep_loop(G, &opts);
+        LOG_PROGRESS("OK\n");
+        if(Log::enabled(LEVEL_PROGRESS)) Perf::show_summary(cout);
+        Perf::write_json(opts.filename, G->get_quantity(NUM_NODES), G->get_quantity(NUM_ELEMENTS), step);
+        free_meshes(meshes, parents, nmeshes);
+        LOG_PROGRESS("\nHave a nice day!! :D\n");
+        Communicator::finalize();
+        return 0;
+    }
 
-    cout << "OK\nCreating temperature vectors... ";
+    LOG_PROGRESS("OK\nCreating temperature vectors... ");
 
     int nelems = G->get_quantity(NUM_ELEMENTS); //Se extrae la cantidad de elementos en la malla
     int nnodes = G->get_quantity(NUM_NODES);    //Se extrae la cantidad de nodos en la malla
@@ -113,17 +1200,17 @@ int main(int argc, char** argv){
     //Se define <T> como el vector columna para almacenar los resultados de un tiempo, los
     //cuales se calculan únicamente para los "nodos libres"
     //Su cantidad de filas es igual a la cantidad de "nodos libres"
-    SDDS<float>::create(&T, free_nodes, 1, MATRIX);
+    SDDS<real>::create(&T, free_nodes, 1, MATRIX);
     //Se define <T_full> como el vector columna para almacenar los resultados completos de un
     //tiempo, que incluyen tanto a los "nodos libres" como a los nodos que tienen condición de
     //Dirichlet
     //Su cantidad de filas es igual a la cantidad de nodos en la malla
-    SDDS<float>::create(&T_full, nnodes, 1, MATRIX);
+    SDDS<real>::create(&T_full, nnodes, 1, MATRIX);
     //Se define <T_N> como el vector columna para almacenar los valores de condición de Neumann indicados
     //Su cantidad de filas es igual a la cantidad de nodos en la malla
-    SDDS<float>::create(&T_N, nnodes, 1, MATRIX);
+    SDDS<real>::create(&T_N, nnodes, 1, MATRIX);
 
-    cout << "OK\nInitializing temperature vectors... ";
+    LOG_PROGRESS("OK\nInitializing temperature vectors... ");
     
     //Se llena <T> con el valor de temperatura inicial proporcionado para todos los nodos, por lo
     //que de momento pasa a constituir el vector columna de temperaturas inicial
@@ -140,11 +1227,11 @@ int main(int argc, char** argv){
     //  - Para todos los demás nodos, se les coloca un 0.
     FEM::built_T_Neumann(T_N, G->get_parameter(NEUMANN_VALUE), neumann_indices);
 
-    //Se define <dirichlet_indices> como un arreglo de enteros para almacenar los IDs de todos
-    //los nodos que tienen asignada una condición de Dirichlet
-    //Su longitud es igual a la cantidad de nodos con condición de Dirichlet
-    SDDS<int>::create(&dirichlet_indices, G->get_quantity(NUM_DIRICHLET_BCs), ARRAY);
-    //Se llena el arreglo con los IDs de los nodos con condición de Dirichlet
+    //Se define <dirichlet_indices> como un árbol binario de búsqueda balanceado para almacenar
+    //los IDs de todos los nodos que tienen asignada una condición de Dirichlet, ya que el proceso
+    //solo consulta si un ID pertenece o no al conjunto, y el árbol lo resuelve en tiempo logarítmico
+    SDDS<int>::create(&dirichlet_indices, BINARY_SEARCH_TREE, true);
+    //Se llena el árbol con los IDs de los nodos con condición de Dirichlet
     G->get_condition_indices(dirichlet_indices, DIRICHLET);
     float Td = G->get_parameter(DIRICHLET_VALUE); //Se extrae el valor para las condiciones de Dirichlet
     //Se construye el vector columna inicial de temperaturas completo:
@@ -153,174 +1240,234 @@ int main(int argc, char** argv){
     //    con el valor de temperatura inicial proporcionado.
     FEM::build_full_T(T_full, T, Td, dirichlet_indices);
 
-    cout << "OK\nInitializing list of results... ";
-
-    //Se coloca la matriz de resultados inicial completa como primer elemento de la lista de resultados
-    FEM::append_results(Result, T_full);
-
-    cout << "OK\n\nObtaining time parameters and starting loop...\n";
-
     float dt = G->get_parameter(TIME_STEP);    //Se extrae el paso de tiempo
     float t = G->get_parameter(INITIAL_TIME);  //Se extrae el tiempo inicial
     //Avanzamos al primer tiempo a calcular
     t += dt;
     float tf = G->get_parameter(FINAL_TIME);   //Se extrae el tiempo final
 
-    //Comienza el ciclo de ejecución, el cual continúa hasta alcanzar el tiempo final
-    while( t <= tf ){
+    //<step> lleva la cantidad de resultados escritos en el archivo de salida, y
+    //<offset> la cantidad de bytes válidos del archivo de salida hasta ese momento
+    int step = 0;
+    long offset = 0;
+
+    //Si se solicitó reanudar el proceso, se recuperan <T>, <t>, <step> y <offset>
+    //del último checkpoint. El análisis estacionario no guarda checkpoints
+    if(opts.restart && !steady){
+        LOG_PROGRESS("OK\nRestoring state from last checkpoint... ");
+        if(!read_checkpoint(opts.filename, T, opts.renumber, &t, &dt, &step, &offset)){
+            cerr << "Problem reading the checkpoint file. :(\n";
+            exit(EXIT_FAILURE);
+        }
+        LOG_PROGRESS("resuming at TIME = " << t << "s ");
+    }
 
-        cout << "\tWorking at TIME = " << t << "s:\n\n";
-        
-        //Se preparan los arreglos para almacenar todas las matrices locales de todos los elementos
-        //La longitud de los 3 arreglos es igual a la cantidad de elementos
-        SDDS<DS<float>*>::create(&M_locals, nelems, ARRAY);
-        SDDS<DS<float>*>::create(&K_locals, nelems, ARRAY);
-        SDDS<DS<float>*>::create(&b_locals, nelems, ARRAY);
+    LOG_PROGRESS("OK\nOpening output file... ");
 
-        //Se recorren los elementos
-        for(int e = 0; e < nelems; e++){
-            cout << "\t\tWorking with ELEMENT = " << e+1 << ":\n";
-            //Se interpreta el contador como un ID de elemento, con la salvedad
-            //que el contador comienza en 0 y los IDs comienzan en 1
+    //Se abre el archivo de salida, recortándolo al último resultado del checkpoint
+    //si se está reanudando el proceso
+    ofstream postResFile;
+    if(Communicator::is_root()) open_output_file(&postResFile, opts.filename, offset);
 
-            //Se extrae el elemento actual, se envía e+1 para compensar la diferencia en los conteos
-            Element* current_elem = G->get_element(e+1);
+    if(steady && (opts.solver == SOLVER_GMG || opts.solver == SOLVER_GMG_CG)){
+        LOG_PROGRESS("OK\n\nSolving steady state with geometric multigrid...\n");
+        geometric_multigrid_solve(meshes, parents, nmeshes, T, T_N, dirichlet_indices, &opts);
+        {
+            ScopedTimer timer(PHASE_OUTPUT);
+            FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+            write_output_step(&postResFile, T_full, ++step, G->get_numbering());
+        }
+    }
+    else if(opts.partitions > 0){
+        //En un proceso transitorio nuevo, los resultados iniciales completos son el primer resultado
+        if(!steady && step == 0){
+            ScopedTimer timer(PHASE_OUTPUT);
+            if(Communicator::is_root()){
+                write_output_step(&postResFile, T_full, step+1, G->get_numbering());
+                postResFile.flush();
+            }
+            step++;
+        }
 
-            cout << "\t\tCalculating local systems... ";
-            //Se calcula la M local y se añade al listado de matrices M. Se envían la densidad y el calor específico del material
+        LOG_PROGRESS("OK\n\nSolving on " << opts.partitions << " subdomains...\n");
+        distributed_loop(G, T, T_full, dirichlet_indices, &postResFile, t, dt, &step, &opts);
+    }
+    else if(opts.matrix_free){
+        //En un proceso transitorio nuevo, los resultados iniciales completos son el primer resultado
+        if(!steady && step == 0){
+            ScopedTimer timer(PHASE_OUTPUT);
+            write_output_step(&postResFile, T_full, ++step, G->get_numbering());
+            postResFile.flush();
+        }
+
+        LOG_PROGRESS("OK\n\nSolving without assembling K (matrix-free)...\n");
+        matrix_free_loop(G, T, T_full, T_N, dirichlet_indices, &postResFile, t, dt, &step, &opts);
+    }
+    else if(steady){
+        LOG_PROGRESS("OK\n\nSolving steady state...\n");
+
+        //Se construye el sistema global, sin la matriz M ya que no interviene
+        build_global_system(G, T_N, dirichlet_indices, NULL, &K, &b);
+
+        LOG_DEBUG("\tSolving K * T = b... ");
+        {
+            ScopedTimer timer(PHASE_SOLVE);
+            /*
+                En el estado estacionario la temperatura ya no cambia en el tiempo, por lo que la
+                ecuación de transferencia de calor se reduce a:
+
+                            K * T = b
+
+                Se resuelve con el solucionador indicado en las opciones, por defecto con la
+                factorización de Cholesky de K en almacenamiento skyline.
+            */
+            solve_stiffness(K, b, &opts);
+            //La solución queda en b, y se coloca en <T>
+            Math::zeroes(T);
+            Math::sum_in_place(T, b);
+        }
 
-            //FEM::calculate_local_M(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT), current_elem)
+        LOG_DEBUG("OK\n\n\tWriting results... ");
+        {
+            ScopedTimer timer(PHASE_OUTPUT);
+            //Los resultados del estado estacionario son el único resultado del archivo de salida
+            FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+            write_output_step(&postResFile, T_full, ++step, G->get_numbering());
+        }
+        LOG_DEBUG("OK\n\n");
 
-            SDDS<DS<float>*>::insert(M_locals, e, FEM::calculate_local_M(G->get_parameter(DENSITY), G->get_parameter(SPECIFIC_HEAT), current_elem));
-            //Se calcula la K local y se añade al listado de matrices K. Se envía la conductividad térmica del material
-            SDDS<DS<float>*>::insert(K_locals, e, FEM::calculate_local_K(G->get_parameter(THERMAL_CONDUCTIVITY), current_elem));
-            //Se calcula la b local y se añade al listado de matrices b. Se envía la fuente de calor
-            SDDS<DS<float>*>::insert(b_locals, e, FEM::calculate_local_b(G->get_parameter(HEAT_SOURCE), current_elem));
-            cout << "OK\n\n";
+        SDDS<real>::destroy(K);
+        SDDS<real>::destroy(b);
+    }
+    else{
+        //En un proceso nuevo, los resultados iniciales completos son el primer resultado
+        if(step == 0){
+            ScopedTimer timer(PHASE_OUTPUT);
+            write_output_step(&postResFile, T_full, ++step, G->get_numbering());
+            postResFile.flush();
         }
 
-        cout << "\tCreating global system...\n";
+        LOG_PROGRESS("OK\n\nObtaining time parameters and starting loop...\n");
+
+        //Con paso de tiempo adaptativo el ciclo de ejecución es propio
+        if(opts.adaptive)
+            adaptive_loop(G, T, T_full, T_N, dirichlet_indices, &postResFile, t, dt, &step, &opts);
+
+        //Con paso de tiempo fijo, el sistema global no cambia en el tiempo: M, K y b solo
+        //dependen de la malla y de las condiciones, por lo que se construyen una sola vez,
+        //al igual que la factorización de M, y cada paso únicamente resuelve con ella
+        Skyline* M_skyline = NULL;
+        if(!opts.adaptive){
+            build_global_system(G, T_N, dirichlet_indices, &M, &K, &b);
+
+            //En lugar de calcular la inversa de la matriz M, se resuelve el sistema M * x = b con la
+            //factorización de Cholesky de M en almacenamiento skyline, cuyo costo depende del ancho
+            //de banda de M y no de su tamaño completo
+            ScopedTimer timer(PHASE_SOLVE);
+            M_skyline = new Skyline(M);
+            if(!M_skyline->factorize()){
+                cerr << "The mass matrix is not positive definite. :(\n";
+                exit(EXIT_FAILURE);
+            }
+            //La factorización sustituye a M en todos los pasos
+            SDDS<real>::destroy(M);
+        }
 
-        //Se crean las matrices globales, y se inicializan todas sus posiciones con 0
-        SDDS<float>::create(&M, nnodes, nnodes, MATRIX); Math::zeroes(M);
-        SDDS<float>::create(&K, nnodes, nnodes, MATRIX); Math::zeroes(K);
-        SDDS<float>::create(&b, nnodes, 1, MATRIX);      Math::zeroes(b);
+        //Comienza el ciclo de ejecución con paso de tiempo fijo, el cual continúa hasta alcanzar el tiempo final
+        while( !opts.adaptive && t <= tf ){
 
-        //Se recorren los listados de matrices locales, un elemento a la vez
-        for(int e = 0; e < nelems; e++){
-            cout << "\t\tAssembling ELEMENT = " << e+1 << ":\n";
-            //Se extrae el elemento actual, se envía e+1 para compensar la diferencia en los conteos
-            Element* current_elem = G->get_element(e+1);
-            DS<float> *temp;
+            LOG_PROGRESS("\tStep " << step << ": working at TIME = " << t << "s\n");
 
-            cout << "\t\tAssembling local matrices... ";
-            //Se extrae la matriz M del elemento actual y se envía a ensamblaje
-            SDDS<DS<float>*>::extract(M_locals,e,&temp);
-            FEM::assembly(M, temp, current_elem, true);  //Se indica que ensamblará una matriz 3 x 3
+            LOG_DEBUG("\tCalculating temperature at next time step.\n\tUsing FEM generated formulas and Forward Euler... ");
 
-            //Se extrae la matriz K del elemento actual y se envía a ensamblaje
-            SDDS<DS<float>*>::extract(K_locals,e,&temp);
-            FEM::assembly(K, temp, current_elem, true);
+            /*
+                Se procede a ejecutar la ecuación de transferencia de calor en su versión discretizada con Forward Euler:
 
-            //Se extrae la matriz b del elemento actual y se envía a ensamblaje
-            SDDS<DS<float>*>::extract(b_locals,e,&temp);
-            FEM::assembly(b, temp, current_elem, false); //Se indica que ensamblará una matriz 3 x 1
-            cout << "OK\n\n";
-        }
+                            T^(i+1) = T^i + M^(-1) * delta_t * ( b - K * T^i )
 
-        cout << "\tApplying Neumann conditions... ";
-        //Se agrega la matriz de valores de Neumann a la matriz b global
-        Math::sum_in_place(b,T_N);
-        cout << "OK\n\n";
 
-        cout << "\tApplying Dirichlet conditions... ";
-        //Se modifican las matrices globales para aplicar las condiciones de Dirichlet
-        FEM::apply_Dirichlet(nnodes, free_nodes, &b, K, Td, dirichlet_indices);
-        FEM::apply_Dirichlet(nnodes, free_nodes, &K, dirichlet_indices);
-        FEM::apply_Dirichlet(nnodes, free_nodes, &M, dirichlet_indices);
-        cout << "OK\n\n";
 
-        cout << "\tCalculating temperature at next time step.\n\tUsing FEM generated formulas and Forward Euler... ";
 
-        /*
-            Se procede a ejecutar la ecuación de transferencia de calor en su versión discretizada con Forward Euler:
 
-                        T^(i+1) = T^i + M^(-1) * delta_t * ( b - K * T^i )
+                En la expresión anterior, a la matriz b ya se le han incorporado el vector columna de las condiciones
+                de Neumann, y el vector columna generado por la aplicación de las condiciones de Dirichlet.
+            */
 
+            {
+                ScopedTimer timer(PHASE_SOLVE);
+                //Se calcula delta_t * ( b - K * T ), donde T son las temperaturas en el tiempo actual, como una
+                //sola expresión diferida: cada fila del producto K * T se resta de b y se multiplica por delta_t
+                //en el mismo recorrido, sin construir una matriz temporal. El resultado se coloca en un vector
+                //nuevo, ya que b se reutiliza en los pasos siguientes
+                DS<real>* delta = Lazy::evaluate(dt*(Lazy::of(b) - Lazy::of(K)*Lazy::of(T)));
+                //La solución de M * x = delta queda en delta, y se añade a los resultados del tiempo actual,
+                //obteniendo así los resultados del siguiente tiempo
+                M_skyline->solve(delta);
+                Math::sum_in_place(T, delta);
+                SDDS<real>::destroy(delta);
+            }
 
+            LOG_DEBUG("OK\n\n\tWriting results... ");
 
+            {
+                ScopedTimer timer(PHASE_OUTPUT);
+                //Se construye la matriz de resultados completa para el tiempo actual
+                FEM::build_full_T(T_full, T, Td, dirichlet_indices);
+                //Se colocan los resultados completos del tiempo actual en el archivo de salida
+                write_output_step(&postResFile, T_full, ++step, G->get_numbering());
+                postResFile.flush();
+            }
 
+            LOG_DEBUG("OK\n\nAdvancing in time... ");
 
-            En la expresión anterior, a la matriz b ya se le han incorporado el vector columna de las condiciones
-            de Neumann, y el vector columna generado por la aplicación de las condiciones de Dirichlet.
-        */
+            //Avanzamos al siguiente tiempo a calcular
+            t = t + dt;
+
+            //Cada <checkpoint_every> pasos se guarda el estado del proceso, incluyendo
+            //la posición del cursor del archivo de salida tras el último resultado
+            if(opts.checkpoint_every > 0 && (step-1) % opts.checkpoint_every == 0){
+                LOG_DEBUG("OK\n\tSaving checkpoint... ");
+                ScopedTimer timer(PHASE_OUTPUT);
+                write_checkpoint(opts.filename, T, t, dt, step, (long) postResFile.tellp(), opts.renumber);
+            }
+
+            LOG_DEBUG("OK\n\n");
+        }
+
+        //Se libera el sistema global y la factorización de M
+        if(!opts.adaptive){
+            delete M_skyline;
+            SDDS<real>::destroy(K);
+            SDDS<real>::destroy(b);
+        }
+    }
 
-        //Se ejecuta K * T, donde T son las temperaturas en el tiempo actual
-        DS<float>* temp = Math::product(K,T);
-        //Se multiplica el contenido del resultado anterior por -1 para simular la resta
-        Math::product_in_place(temp, -1);
-        //Se suma el resultado de -K*T a la matriz b
-        Math::sum_in_place(b, temp);
-        //Se multiplica el contenido del resultado anterior por delta_t, el paso de tiempo
-        Math::product_in_place(b, dt);
-        //Se multiplica el resultado anterior por la inversa de la matriz M, y el resultado se añade a los
-        //resultados del tiempo actual, obteniendo así los resultados del siguiente tiempo
-        //SDDS<float>::show(M,false);
-        //DS<float>* temp2 = Math::inverse(M);
-        DS<float>* temp2 = Math::inverse_Cholesky(M);
-        //SDDS<float>::show(temp2,false);
-        DS<float>* temp3 = Math::product( temp2, b );
-        Math::sum_in_place(T, temp3 );
-        //La matriz temp ya no será utilizada, por lo que se libera su espacio en memoria
-        SDDS<float>::destroy(temp);SDDS<float>::destroy(temp2);SDDS<float>::destroy(temp3);
-
-        cout << "OK\n\n\tUpdating list of results... ";
-
-        //Se construye la matriz de resultados completa para el tiempo actual
-        FEM::build_full_T(T_full, T, Td, dirichlet_indices);
-        //Se añade la matriz de resultados complete del tiempo actual a la lista de resultados
-        FEM::append_results(Result, T_full);
-
-        cout << "OK\n\nCleaning up and advancing in time... ";
-
-        //Se libera todo el espacio en memoria utilizado en el tiempo actual
-        free_list(M_locals);
-        free_list(K_locals);
-        free_list(b_locals);
-        SDDS<float>::destroy(M);
-        SDDS<float>::destroy(K);
-        SDDS<float>::destroy(b);
-
-        //Avanzamos al siguiente tiempo a calcular
-        t = t + dt;
-
-        cout << "OK\n\n";
-    }
-
-    cout << "Writing output file... ";
-
-    //El ingreso en las listas enlazadas simples se hace al inicio en SDDS,
-    //por lo que hay que invertir la lista para tener los resultados en el orden
-    //en el que se calcularon
-    SDDS<DS<float>*>::reverse(Result);
-    //Se envía el listado de resultados, y el nombre de archivo recibido en línea de
-    //comandos, para crear el archivo de salida que será utilizado por GiD
-    write_output_file(Result, argv[1]);
-
-    cout << "OK\n\nCleaning up and finalizing process... ";
-
-    //Se libera el espacio en memori0a asignado para todas las estructuras utilizadas
-    SDDS<float>::destroy(T); SDDS<float>::destroy(T_full); SDDS<float>::destroy(T_N);
+    LOG_PROGRESS("\nClosing output file... ");
+
+    //Todos los resultados ya se encuentran en el archivo de salida. El proceso terminó
+    //exitosamente, por lo que su checkpoint ya no es necesario
+    if(Communicator::is_root()){
+        postResFile.close();
+        remove_checkpoint(opts.filename);
+    }
+
+    LOG_PROGRESS("OK\n");
+
+    //Se muestra el resumen de desempeño y se genera el reporte <filename>.perf.json
+    if(Log::enabled(LEVEL_PROGRESS)) Perf::show_summary(cout);
+    if(Communicator::is_root()) Perf::write_json(opts.filename, nnodes, nelems, step);
+
+    LOG_PROGRESS("\nCleaning up and finalizing process... ");
+
+    //Se libera el espacio en memoria asignado para todas las estructuras utilizadas
+    SDDS<real>::destroy(T); SDDS<real>::destroy(T_full); SDDS<real>::destroy(T_N);
     SDDS<int>::destroy(dirichlet_indices); SDDS<int>::destroy(neumann_indices);
-    //Para la lista de resultados, por estar compuesta por otras estructuras de datos,
-    //es necesario liberar una por una:
-    
-    free_list(Result);
 
-    //Se libera el objeto Mesh
-    delete G;
-    
-    cout << "OK\n\nHave a nice day!! :D\n";
+    //Se liberan los objetos Mesh
+    free_meshes(meshes, parents, nmeshes);
     
+    LOG_PROGRESS("OK\n\nHave a nice day!! :D\n");
+
+    Communicator::finalize();
     return 0;
 }
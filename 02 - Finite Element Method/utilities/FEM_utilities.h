@@ -10,6 +10,13 @@
 
     La clase hace uso de la clase utilitaria Math para todas las operaciones de
     álgebra de matrices.
+
+    Al igual que en Math, las funciones son plantillas sobre el tipo <T> de los
+    datos de las matrices. Las que reciben matrices lo deducen de ellas, y las
+    que construyen matrices locales nuevas lo reciben de forma explícita, por
+    ejemplo FEM::calculate_local_K<real>(k, e). Las coordenadas de los puntos y
+    los parámetros del problema se almacenan en float, y se convierten a <T>
+    antes de operar con ellos.
 */
 class FEM{
     /*
@@ -34,8 +41,10 @@ class FEM{
             Se reciben <P1>, <P2> y <P3> como los puntos que definen los nodos
             del elemento.
         */
-        static float calculate_local_J(Point* P1, Point* P2, Point* P3){
-            return abs((P2->get_x() - P1->get_x())*(P3->get_y() - P1->get_y()) - (P3->get_x() - P1->get_x())*(P2->get_y() - P1->get_y()));  //o_O
+        template <typename T>
+        static T calculate_local_J(Point* P1, Point* P2, Point* P3){
+            T x1 = P1->get_x(), y1 = P1->get_y(), x2 = P2->get_x(), y2 = P2->get_y(), x3 = P3->get_x(), y3 = P3->get_y();
+            return abs((x2 - x1)*(y3 - y1) - (x3 - x1)*(y2 - y1));  //o_O
         }
 
         /*
@@ -49,8 +58,10 @@ class FEM{
 
             Se reciben <P1>, <P2> y <P3> como los puntos que definen los nodos del elemento.
         */
-        static float calculate_local_Area(Point* P1, Point* P2, Point* P3){
-            return (abs(P1->get_x()*( P2->get_y() - P3->get_y() ) + P2->get_x()*( P3->get_y() - P1->get_y() ) + P3->get_x()*( P1->get_y() - P2->get_y() ))/2);
+        template <typename T>
+        static T calculate_local_Area(Point* P1, Point* P2, Point* P3){
+            T x1 = P1->get_x(), y1 = P1->get_y(), x2 = P2->get_x(), y2 = P2->get_y(), x3 = P3->get_x(), y3 = P3->get_y();
+            return (abs(x1*( y2 - y3 ) + x2*( y3 - y1 ) + x3*( y1 - y2 ))/2);
         }
 
         /*
@@ -70,8 +81,10 @@ class FEM{
             Se reciben <P1>, <P2> y <P3> como los puntos que definen los nodos
             del elemento.
         */
-        static float calculate_local_D(Point* P1, Point* P2, Point* P3){
-            return (P2->get_x() - P1->get_x())*(P3->get_y() - P1->get_y()) - (P3->get_x() - P1->get_x())*(P2->get_y() - P1->get_y());
+        template <typename T>
+        static T calculate_local_D(Point* P1, Point* P2, Point* P3){
+            T x1 = P1->get_x(), y1 = P1->get_y(), x2 = P2->get_x(), y2 = P2->get_y(), x3 = P3->get_x(), y3 = P3->get_y();
+            return (x2 - x1)*(y3 - y1) - (x3 - x1)*(y2 - y1);
         }
 
         /*
@@ -88,10 +101,12 @@ class FEM{
             Se reciben <P1>, <P2> y <P3> como los puntos que definen los nodos
             del elemento.
         */
-        static void calculate_local_A(DS<float>* A, Point* P1, Point* P2, Point* P3){
+        template <typename T>
+        static void calculate_local_A(DS<T>* A, Point* P1, Point* P2, Point* P3){
             //Se definen los elementos de la matriz de acuerdo a la fórmula posición por posición
-            SDDS<float>::insert(A,0,0, P3->get_y() - P1->get_y()); SDDS<float>::insert(A,0,1, P1->get_y() - P2->get_y());
-            SDDS<float>::insert(A,1,0, P1->get_x() - P3->get_x()); SDDS<float>::insert(A,1,1, P2->get_x() - P1->get_x());
+            T x1 = P1->get_x(), y1 = P1->get_y(), x2 = P2->get_x(), y2 = P2->get_y(), x3 = P3->get_x(), y3 = P3->get_y();
+            SDDS<T>::insert(A,0,0, y3 - y1); SDDS<T>::insert(A,0,1, y1 - y2);
+            SDDS<T>::insert(A,1,0, x1 - x3); SDDS<T>::insert(A,1,1, x2 - x1);
         }
 
         /*
@@ -105,10 +120,11 @@ class FEM{
                                 B = [            ]
                                     [ -1   0   1 ]
         */
-        static void calculate_B(DS<float>* B){
+        template <typename T>
+        static void calculate_B(DS<T>* B){
             //Se definen los elementos de la matriz de acuerdo a la fórmula posición por posición
-            SDDS<float>::insert(B,0,0,-1); SDDS<float>::insert(B,0,1,1); SDDS<float>::insert(B,0,2,0);
-            SDDS<float>::insert(B,1,0,-1); SDDS<float>::insert(B,1,1,0); SDDS<float>::insert(B,1,2,1);
+            SDDS<T>::insert(B,0,0,-1); SDDS<T>::insert(B,0,1,1); SDDS<T>::insert(B,0,2,0);
+            SDDS<T>::insert(B,1,0,-1); SDDS<T>::insert(B,1,1,0); SDDS<T>::insert(B,1,2,1);
         }
 
     /*
@@ -131,10 +147,11 @@ class FEM{
               de Neumann.
             - Un 0 en todas las demás posiciones.
         */
-        static void built_T_Neumann(DS<float>* T_N, float Tn, DS<int>* indices){
+        template <typename T>
+        static void built_T_Neumann(DS<T>* T_N, float Tn, DS<int>* indices){
             //Se extraen las dimensiones de <T_N>
             int nrows, ncols, T_pos = 0;
-            SDDS<float>::extension(T_N,&nrows,&ncols);
+            SDDS<T>::extension(T_N,&nrows,&ncols);
 
             //Se recorre la matriz <T_N>
             //Se sabe que es un vector columna, por lo que se recorre como un arreglo
@@ -149,10 +166,10 @@ class FEM{
 
                 //Si el nodo actual posee condición de Neumann, se inserta el valor <Tn>
                 if(bres)
-                    SDDS<float>::insert(T_N,i,0,Tn);
+                    SDDS<T>::insert(T_N,i,0,Tn);
                 //Si el nodo actual no posee condición de Neumann, se inserta un 0
                 else
-                    SDDS<float>::insert(T_N,i,0,0);
+                    SDDS<T>::insert(T_N,i,0,0);
             }
         }
 
@@ -172,20 +189,22 @@ class FEM{
             - <T_full> como el vector columna de resultados completo a construir.
             - <T> como el vector columna de resultados del proceso MEF2D.
             - <Td> el valor de temperatura impuesto en las condiciones de Dirichlet.
-            - <indices> como un arreglo de enteros que contiene los identificadores
-              de todos los nodos a los que se les aplica la condición de Dirichlet.
+            - <indices> como un arreglo de enteros, o un árbol binario de búsqueda, que
+              contiene los identificadores de todos los nodos a los que se les aplica la
+              condición de Dirichlet.
 
             El vector columna a construir contendrá:
             - Para los nodos libres, su valor respectivo en el vector <T>.
             - Para los demás nodos, el valor <Td>.
         */
-        static void build_full_T(DS<float>* T_full, DS<float>* T, float Td, DS<int>* indices){
+        template <typename V>
+        static void build_full_T(DS<V>* T_full, DS<V>* T, float Td, DS<int>* indices){
             //<T_pos> se utilizará para llevar un control de las posiciones recorridas
             //en el vector columna <T>, inicia en 0 ya que primero se ocupará su posición (0,0).
             int T_pos = 0;
             //Se extraen las dimensiones de la matriz <T_full>
             int nrows, ncols;
-            SDDS<float>::extension(T_full,&nrows,&ncols);
+            SDDS<V>::extension(T_full,&nrows,&ncols);
 
             //Se recorre la matriz <T_full>
             //Se sabe que es un vector columna, por lo que se recorre como un arreglo
@@ -200,17 +219,17 @@ class FEM{
 
                 //Si el nodo actual posee condición de Dirichlet, se inserta el valor <Td>
                 if(bres)
-                    SDDS<float>::insert(T_full,i,0,Td);
+                    SDDS<V>::insert(T_full,i,0,Td);
                 //Si el nodo actual no posee condición de Dirichlet,...
                 else{
                     //... se extrae el dato a insertar de la matriz <T>
-                    float value;
-                    SDDS<float>::extract(T,T_pos,0,&value);
+                    V value;
+                    SDDS<V>::extract(T,T_pos,0,&value);
                     //Se avanza en las filas de la matriz <T>
                     T_pos++;
 
                     //Se inserta el valor extraído en <T_full>
-                    SDDS<float>::insert(T_full,i,0,value);
+                    SDDS<V>::insert(T_full,i,0,value);
                 }
             }
         }
@@ -222,13 +241,15 @@ class FEM{
             Se recibe <R> como la lista de resultados, y se recibe <T> como
             el vector columna de resultados a añadir a la lista.
         */
-        static void append_results(DS<DS<float>*>* R, DS<float>* T){
-            //Se crea una copia del vector columna de resultados <T>
-            DS<float>* copy;
-            SDDS<float>::create_copy(T,&copy);
-
-            //Se inserta la copia en la lista de resultados
-            SDDS<DS<float>*>::insert(R,copy);
+        template <typename V>
+        static void append_results(DS<DS<V>*>* R, DS<V>* T){
+            //Se crea una copia del vector columna de resultados <V>
+            DS<V>* copy;
+            SDDS<V>::create_copy(T,&copy);
+
+            //Se añade la copia al final de la lista de resultados, de modo
+            //que los resultados quedan en el orden de los pasos de tiempo
+            SDDS<DS<V>*>::push_back(R,copy);
         }
 
         /*
@@ -250,23 +271,24 @@ class FEM{
             Los detalles teóricos de J pueden consultarse en los comentarios del
             método privado calculate_local_J() en esta clase.
         */
-        static DS<float>* calculate_local_M(float rho, float Cp, Element* e){
+        template <typename T>
+        static DS<T>* calculate_local_M(float rho, float Cp, Element* e){
             //Se define la matriz M con dimensiones 3 x 3
             //Esto corresponde a las dimensiones resultantes para la aplicación del MEF
             //a un problema 2D
-            DS<float>* M;
-            SDDS<float>::create(&M,3,3,MATRIX);
+            DS<T>* M;
+            SDDS<T>::create(&M,3,3,MATRIX);
 
             //Se extraen los respectivos puntos que definen los nodos del objeto <e> y se envían para el cálculo de J
-            float J = calculate_local_J(e->get_Node(0)->get_Point(), e->get_Node(1)->get_Point(), e->get_Node(2)->get_Point());
+            T J = calculate_local_J<T>(e->get_Node(0)->get_Point(), e->get_Node(1)->get_Point(), e->get_Node(2)->get_Point());
 
             //Se definen los elementos de la matriz de acuerdo a la fórmula posición por posición
-            SDDS<float>::insert(M,0,0,2); SDDS<float>::insert(M,0,1,1); SDDS<float>::insert(M,0,2,1);
-            SDDS<float>::insert(M,1,0,1); SDDS<float>::insert(M,1,1,2); SDDS<float>::insert(M,1,2,1);
-            SDDS<float>::insert(M,2,0,1); SDDS<float>::insert(M,2,1,1); SDDS<float>::insert(M,2,2,2);
+            SDDS<T>::insert(M,0,0,2); SDDS<T>::insert(M,0,1,1); SDDS<T>::insert(M,0,2,1);
+            SDDS<T>::insert(M,1,0,1); SDDS<T>::insert(M,1,1,2); SDDS<T>::insert(M,1,2,1);
+            SDDS<T>::insert(M,2,0,1); SDDS<T>::insert(M,2,1,1); SDDS<T>::insert(M,2,2,2);
 
             //Se multiplica el contenido de la matriz M por el factor rho*Cp*J/24
-            Math::product_in_place(M, rho*Cp*J/24);
+            Math::product_in_place(M, (T) rho*Cp*J/24);
 
             //Se retorna la matriz construida
             return M;
@@ -307,9 +329,10 @@ class FEM{
             en los comentarios de los métodos privados calculate_local_A(), calculate_B() y
             calculate_local_D() en esta clase.
         */
-        static DS<float>* calculate_local_K(float thermal_k, Element* e){
+        template <typename T>
+        static DS<T>* calculate_local_K(float thermal_k, Element* e){
             //Se preparan las variables para el proceso
-            DS<float> *A, *B, *A_T, *B_T, *K;
+            DS<T> *A, *B, *A_T, *B_T, *K;
 
             //Se extraen los puntos que definen los nodos del elemento
             Point* P1 = e->get_Node(0)->get_Point();
@@ -317,16 +340,16 @@ class FEM{
             Point* P3 = e->get_Node(2)->get_Point();
 
             //Se calcula el área del elemento enviando los 3 puntos de sus vértices
-            float Area = calculate_local_Area(P1,P2,P3);
+            T Area = calculate_local_Area<T>(P1,P2,P3);
 
             //Se calcula el valor D para el elemento enviando los 3 puntos de sus vértices
-            float D = calculate_local_D(P1, P2, P3);
+            T D = calculate_local_D<T>(P1, P2, P3);
 
             //Se definen la matrix A y su transpuesta con dimensiones 2 x 2
             //Esto corresponde a las dimensiones resultantes para la aplicación del MEF
             //a un problema 2D
-            SDDS<float>::create(&A,2,2,MATRIX);
-            SDDS<float>::create(&A_T,2,2,MATRIX);
+            SDDS<T>::create(&A,2,2,MATRIX);
+            SDDS<T>::create(&A_T,2,2,MATRIX);
             //Se calcula la matriz A para el elemento enviando los 3 puntos de sus vértices
             calculate_local_A(A,P1,P2,P3);
             //Se calcula la transpuesta de la matriz A
@@ -335,26 +358,26 @@ class FEM{
             //Se definen la matrix B con dimensiones 2 x 3, y su transpuesta con dimensiones 3 x 2
             //Esto corresponde a las dimensiones resultantes para la aplicación del MEF
             //a un problema 2D
-            SDDS<float>::create(&B,2,3,MATRIX);
-            SDDS<float>::create(&B_T,3,2,MATRIX);
+            SDDS<T>::create(&B,2,3,MATRIX);
+            SDDS<T>::create(&B_T,3,2,MATRIX);
             //Se calcula la matriz B
             calculate_B(B);
             //Se calcula la transpuesta de la matriz B
             Math::transpose(B_T, B);
 
             //Se efectúa B^T * A^T * A * B y el resultado se almacena en <K>
-            DS<float>* temp = Math::product( B_T, A_T );
-            DS<float>* temp2 = Math::product( temp, A );
+            DS<T>* temp = Math::product( B_T, A_T );
+            DS<T>* temp2 = Math::product( temp, A );
             K = Math::product( temp2, B );
-            SDDS<float>::destroy(temp);SDDS<float>::destroy(temp2);
+            SDDS<T>::destroy(temp);SDDS<T>::destroy(temp2);
 
             //Se multiplica el contenido de la matriz K por el factor k*Area/D^2
             Math::product_in_place(K, thermal_k*Area/(D*D));
 
             //Las matrices A y B, y sus transpuestas, ya no son necesarias, por lo
             //que se liberan sus espacios en memoria asignados
-            SDDS<float>::destroy(A); SDDS<float>::destroy(A_T);
-            SDDS<float>::destroy(B); SDDS<float>::destroy(B_T);
+            SDDS<T>::destroy(A); SDDS<T>::destroy(A_T);
+            SDDS<T>::destroy(B); SDDS<T>::destroy(B_T);
 
             //Se retorna la matriz construida
             return K;
@@ -378,20 +401,21 @@ class FEM{
             Los detalles teóricos de J pueden consultarse en los comentarios del
             método privado calculate_local_J() en esta clase.
         */
-        static DS<float>* calculate_local_b(float Q, Element* e){
+        template <typename T>
+        static DS<T>* calculate_local_b(float Q, Element* e){
             //Se define la matriz b con dimensiones 3 x 1
             //Esto corresponde a las dimensiones resultantes para la aplicación del MEF
             //a un problema 2D
-            DS<float>* b;
-            SDDS<float>::create(&b,3,1,MATRIX);
+            DS<T>* b;
+            SDDS<T>::create(&b,3,1,MATRIX);
             
             //Se extraen los respectivos puntos que definen los nodos del objeto <e> y se envían para el cálculo de J
-            float J = calculate_local_J(e->get_Node(0)->get_Point(), e->get_Node(1)->get_Point(), e->get_Node(2)->get_Point());
+            T J = calculate_local_J<T>(e->get_Node(0)->get_Point(), e->get_Node(1)->get_Point(), e->get_Node(2)->get_Point());
 
             //Se definen los elementos de la matriz de acuerdo a la fórmula posición por posición
-            SDDS<float>::insert(b,0,0,1);
-            SDDS<float>::insert(b,1,0,1);
-            SDDS<float>::insert(b,2,0,1);
+            SDDS<T>::insert(b,0,0,1);
+            SDDS<T>::insert(b,1,0,1);
+            SDDS<T>::insert(b,2,0,1);
 
             //Se multiplica el contenido de la matriz b por el factor Q*J/6
             Math::product_in_place(b, Q*J/6);
@@ -412,7 +436,8 @@ class FEM{
               con dimensiones 3 x 3 o un vector columna con dimensiones 3 x 1. Estas
               dimensiones son las correspondientes a aplicar el MEF a un problema 2D.
         */
-        static void assembly(DS<float>* global, DS<float>* local, Element* elem, bool is_3x3){
+        template <typename T>
+        static void assembly(DS<T>* global, DS<T>* local, Element* elem, bool is_3x3){
             //Se construye un arreglo de enteros de longitud 3, para almacenar los
             //índices globales de los nodos locales del elemento en proceso
             DS<int>* indices;
@@ -432,7 +457,7 @@ class FEM{
             SDDS<int>::insert(indices,2, index3);
             
             //Variables auxiliares para el proceso
-            float temp;
+            T temp;
             int pos1, pos2;
 
             //Se recorre la matriz local a ensamblar
@@ -441,7 +466,7 @@ class FEM{
                 //matriz 3 x 3 o una matriz 3 x 1
                 for(int j = 0; j < ((is_3x3)?3:1); j++){
                     //Se extrae el dato en la celda actual de la matriz local
-                    SDDS<float>::extract(local,i,j,&temp);
+                    SDDS<T>::extract(local,i,j,&temp);
 
                     //Se extrae el índice global de filas correspondiente al
                     //índice local de filas actual
@@ -517,22 +542,24 @@ class FEM{
               efectuadas se vean reflejadas en el procedimiento principal.
             - <K> como la matriz K de la ecuación del MEF2D.
             - <Td> como la temperatura impuesta en los nodos con condición de Dirichlet.
-            - <dirichlet_indices> como un arreglo de enteros que contiene los IDs de todos los nodos que tienen
-              asignada una condición de Dirichlet.
+            - <dirichlet_indices> como un arreglo de enteros, o un árbol binario de búsqueda, que contiene los IDs
+              de todos los nodos que tienen asignada una condición de Dirichlet. Solo se consulta la pertenencia de
+              cada ID, por lo que con un árbol balanceado cada consulta toma tiempo logarítmico.
         */
-        static void apply_Dirichlet(int nnodes, int free_nodes, DS<float>** b, DS<float>* K, float Td, DS<int>* dirichlet_indices){
+        template <typename T>
+        static void apply_Dirichlet(int nnodes, int free_nodes, DS<T>** b, DS<T>* K, float Td, DS<int>* dirichlet_indices){
             //Se preparan las matrices a construir como parte del proceso
             //<new_b> será la matriz b después de remover las filas de los nodos con condición
             //de Dirichlet, mientras que <T_D> será el vector columna adicional
-            DS<float> *new_b, *T_D;
+            DS<T> *new_b, *T_D;
             //Se definen <new_b> y <T_D> como vectores columna con una cantidad de filas igual
             //a la cantidad de nodos que no tienen una condición de Dirichlet
-            SDDS<float>::create(&new_b, free_nodes, 1, MATRIX);
-            SDDS<float>::create(&T_D, free_nodes, 1, MATRIX);
+            SDDS<T>::create(&new_b, free_nodes, 1, MATRIX);
+            SDDS<T>::create(&T_D, free_nodes, 1, MATRIX);
 
             //Se preparan las variables auxiliares del proceso
             bool bres;
-            float temp, acum;
+            T temp, acum;
             //<row_index> se utilizará para llevar un control de las posiciones definidas
             //tanto en <new_b> como en <T_D>, inicia en 0 ya que en ambos casos primero se
             //definirán sus posiciones (0,0).
@@ -554,10 +581,10 @@ class FEM{
                 if(!bres){
                     //Se extrae el valor en la posición actual de la matriz b
                     //Se utiliza *b, ya que la matriz b fue enviada por referencia
-                    SDDS<float>::extract(*b,i,0,&temp);
+                    SDDS<T>::extract(*b,i,0,&temp);
                     //Se inserta el valor estraído en la nueva matriz b en la
                     //posición actual de su recorrido, indicada por <row_index>
-                    SDDS<float>::insert(new_b,row_index,0,temp);
+                    SDDS<T>::insert(new_b,row_index,0,temp);
 
                     //Se inicializa el acumulador
                     acum = 0;
@@ -576,7 +603,7 @@ class FEM{
                         //<T_D>, de lo contrario se ignora
                         if(bres){
                             //Se extrae el valor de la celda actual en K
-                            SDDS<float>::extract(K,i,j,&temp);
+                            SDDS<T>::extract(K,i,j,&temp);
                             //Se acumula el producto del valor extraído por el valor de las condiciones de Dirichlet
                             acum += Td*temp;
                         }
@@ -585,7 +612,7 @@ class FEM{
                     //Se inserta el resultado del acumulador en el vector columna adicional en la
                     //posición actual de su recorrido, indicada por <row_index>
                     //El resultado se inserta multiplicado por -1 para simular la resta que debe ejecutarse
-                    SDDS<float>::insert(T_D,row_index,0,-acum);
+                    SDDS<T>::insert(T_D,row_index,0,-acum);
 
                     //Actualizamos <row_index> para avanzar en su recorrido
                     row_index++;
@@ -596,11 +623,11 @@ class FEM{
             Math::sum_in_place(new_b,T_D);
 
             //<T_D> ya no será utilizado, por lo que se libera su espacio en memoria
-            SDDS<float>::destroy(T_D);
+            SDDS<T>::destroy(T_D);
             //Dado que la actual matriz b será sustituida por la nueva, liberamos también
             //su espacio en memoria
             //Se utiliza *b, ya que la matriz b fue enviada por referencia
-            SDDS<float>::destroy(*b);
+            SDDS<T>::destroy(*b);
 
             //Concretizamos <new_b> como la nueva matriz b
             *b = new_b;
@@ -613,79 +640,42 @@ class FEM{
             Estas modificaciones consisten en remover de la matriz las filas y las columnas
             correspondientes a los nodos que tienen asignada una condición de Dirichlet.
 
+            El bloque de los nodos libres no se copia en una matriz nueva: la matriz se
+            sustituye por una vista sobre ella (ver DSMV.h) con las filas y las columnas de
+            los nodos libres, que solo ocupa la memoria de sus índices. La vista es propietaria
+            de la matriz original, por lo que basta con liberar la vista con SDDS::destroy().
+
             Para realizar este proceso se reciben:
             - <nnodes> como la cantidad de nodos total en la malla.
             - <free_nodes> como la cantidad de nodos que no tienen una condición de Dirichlet.
             - <matrix> como la matriz de la ecuación del MEF2D. Se recibe por referencia para que las modificaciones
               efectuadas se vean reflejadas en el procedimiento principal.
-            - <dirichlet_indices> como un arreglo de enteros que contiene los IDs de todos los nodos que tienen
-              asignada una condición de Dirichlet.
+            - <dirichlet_indices> como un arreglo de enteros, o un árbol binario de búsqueda, que contiene los IDs
+              de todos los nodos que tienen asignada una condición de Dirichlet. Solo se consulta la pertenencia de
+              cada ID, por lo que con un árbol balanceado cada consulta toma tiempo logarítmico.
         */
-        static void apply_Dirichlet(int nnodes, int free_nodes, DS<float>** matrix, DS<int>* dirichlet_indices){
-            //Se prepara la matriz a construir
-            //<new_matrix> será <matrix> después de remover las filas y las columnas de los nodos con condición
-            //de Dirichlet
-            DS<float>* new_matrix;
-            //Se define <new_matrix> con una cantidad de filas y columnas igual a la cantidad de nodos que no
-            //tienen una condición de Dirichlet
-            SDDS<float>::create(&new_matrix, free_nodes, free_nodes, MATRIX);
-
-            //Se preparan las variables auxiliares del proceso
-            bool res_i, res_j;
-            float Mij;
-            //<row> y <column> se utilizará para llevar un control de las posiciones definidas
-            //en <new_matrix>, ambas inician en 0 ya que primero se definirá su posición (0,0).
-            float row = 0, column = 0;
-
-            //Se recorre la matriz original
-            //Se sabe que su cantidad de filas y columnas son iguales a la cantidad de nodos en la malla
+        template <typename T>
+        static void apply_Dirichlet(int nnodes, int free_nodes, DS<T>** matrix, DS<int>* dirichlet_indices){
+            //Se preparan los índices de los nodos libres, que son a la vez las filas
+            //y las columnas de la vista
+            int* free_index = (int*) malloc(sizeof(int)*free_nodes);
+            int count = 0;
+            bool res;
+
+            //Se recorren los nodos de la malla, interpretando el contador como un ID
+            //de nodo, con la salvedad que el contador comienza en 0 y los IDs en 1
             for(int i = 0; i < nnodes; i++){
-                //Se interpreta el contador como un ID de nodo, con la salvedad
-                //que el contador comienza en 0 y los IDs comienzan en 1
-
-                //Se determina si el ID actual se encuentra en el arreglo de IDs
-                //de nodos con condición de Dirichlet
-                SDDS<int>::search(dirichlet_indices,i+1,&res_i); //Se envía i+1 para compensar la diferencia en los conteos
-
-                //Si el nodo actual no posee condición de Dirichlet, se procede
-                //a definir la posición respectiva en <new_matrix>, de lo contrario se ignora
-                if(!res_i){
-                    for(int j = 0; j < nnodes; j++){
-                        //De manera similar al contador para las filas, el contador para las
-                        //columnas también se interpreta como un ID de nodo
-
-                        //Se determina si la columna actual se encuentra en el arreglo de IDs
-                        //de nodos con condición de Dirichlet
-                        SDDS<int>::search(dirichlet_indices,j+1,&res_j);
-
-                        //Si la columna actual no posee condición de Dirichlet, se procede
-                        //a definir el valor en la posición correspondiente en <new_matrix>,
-                        //de lo contrario se ignora
-                        if(!res_j){
-                            //Se extrae el dato en la posición actual de la matriz original.
-                            //Se utiliza *matrix, ya que la matriz fue enviada por referencia
-                            SDDS<float>::extract(*matrix,i,j,&Mij);
-
-                            //Se inserta el dato extraído en la nueva matriz en la
-                            //posición actual de su recorrido, indicada por <row> y <column>
-                            SDDS<float>::insert(new_matrix,row,column,Mij);
-
-                            //Se avanza en las columnas de la fila actual de la nueva matriz
-                            column++;
-                        }
-                    }
-                    //Ya que se ha terminado de recorrer una fila de la matriz original,
-                    //Se avanza en las filas de la nueva matriz, y se reinicia en sus columnas
-                    row++;
-                    column = 0;
-                }
+                SDDS<int>::search(dirichlet_indices,i+1,&res);
+                if(!res) free_index[count++] = i;
             }
 
-            //Dado que la actual matriz será sustituida por la nueva, liberamos su espacio en memoria
+            //Se sustituye la matriz por la vista del bloque de los nodos libres, que
+            //asume la propiedad de la matriz original
             //Se utiliza *matrix, ya que la matriz fue enviada por referencia
-            SDDS<float>::destroy(*matrix);
+            DS<T>* view;
+            SDDS<T>::create_view(&view, *matrix, free_nodes, free_index, free_nodes, free_index, true);
+            *matrix = view;
 
-            //Concretizamos <new_matrix> como la nueva matriz
-            *matrix = new_matrix;
+            free(free_index);
         }
 };
\ No newline at end of file
@@ -0,0 +1,739 @@
+/*
+    Clase para el almacenamiento de una matriz dispersa en formato CSR
+    ("compressed sparse row"): por cada fila se almacenan únicamente sus
+    datos no nulos, junto con la columna de cada uno.
+
+                [ 4 -1  0  0 ]          row_start = [ 0  2  5  7  9 ]
+                [-1  4 -1  0 ]          columns   = [ 0 1  0 1 2  1 2  2 3 ]
+                [ 0 -1  4  0 ]          values    = [ 4 -1 -1 4 -1 -1 4  4 1 ]
+                [ 0  0  4  1 ]
+
+    Los datos de la fila i ocupan las posiciones row_start[i] a row_start[i+1]-1
+    de <columns> y <values>, con las columnas en orden creciente.
+
+    La matriz K del MEF tiene a lo sumo tantos datos no nulos por fila como
+    vecinos tiene cada nodo más uno, por lo que en este formato ocupa del orden
+    de n datos, y su producto por un vector requiere del orden de n operaciones.
+*/
+class SparseMatrix{
+    friend class Multigrid;
+    friend class AMG;
+    friend class GeometricMultigrid;
+
+    private:
+        int nrows, ncols;       //Dimensiones de la matriz
+        int* row_start;         //Posición de inicio de cada fila, con una posición extra al final
+        int* columns;           //Columna de cada dato no nulo
+        real* values;           //Datos no nulos, fila por fila
+
+    public:
+        /*
+            Constructor que construye la matriz dispersa a partir de la matriz
+            densa <A>, conservando únicamente sus datos no nulos.
+        */
+        SparseMatrix(DS<real>* A){
+            SDDS<real>::extension(A, &nrows, &ncols);
+            row_start = (int*) malloc(sizeof(int)*(nrows+1));
+
+            //Primer recorrido: se cuentan los datos no nulos de cada fila
+            real Aij;
+            row_start[0] = 0;
+            for(int i = 0; i < nrows; i++){
+                int count = 0;
+                for(int j = 0; j < ncols; j++){
+                    SDDS<real>::extract(A, i, j, &Aij);
+                    if(Aij != 0) count++;
+                }
+                row_start[i+1] = row_start[i] + count;
+            }
+
+            //Segundo recorrido: se copian los datos no nulos
+            columns = (int*) malloc(sizeof(int)*row_start[nrows]);
+            values = (real*) malloc(sizeof(real)*row_start[nrows]);
+            for(int i = 0; i < nrows; i++){
+                int k = row_start[i];
+                for(int j = 0; j < ncols; j++){
+                    SDDS<real>::extract(A, i, j, &Aij);
+                    if(Aij != 0){ columns[k] = j; values[k] = Aij; k++; }
+                }
+            }
+
+            Perf::count_allocation(sizeof(int)*(nrows+1) + (sizeof(int)+sizeof(real))*row_start[nrows], 3);
+        }
+
+        /*
+            Constructor que recibe directamente los arreglos <row_start>, <columns> y
+            <values> de una matriz de <rows> x <cols>, reservados con malloc. La
+            matriz se encarga desde ese momento de liberarlos.
+        */
+        SparseMatrix(int rows, int cols, int* row_start, int* columns, real* values){
+            nrows = rows; ncols = cols;
+            this->row_start = row_start;
+            this->columns = columns;
+            this->values = values;
+            Perf::count_allocation(sizeof(int)*(nrows+1) + (sizeof(int)+sizeof(real))*row_start[nrows], 3);
+        }
+
+        /*
+            Constructor que construye una matriz de <rows> x <cols> a partir de <count>
+            tripletas (<I>[k], <J>[k], <V>[k]), sumando las tripletas con la misma
+            posición, tal como en el ensamblaje de las matrices locales.
+
+            Las tripletas se agrupan por fila con un ordenamiento por conteo, y cada
+            fila se compacta con un arreglo <marker> que registra en qué posición de
+            la fila se encuentra cada columna ya visitada.
+        */
+        SparseMatrix(int rows, int cols, int count, int* I, int* J, real* V){
+            nrows = rows; ncols = cols;
+
+            //Se agrupan las tripletas por fila
+            int* by_row = (int*) calloc(nrows+1, sizeof(int));
+            for(int k = 0; k < count; k++) by_row[I[k]+1]++;
+            for(int i = 0; i < nrows; i++) by_row[i+1] += by_row[i];
+            int* order = (int*) malloc(sizeof(int)*count);
+            int* next = (int*) malloc(sizeof(int)*nrows);
+            for(int i = 0; i < nrows; i++) next[i] = by_row[i];
+            for(int k = 0; k < count; k++) order[next[I[k]]++] = k;
+
+            //Se suman las tripletas repetidas de cada fila
+            int* marker = (int*) malloc(sizeof(int)*ncols);
+            for(int j = 0; j < ncols; j++) marker[j] = -1;
+            row_start = (int*) malloc(sizeof(int)*(nrows+1));
+            columns = (int*) malloc(sizeof(int)*count);
+            values = (real*) malloc(sizeof(real)*count);
+            int end = 0;
+            for(int i = 0; i < nrows; i++){
+                row_start[i] = end;
+                for(int t = by_row[i]; t < by_row[i+1]; t++){
+                    int k = order[t];
+                    if(marker[J[k]] < row_start[i]){
+                        marker[J[k]] = end;
+                        columns[end] = J[k];
+                        values[end] = V[k];
+                        end++;
+                    }
+                    else values[marker[J[k]]] += V[k];
+                }
+
+                //Se ordenan las columnas de la fila, junto con sus datos
+                for(int k = row_start[i]+1; k < end; k++){
+                    int c = columns[k]; real v = values[k];
+                    int m = k-1;
+                    while(m >= row_start[i] && columns[m] > c){
+                        columns[m+1] = columns[m]; values[m+1] = values[m];
+                        m--;
+                    }
+                    columns[m+1] = c; values[m+1] = v;
+                }
+            }
+            row_start[nrows] = end;
+
+            free(by_row); free(order); free(next); free(marker);
+            Perf::count_allocation(sizeof(int)*(nrows+1) + (sizeof(int)+sizeof(real))*count, 3);
+        }
+
+        /*
+            Destructor, libera los arreglos de la matriz.
+        */
+        ~SparseMatrix(){
+            free(row_start);
+            free(columns);
+            free(values);
+        }
+
+        /*
+            Función que retorna la cantidad de filas de la matriz.
+        */
+        int size(){
+            return nrows;
+        }
+
+        /*
+            Función que retorna la cantidad de datos no nulos almacenados.
+        */
+        long nonzeros(){
+            return row_start[nrows];
+        }
+
+        /*
+            Función que calcula y = A * <x>.
+        */
+        void apply(real* x, real* y){
+            for(int i = 0; i < nrows; i++){
+                real acum = 0;
+                for(int k = row_start[i]; k < row_start[i+1]; k++)
+                    acum += values[k]*x[columns[k]];
+                y[i] = acum;
+            }
+            Perf::count_flops(2LL*row_start[nrows]);
+        }
+
+        /*
+            Función que calcula el residuo r = <rhs> - A * <x>, acumulando cada fila
+            en doble precisión. Cerca de la solución los productos de cada fila casi
+            se cancelan con <rhs>, por lo que en precisión simple el residuo quedaría
+            dominado por el error de redondeo.
+
+            La solución <x> puede almacenarse con el tipo real o en double (ver
+            Multigrid::solve).
+        */
+        template <typename X>
+        void residual(real* rhs, X* x, real* r){
+            for(int i = 0; i < nrows; i++){
+                double acum = rhs[i];
+                for(int k = row_start[i]; k < row_start[i+1]; k++)
+                    acum -= (double) values[k]*x[columns[k]];
+                r[i] = acum;
+            }
+            Perf::count_flops(2LL*row_start[nrows]);
+        }
+
+        /*
+            Función que coloca en <d> la diagonal de la matriz.
+        */
+        void diagonal(real* d){
+            for(int i = 0; i < nrows; i++){
+                d[i] = 0;
+                for(int k = row_start[i]; k < row_start[i+1]; k++)
+                    if(columns[k] == i) d[i] = values[k];
+            }
+        }
+
+        /*
+            Función que retorna una nueva matriz con la transpuesta de la matriz.
+        */
+        SparseMatrix* transpose(){
+            int* T_start = (int*) calloc(ncols+1, sizeof(int));
+            int* T_columns = (int*) malloc(sizeof(int)*row_start[nrows]);
+            real* T_values = (real*) malloc(sizeof(real)*row_start[nrows]);
+
+            //Se cuentan los datos de cada columna, que serán las filas de la transpuesta
+            for(int k = 0; k < row_start[nrows]; k++) T_start[columns[k]+1]++;
+            for(int j = 0; j < ncols; j++) T_start[j+1] += T_start[j];
+
+            //Se colocan los datos recorriendo las filas en orden, de modo que las
+            //columnas de la transpuesta queden en orden creciente
+            int* next = (int*) malloc(sizeof(int)*ncols);
+            for(int j = 0; j < ncols; j++) next[j] = T_start[j];
+            for(int i = 0; i < nrows; i++)
+                for(int k = row_start[i]; k < row_start[i+1]; k++){
+                    int pos = next[columns[k]]++;
+                    T_columns[pos] = i;
+                    T_values[pos] = values[k];
+                }
+            free(next);
+
+            return new SparseMatrix(ncols, nrows, T_start, T_columns, T_values);
+        }
+
+        /*
+            Función que retorna una nueva matriz con el producto <A> * <B>.
+
+            Cada fila i del producto es la combinación de las filas de <B> indicadas
+            por las columnas de la fila i de <A>. Las contribuciones se acumulan en un
+            arreglo denso de la longitud de una fila de <B>, y <marker> registra en qué
+            posición de la fila del producto se encuentra cada columna ya visitada.
+        */
+        static SparseMatrix* multiply(SparseMatrix* A, SparseMatrix* B){
+            int* marker = (int*) malloc(sizeof(int)*B->ncols);
+            for(int j = 0; j < B->ncols; j++) marker[j] = -1;
+
+            //Primer recorrido: se cuentan los datos no nulos de cada fila del producto
+            int* C_start = (int*) malloc(sizeof(int)*(A->nrows+1));
+            C_start[0] = 0;
+            for(int i = 0; i < A->nrows; i++){
+                int count = 0;
+                for(int ka = A->row_start[i]; ka < A->row_start[i+1]; ka++){
+                    int r = A->columns[ka];
+                    for(int kb = B->row_start[r]; kb < B->row_start[r+1]; kb++)
+                        if(marker[B->columns[kb]] != i){ marker[B->columns[kb]] = i; count++; }
+                }
+                C_start[i+1] = C_start[i] + count;
+            }
+
+            //Segundo recorrido: se acumulan los productos
+            int* C_columns = (int*) malloc(sizeof(int)*C_start[A->nrows]);
+            real* C_values = (real*) malloc(sizeof(real)*C_start[A->nrows]);
+            long long ops = 0;
+            for(int j = 0; j < B->ncols; j++) marker[j] = -1;
+            for(int i = 0; i < A->nrows; i++){
+                int end = C_start[i];
+                for(int ka = A->row_start[i]; ka < A->row_start[i+1]; ka++){
+                    int r = A->columns[ka];
+                    real a = A->values[ka];
+                    for(int kb = B->row_start[r]; kb < B->row_start[r+1]; kb++){
+                        int c = B->columns[kb];
+                        if(marker[c] < C_start[i]){
+                            marker[c] = end;
+                            C_columns[end] = c;
+                            C_values[end] = a*B->values[kb];
+                            end++;
+                        }
+                        else C_values[marker[c]] += a*B->values[kb];
+                    }
+                    ops += 2LL*(B->row_start[r+1] - B->row_start[r]);
+                }
+
+                //Se ordenan las columnas de la fila, junto con sus datos
+                for(int k = C_start[i]+1; k < end; k++){
+                    int c = C_columns[k]; real v = C_values[k];
+                    int m = k-1;
+                    while(m >= C_start[i] && C_columns[m] > c){
+                        C_columns[m+1] = C_columns[m]; C_values[m+1] = C_values[m];
+                        m--;
+                    }
+                    C_columns[m+1] = c; C_values[m+1] = v;
+                }
+            }
+            free(marker);
+            Perf::count_flops(ops);
+
+            return new SparseMatrix(A->nrows, B->ncols, C_start, C_columns, C_values);
+        }
+};
+
+/*
+    Clase base para la solución de sistemas A * x = b, con A simétrica y definida
+    positiva, mediante multigrid.
+
+    Los métodos iterativos sencillos como Jacobi o Gauss-Seidel eliminan con
+    rapidez las componentes del error que varían de un nodo a su vecino, pero
+    muy lentamente las componentes suaves, por lo que sus iteraciones crecen con
+    el tamaño de la malla. Multigrid corrige las componentes suaves en un sistema
+    más pequeño, donde dejan de ser suaves, y así sucesivamente, en una jerarquía
+    de niveles: el nivel 0 es el sistema original, y cada nivel siguiente es más
+    pequeño. Cada nivel l > 0 tiene un prolongador P, que lleva un vector del
+    nivel l al nivel l-1, y la restricción de un residuo del nivel l-1 al nivel l
+    es R = P^T.
+
+    La forma de construir los niveles la definen las clases derivadas (AMG y
+    GeometricMultigrid), mientras que esta clase provee el ciclo V y las
+    soluciones sobre la jerarquía. Un ciclo V realiza, en cada nivel:
+
+        1. Un barrido de Gauss-Seidel hacia adelante sobre A * x = b.
+        2. La restricción del residuo b - A * x al nivel siguiente.
+        3. Un ciclo V en el nivel siguiente, partiendo de cero.
+        4. La corrección de x con la prolongación del resultado.
+        5. Un barrido de Gauss-Seidel hacia atrás.
+
+    En el último nivel el sistema se resuelve de forma directa con Cholesky en
+    almacenamiento skyline. Por la simetría de los barridos, el ciclo V es un
+    operador simétrico, por lo que puede utilizarse como precondicionador del
+    gradiente conjugado (ver Iterative::conjugate_gradient()), o bien repetirse
+    por sí solo como solucionador.
+
+    La jerarquía se construye una sola vez, de modo que cada solución posterior,
+    con cualquier lado derecho, cuesta unos cuantos productos por las matrices de
+    todos los niveles, es decir, del orden de n operaciones.
+*/
+class Multigrid{
+    protected:
+        static const int MAX_LEVELS = 20;
+
+        int nlevels;                            //Cantidad de niveles de la jerarquía
+        SparseMatrix* A[MAX_LEVELS];            //Matriz de cada nivel
+        SparseMatrix* P[MAX_LEVELS];            //Prolongador de cada nivel al anterior
+        SparseMatrix* R[MAX_LEVELS];            //Restricción de cada nivel al siguiente, R = P^T
+        real* x[MAX_LEVELS];                    //Solución de cada nivel durante un ciclo V
+        real* b[MAX_LEVELS];                    //Lado derecho de cada nivel durante un ciclo V
+        real* r[MAX_LEVELS];                    //Residuo de cada nivel durante un ciclo V
+        Skyline* coarse;                        //Factorización de la matriz del último nivel
+        DS<real>* coarse_rhs;                   //Vector auxiliar para la solución directa
+
+        /*
+            Procedimiento que realiza un barrido de Gauss-Seidel sobre el sistema del
+            nivel <l>, hacia adelante o hacia atrás según <forward>.
+        */
+        void gauss_seidel(int l, bool forward){
+            SparseMatrix* M = A[l];
+            int n = M->nrows;
+            for(int step = 0; step < n; step++){
+                int i = forward ? step : n-1-step;
+                real acum = b[l][i], diag = 1;
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++){
+                    if(M->columns[k] == i) diag = M->values[k];
+                    else acum -= M->values[k]*x[l][M->columns[k]];
+                }
+                x[l][i] = acum/diag;
+            }
+            Perf::count_flops(2LL*M->row_start[n]);
+        }
+
+        /*
+            Procedimiento que realiza un ciclo V a partir del nivel <l>, sobre x[l] y
+            b[l], partiendo de x[l] = 0.
+        */
+        void vcycle(int l){
+            int n = A[l]->nrows;
+
+            //Último nivel: solución directa
+            if(l == nlevels-1){
+                for(int i = 0; i < n; i++) SDDS<real>::insert(coarse_rhs, i, 0, b[l][i]);
+                coarse->solve(coarse_rhs);
+                for(int i = 0; i < n; i++) SDDS<real>::extract(coarse_rhs, i, 0, &x[l][i]);
+                return;
+            }
+
+            for(int i = 0; i < n; i++) x[l][i] = 0;
+            gauss_seidel(l, true);
+
+            //Residuo del nivel actual, restringido al siguiente
+            A[l]->residual(b[l], x[l], r[l]);
+            R[l]->apply(r[l], b[l+1]);
+
+            vcycle(l+1);
+
+            //Corrección con la prolongación de la solución del nivel siguiente
+            P[l+1]->apply(x[l+1], r[l]);
+            for(int i = 0; i < n; i++) x[l][i] += r[l][i];
+            Perf::count_flops(2LL*n);
+
+            gauss_seidel(l, false);
+        }
+
+        /*
+            Procedimiento que completa la construcción de la jerarquía, una vez que
+            las clases derivadas han colocado las matrices A, P y R de todos los
+            niveles: reserva los vectores de trabajo y factoriza el último nivel.
+        */
+        void prepare_levels(){
+            //Vectores de trabajo de cada nivel, reutilizados en cada ciclo V
+            for(int l = 0; l < nlevels; l++){
+                int n = A[l]->nrows;
+                x[l] = (real*) malloc(sizeof(real)*n);
+                b[l] = (real*) malloc(sizeof(real)*n);
+                r[l] = (real*) malloc(sizeof(real)*n);
+                Perf::count_allocation(3*sizeof(real)*n, 3);
+            }
+
+            //Factorización del último nivel, cuyo perfil se obtiene de sus columnas no nulas
+            SparseMatrix* last = A[nlevels-1];
+            int n = last->nrows;
+            int* profile = (int*) malloc(sizeof(int)*n);
+            for(int i = 0; i < n; i++)
+                profile[i] = min(i, last->columns[last->row_start[i]]);
+            coarse = new Skyline(n, profile);
+            free(profile);
+            for(int i = 0; i < n; i++)
+                for(int k = last->row_start[i]; k < last->row_start[i+1]; k++)
+                    if(last->columns[k] <= i) coarse->add(i, last->columns[k], last->values[k]);
+            if(!coarse->factorize()){
+                cerr << "The coarsest multigrid matrix is not positive definite. :(\n";
+                exit(EXIT_FAILURE);
+            }
+            SDDS<real>::create(&coarse_rhs, n, 1, MATRIX);
+        }
+
+    public:
+        /*
+            Destructor, libera todos los niveles de la jerarquía.
+        */
+        ~Multigrid(){
+            for(int l = 0; l < nlevels; l++){
+                delete A[l];
+                if(P[l] != NULL) delete P[l];
+                if(R[l] != NULL) delete R[l];
+                free(x[l]); free(b[l]); free(r[l]);
+            }
+            delete coarse;
+            SDDS<real>::destroy(coarse_rhs);
+        }
+
+        /*
+            Función que retorna la cantidad de incógnitas del primer nivel.
+        */
+        int size(){
+            return A[0]->nrows;
+        }
+
+        /*
+            Función que retorna la cantidad de niveles de la jerarquía.
+        */
+        int levels(){
+            return nlevels;
+        }
+
+        /*
+            Función que retorna la complejidad del operador: la suma de los datos no
+            nulos de las matrices de todos los niveles, relativa a los de la matriz
+            original. Indica cuánto más costoso es un ciclo V que un producto A * x.
+        */
+        float complexity(){
+            long total = 0;
+            for(int l = 0; l < nlevels; l++) total += A[l]->nonzeros();
+            return (float) total/A[0]->nonzeros();
+        }
+
+        /*
+            Función que calcula y = A * <x> con la matriz del primer nivel, de modo que
+            la jerarquía sirve también como operador del gradiente conjugado.
+        */
+        void apply(real* x0, real* y0){
+            A[0]->apply(x0, y0);
+        }
+
+        /*
+            Función que aplica un ciclo V al residuo <res>, colocando en <z> la
+            corrección aproximada A^(-1) * res. Es la operación del precondicionador.
+        */
+        void precondition(real* res, real* z){
+            int n = A[0]->nrows;
+            for(int i = 0; i < n; i++) b[0][i] = res[i];
+            vcycle(0);
+            for(int i = 0; i < n; i++) z[i] = x[0][i];
+        }
+
+        /*
+            Función que resuelve A * <sol> = <rhs> repitiendo ciclos V, partiendo de la
+            aproximación inicial en <sol>:
+
+                    sol = sol + V( rhs - A * sol )
+
+            El proceso se detiene cuando el residuo relativo es menor a <tolerance>,
+            o al llegar a <max_iterations> ciclos. También se detiene si, pasados los
+            dos primeros ciclos, un ciclo reduce el residuo en menos de un 10%, lo cual
+            ocurre únicamente cuando la solución alcanza el límite de precisión con el
+            que se almacena. Los primeros ciclos se excluyen, ya que el ciclo V reduce
+            el error en la norma de A, y el residuo puede crecer al comienzo.
+
+            Igual que en RefinedCholesky, la solución y sus correcciones se acumulan
+            en double, y solo los ciclos V trabajan con el tipo real. Si la solución
+            se acumulara en float, cada corrección se redondearía al sumarse, y el
+            residuo relativo no bajaría de unas cuantas veces 1e-5 en mallas de unos
+            cientos de nodos, creciendo con el número de condición de la matriz. En
+            double, el límite es el redondeo de la matriz almacenada en float y del
+            residuo, del orden de 1e-7 por el número de condición.
+
+            Se retorna la cantidad de ciclos realizados, y en <residual> (si no es
+            NULL) el residuo relativo final.
+        */
+        int solve(real* rhs, real* sol, float tolerance, int max_iterations, float* residual = NULL){
+            int n = A[0]->nrows;
+            real* res = (real*) malloc(sizeof(real)*n);
+            real* z = (real*) malloc(sizeof(real)*n);
+            double* xd = (double*) malloc(sizeof(double)*n);
+            for(int i = 0; i < n; i++) xd[i] = sol[i];
+
+            double norm_b = 0;
+            for(int i = 0; i < n; i++) norm_b += (double) rhs[i]*rhs[i];
+            norm_b = (norm_b > 0) ? sqrt(norm_b) : 1;
+
+            int k = 0;
+            double norm_r, previous = INFINITY;
+            while(true){
+                A[0]->residual(rhs, xd, res);
+                norm_r = 0;
+                for(int i = 0; i < n; i++) norm_r += (double) res[i]*res[i];
+                norm_r = sqrt(norm_r);
+                if(norm_r <= tolerance*norm_b || k >= max_iterations || (k > 2 && norm_r > 0.9*previous)) break;
+                previous = norm_r;
+
+                precondition(res, z);
+                for(int i = 0; i < n; i++) xd[i] += z[i];
+                Perf::count_flops(4LL*n);
+                k++;
+            }
+
+            for(int i = 0; i < n; i++) sol[i] = xd[i];
+
+            if(residual != NULL) *residual = norm_r/norm_b;
+            free(res); free(z); free(xd);
+            return k;
+        }
+};
+
+/*
+    Clase para la construcción de la jerarquía de multigrid de forma algebraica,
+    por agregación ("smoothed aggregation AMG"), únicamente a partir de la matriz
+    del sistema:
+
+        - Los nodos se agrupan en "agregados" de nodos vecinos fuertemente
+          conectados, y cada agregado es una incógnita del nivel siguiente.
+        - El prolongador inicial P_0 asigna a cada nodo el valor de su agregado, y
+          se suaviza con un paso de Jacobi:
+
+                    P = ( I - w * D^(-1) * A ) * P_0
+
+        - La matriz del nivel siguiente es A_c = P^T * A * P.
+
+    Los niveles se agregan hasta que el último tiene a lo sumo COARSEST_SIZE
+    incógnitas, o la agregación deja de reducirlo.
+*/
+class AMG : public Multigrid{
+    private:
+        static const int COARSEST_SIZE = 100;   //Tamaño a partir del cual se resuelve de forma directa
+
+        /*
+            Función que agrupa los nodos de la matriz <M> en agregados, colocando en
+            <aggregate> el agregado de cada nodo, y retorna la cantidad de agregados.
+
+            Los nodos i y j están fuertemente conectados cuando:
+
+                    | A_ij | >= theta * sqrt( A_ii * A_jj )
+
+            Se realizan tres recorridos:
+                1. Cada nodo sin agregado cuyos vecinos fuertes tampoco tienen agregado
+                   forma un agregado nuevo con todos ellos.
+                2. Cada nodo restante se une al agregado de alguno de sus vecinos fuertes.
+                3. Los nodos que aún no tienen agregado forman agregados propios.
+        */
+        static int aggregate_nodes(SparseMatrix* M, int* aggregate){
+            const float theta = 0.08;
+            int n = M->nrows;
+            real* d = (real*) malloc(sizeof(real)*n);
+            M->diagonal(d);
+
+            //strong[k] indica si el dato k de la matriz es una conexión fuerte
+            bool* strong = (bool*) malloc(sizeof(bool)*M->row_start[n]);
+            for(int i = 0; i < n; i++)
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++){
+                    int j = M->columns[k];
+                    strong[k] = (j != i) && fabs(M->values[k]) >= theta*sqrt(fabs(d[i]*d[j]));
+                }
+
+            for(int i = 0; i < n; i++) aggregate[i] = -1;
+            int count = 0;
+
+            //Primer recorrido
+            for(int i = 0; i < n; i++){
+                if(aggregate[i] >= 0) continue;
+                bool free_neighbours = true;
+                for(int k = M->row_start[i]; k < M->row_start[i+1] && free_neighbours; k++)
+                    if(strong[k] && aggregate[M->columns[k]] >= 0) free_neighbours = false;
+                if(!free_neighbours) continue;
+
+                aggregate[i] = count;
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++)
+                    if(strong[k]) aggregate[M->columns[k]] = count;
+                count++;
+            }
+
+            //Segundo recorrido, se utiliza una copia para que los nodos se unan únicamente
+            //a agregados del primer recorrido
+            int* first_pass = (int*) malloc(sizeof(int)*n);
+            for(int i = 0; i < n; i++) first_pass[i] = aggregate[i];
+            for(int i = 0; i < n; i++){
+                if(aggregate[i] >= 0) continue;
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++)
+                    if(strong[k] && first_pass[M->columns[k]] >= 0){
+                        aggregate[i] = first_pass[M->columns[k]];
+                        break;
+                    }
+            }
+
+            //Tercer recorrido
+            for(int i = 0; i < n; i++)
+                if(aggregate[i] < 0) aggregate[i] = count++;
+
+            free(d); free(strong); free(first_pass);
+            return count;
+        }
+
+        /*
+            Función que construye el prolongador suavizado de la matriz <M>, a partir
+            de los agregados <aggregate>, de los cuales hay <count>.
+
+            El factor w se elige como 4/(3*rho), donde rho es una cota del radio
+            espectral de D^(-1) * A por el teorema de Gershgorin.
+        */
+        static SparseMatrix* smoothed_prolongator(SparseMatrix* M, int* aggregate, int count){
+            int n = M->nrows;
+            real* d = (real*) malloc(sizeof(real)*n);
+            M->diagonal(d);
+
+            real rho = 0;
+            for(int i = 0; i < n; i++){
+                real acum = 0;
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++) acum += fabs(M->values[k]);
+                rho = max(rho, acum/d[i]);
+            }
+            real w = 4/(3*rho);
+
+            //S = I - w * D^(-1) * A, con el mismo patrón de la matriz
+            int* S_start = (int*) malloc(sizeof(int)*(n+1));
+            int* S_columns = (int*) malloc(sizeof(int)*M->row_start[n]);
+            real* S_values = (real*) malloc(sizeof(real)*M->row_start[n]);
+            for(int i = 0; i <= n; i++) S_start[i] = M->row_start[i];
+            for(int i = 0; i < n; i++)
+                for(int k = M->row_start[i]; k < M->row_start[i+1]; k++){
+                    S_columns[k] = M->columns[k];
+                    S_values[k] = ((M->columns[k] == i) ? 1 : 0) - w*M->values[k]/d[i];
+                }
+            SparseMatrix* S = new SparseMatrix(n, n, S_start, S_columns, S_values);
+
+            //P_0 tiene un único 1 por fila, en la columna del agregado del nodo
+            int* P0_start = (int*) malloc(sizeof(int)*(n+1));
+            int* P0_columns = (int*) malloc(sizeof(int)*n);
+            real* P0_values = (real*) malloc(sizeof(real)*n);
+            for(int i = 0; i < n; i++){
+                P0_start[i] = i;
+                P0_columns[i] = aggregate[i];
+                P0_values[i] = 1;
+            }
+            P0_start[n] = n;
+            SparseMatrix* P0 = new SparseMatrix(n, count, P0_start, P0_columns, P0_values);
+
+            SparseMatrix* result = SparseMatrix::multiply(S, P0);
+            delete S; delete P0; free(d);
+            return result;
+        }
+
+    public:
+        /*
+            Constructor que construye la jerarquía de niveles a partir de la matriz
+            densa simétrica y definida positiva <K>, como la matriz K global ya
+            reducida a los "nodos libres" por FEM::apply_Dirichlet().
+        */
+        AMG(DS<real>* K){
+            A[0] = new SparseMatrix(K);
+            P[0] = NULL;
+            nlevels = 1;
+
+            while(nlevels < MAX_LEVELS && A[nlevels-1]->nrows > COARSEST_SIZE){
+                SparseMatrix* M = A[nlevels-1];
+                int* aggregate = (int*) malloc(sizeof(int)*M->nrows);
+                int count = aggregate_nodes(M, aggregate);
+
+                //Si la agregación ya no reduce el sistema, el nivel actual es el último
+                if(count >= M->nrows){ free(aggregate); break; }
+
+                SparseMatrix* Pl = smoothed_prolongator(M, aggregate, count);
+                free(aggregate);
+
+                //A_c = P^T * ( A * P )
+                SparseMatrix* Rl = Pl->transpose();
+                SparseMatrix* AP = SparseMatrix::multiply(M, Pl);
+                A[nlevels] = SparseMatrix::multiply(Rl, AP);
+                delete AP;
+
+                R[nlevels-1] = Rl;
+                P[nlevels] = Pl;
+                nlevels++;
+            }
+            R[nlevels-1] = NULL;
+
+            prepare_levels();
+        }
+};
+
+/*
+    Precondicionador del gradiente conjugado que aplica un ciclo V de una
+    jerarquía de multigrid ya construida. La jerarquía no se libera con el
+    precondicionador, de modo que puede reutilizarse en varias soluciones.
+*/
+class MultigridPreconditioner{
+    private:
+        Multigrid* hierarchy;
+
+    public:
+        MultigridPreconditioner(Multigrid* hierarchy){
+            this->hierarchy = hierarchy;
+        }
+
+        /*
+            Función que calcula z = V(r).
+        */
+        void apply(real* r, real* z){
+            hierarchy->precondition(r, z);
+        }
+};
@@ -0,0 +1,595 @@
+/*
+    Clases para la solución distribuida del sistema del MEF2D: la malla se
+    divide en subdominios (ver Mesh::partition()), cada subdominio se asigna a
+    un proceso que ensambla únicamente sus propios elementos, y el sistema
+    global se resuelve con gradiente conjugado intercambiando entre procesos
+    los valores de los nodos de la interfaz, es decir, los nodos compartidos
+    por varios subdominios.
+
+    Ningún proceso forma el sistema global: la matriz K global es la suma de
+    las matrices K de los subdominios, por lo que el producto K * x se obtiene
+    calculando en cada subdominio su propio producto y sumando en los nodos de
+    la interfaz los resultados de todos los subdominios que los comparten.
+
+    La comunicación entre procesos se realiza a través de la clase
+    Communicator, que tiene dos implementaciones:
+
+        - Con MPI, al compilar con -DFEM_USE_MPI (por ejemplo con mpicxx), en
+          cuyo caso cada subdominio es un proceso de MPI:
+
+                mpicxx -std=c++17 -O2 -DFEM_USE_MPI -o main main.cpp
+                mpirun -np 4 ./main <archivo> --partitions 4
+
+        - Sin MPI, por defecto, en cuyo caso cada subdominio se resuelve en un
+          hilo del mismo proceso, y los intercambios se realizan a través de
+          memoria compartida. Cada hilo tiene sus propias estructuras y sus
+          propias mediciones de desempeño, igual que un proceso de MPI, por lo
+          que ambas implementaciones ejecutan exactamente el mismo código.
+*/
+
+#ifdef FEM_USE_MPI
+
+//Tipo de MPI correspondiente al tipo real (ver precision_utilities.h)
+#ifdef FEM_DOUBLE
+    #define MPI_REAL_TYPE MPI_DOUBLE
+#else
+    #define MPI_REAL_TYPE MPI_FLOAT
+#endif
+
+/*
+    Implementación de Communicator sobre MPI_COMM_WORLD: el subdominio de cada
+    proceso es su rango.
+*/
+class Communicator{
+    private:
+        int my_rank, nranks;
+
+        Communicator(){
+            MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+            MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+        }
+
+    public:
+        /*
+            Procedimientos para iniciar y terminar el entorno de comunicación, que
+            se invocan al inicio y al final del procedimiento principal.
+        */
+        static void initialize(int* argc, char*** argv){
+            MPI_Init(argc, argv);
+        }
+        static void finalize(){
+            MPI_Finalize();
+        }
+
+        /*
+            Función que retorna la cantidad de procesos en ejecución.
+        */
+        static int processes(){
+            int size;
+            MPI_Comm_size(MPI_COMM_WORLD, &size);
+            return size;
+        }
+
+        /*
+            Función que indica si el proceso actual es el proceso principal, el
+            único que muestra mensajes y escribe los archivos de salida.
+        */
+        static bool is_root(){
+            int rank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            return rank == 0;
+        }
+
+        /*
+            Procedimiento que ejecuta <worker> para el subdominio de cada proceso,
+            con <context> como los datos comunes del problema. La cantidad de
+            subdominios <nparts> debe coincidir con la cantidad de procesos.
+        */
+        static void run(int nparts, void (*worker)(Communicator*, void*), void* context){
+            Communicator comm;
+            if(nparts != comm.nranks){
+                cerr << "The number of partitions must match the number of MPI processes. :(\n";
+                exit(EXIT_FAILURE);
+            }
+            worker(&comm, context);
+        }
+
+        int rank(){ return my_rank; }
+        int size(){ return nranks; }
+
+        /*
+            Procedimiento que intercambia datos con los <count> subdominios vecinos
+            <neighbors>: al vecino k se le envían los <lengths>[k] datos de <send>[k],
+            y se reciben de él otros tantos datos en <recv>[k].
+        */
+        void exchange(int count, int* neighbors, int* lengths, real** send, real** recv){
+            MPI_Request* requests = (MPI_Request*) malloc(sizeof(MPI_Request)*2*count);
+            for(int k = 0; k < count; k++){
+                MPI_Irecv(recv[k], lengths[k], MPI_REAL_TYPE, neighbors[k], 0, MPI_COMM_WORLD, &requests[2*k]);
+                MPI_Isend(send[k], lengths[k], MPI_REAL_TYPE, neighbors[k], 0, MPI_COMM_WORLD, &requests[2*k+1]);
+            }
+            MPI_Waitall(2*count, requests, MPI_STATUSES_IGNORE);
+            free(requests);
+        }
+
+        /*
+            Función que retorna la suma de <value> sobre todos los subdominios.
+        */
+        double sum(double value){
+            double total;
+            MPI_Allreduce(&value, &total, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            return total;
+        }
+
+        /*
+            Procedimiento que reemplaza cada dato de <values>, de longitud <n>, por la
+            suma de ese dato sobre todos los subdominios.
+        */
+        void sum(real* values, int n){
+            MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_REAL_TYPE, MPI_SUM, MPI_COMM_WORLD);
+        }
+};
+
+#else
+
+/*
+    Implementación de Communicator sobre hilos: el subdominio 0 se resuelve en
+    el hilo principal y cada uno de los demás en un hilo propio. Los hilos se
+    comunican a través de un "pizarrón" compartido, en el que cada uno publica
+    la dirección de sus datos antes de una barrera, para que los demás los lean
+    después de ella.
+*/
+class Communicator{
+    private:
+        /*
+            Datos compartidos por los hilos:
+            - La cantidad de hilos.
+            - La barrera: un candado, una variable de condición, la cantidad de
+              hilos que esperan en ella, y la "generación" actual, que cambia cada
+              vez que todos los hilos la alcanzan.
+            - La dirección de los datos publicados por cada hilo para cada otro
+              hilo (<mail>[origen*nranks + destino]), los escalares y los arreglos
+              publicados por cada hilo en las sumas.
+        */
+        struct Board{
+            int nranks;
+            mutex lock;
+            condition_variable released;
+            int waiting;
+            long generation;
+            real** mail;
+            double* scalars;
+            real** arrays;
+        };
+
+        int my_rank;
+        Board* board;
+
+        Communicator(int rank, Board* shared){
+            my_rank = rank;
+            board = shared;
+        }
+
+        /*
+            Procedimiento que detiene al hilo hasta que todos los hilos lo invoquen.
+            El candado garantiza además que los datos publicados por cada hilo antes
+            de la barrera sean visibles para los demás después de ella.
+        */
+        void barrier(){
+            unique_lock<mutex> guard(board->lock);
+            long generation = board->generation;
+            if(++board->waiting == board->nranks){
+                board->waiting = 0;
+                board->generation++;
+                board->released.notify_all();
+            }
+            else
+                board->released.wait(guard, [&]{ return board->generation != generation; });
+        }
+
+        /*
+            Procedimiento que ejecuta el hilo del subdominio <rank>.
+        */
+        static void thread_main(int rank, Board* shared, void (*worker)(Communicator*, void*), void* context){
+            Communicator comm(rank, shared);
+            worker(&comm, context);
+        }
+
+    public:
+        static void initialize(int*, char***){}
+        static void finalize(){}
+        static int processes(){ return 1; }
+        static bool is_root(){ return true; }
+
+        /*
+            Procedimiento que ejecuta <worker> para cada uno de los <nparts>
+            subdominios, con <context> como los datos comunes del problema, y espera
+            a que todos terminen.
+        */
+        static void run(int nparts, void (*worker)(Communicator*, void*), void* context){
+            Board* shared = new Board();
+            shared->nranks = nparts;
+            shared->waiting = 0;
+            shared->generation = 0;
+            shared->mail = (real**) calloc(nparts*nparts, sizeof(real*));
+            shared->scalars = (double*) malloc(sizeof(double)*nparts);
+            shared->arrays = (real**) malloc(sizeof(real*)*nparts);
+
+            thread** threads = (thread**) malloc(sizeof(thread*)*nparts);
+            for(int r = 1; r < nparts; r++) threads[r] = new thread(thread_main, r, shared, worker, context);
+            thread_main(0, shared, worker, context);
+            for(int r = 1; r < nparts; r++){ threads[r]->join(); delete threads[r]; }
+
+            free(threads);
+            free(shared->mail); free(shared->scalars); free(shared->arrays);
+            delete shared;
+        }
+
+        int rank(){ return my_rank; }
+        int size(){ return board->nranks; }
+
+        void exchange(int count, int* neighbors, int* lengths, real** send, real** recv){
+            int P = board->nranks;
+            for(int k = 0; k < count; k++) board->mail[my_rank*P + neighbors[k]] = send[k];
+            barrier();
+            for(int k = 0; k < count; k++)
+                memcpy(recv[k], board->mail[neighbors[k]*P + my_rank], sizeof(real)*lengths[k]);
+            //Los datos de <send> no deben cambiar hasta que todos los vecinos los hayan leído
+            barrier();
+        }
+
+        /*
+            Las sumas se calculan en cada hilo en el orden de los subdominios, por lo
+            que todos obtienen exactamente el mismo resultado.
+        */
+        double sum(double value){
+            board->scalars[my_rank] = value;
+            barrier();
+            double total = 0;
+            for(int r = 0; r < board->nranks; r++) total += board->scalars[r];
+            barrier();
+            return total;
+        }
+
+        void sum(real* values, int n){
+            real* total = (real*) calloc(n, sizeof(real));
+            board->arrays[my_rank] = values;
+            barrier();
+            for(int r = 0; r < board->nranks; r++)
+                for(int i = 0; i < n; i++) total[i] += board->arrays[r][i];
+            barrier();
+            memcpy(values, total, sizeof(real)*n);
+            free(total);
+        }
+};
+
+#endif
+
+/*
+    Clase que describe la interfaz de un subdominio con sus vecinos, sobre los
+    "nodos libres" del subdominio, numerados en el orden de sus IDs igual que
+    al reducir su sistema.
+
+    Los vectores de los nodos libres se manejan de dos formas:
+
+        - "Parcial": cada subdominio tiene únicamente su propia contribución,
+          como el vector b o el producto K * x calculados con sus elementos. El
+          vector global es la suma de los vectores parciales.
+        - "Consistente": cada subdominio tiene el valor global de sus nodos,
+          como las temperaturas.
+
+    assemble() convierte un vector parcial en consistente, sumando en cada nodo
+    de la interfaz las contribuciones de los subdominios que lo comparten. Las
+    contribuciones se suman en el orden de los subdominios, por lo que todos los
+    subdominios obtienen exactamente el mismo valor en cada nodo compartido.
+
+    Cada nodo tiene un único subdominio dueño (ver Mesh::node_owners()), de modo
+    que los productos punto de vectores consistentes se calculan sumando en cada
+    subdominio únicamente sus nodos propios.
+*/
+class Interface{
+    private:
+        Communicator* comm;
+        int n;                  //Cantidad de nodos libres del subdominio
+        int nglobal;            //Cantidad de nodos libres de la malla completa
+        int* global_free;       //Índice en la malla completa de cada nodo libre
+        bool* owned;            //Indica si cada nodo libre es propio del subdominio
+        int nneighbors;         //Cantidad de subdominios vecinos
+        int* neighbors;         //Subdominios vecinos, en orden creciente
+        int* lengths;           //Cantidad de nodos compartidos con cada vecino
+        int** shared;           //Nodos libres compartidos con cada vecino, en el orden de sus IDs
+        real** send;            //Datos a enviar a cada vecino
+        real** recv;            //Datos recibidos de cada vecino
+        int ninterface;         //Cantidad de nodos libres compartidos con algún vecino
+        int* interface;         //Nodos libres compartidos con algún vecino
+        real* total;            //Sumas de los nodos de la interfaz
+
+        /*
+            Función de comparación de dos claves enteras largas, en el formato
+            que requiere qsort().
+        */
+        static int compare_keys(const void* p, const void* q){
+            long a = *(const long*) p, b = *(const long*) q;
+            return (a > b) - (a < b);
+        }
+
+    public:
+        /*
+            Constructor que prepara la interfaz del subdominio de <comm>, cuya malla
+            <sub> se obtuvo de la malla completa <G> con Mesh::submesh(), a partir de
+            la división <part> de sus elementos, los dueños <owner> de sus nodos, y
+            los IDs originales <global_ids> de los nodos del subdominio.
+        */
+        Interface(Communicator* comm, Mesh* G, int* part, int* owner, Mesh* sub, int* global_ids){
+            this->comm = comm;
+            int p = comm->rank();
+            int nnodes = G->get_quantity(NUM_NODES);
+            int nelems = G->get_quantity(NUM_ELEMENTS);
+            int ndirichlet = G->get_quantity(NUM_DIRICHLET_BCs);
+            int sub_nodes = sub->get_quantity(NUM_NODES);
+
+            //Índice libre de cada nodo de la malla completa, o -1 si tiene condición de Dirichlet
+            DS<int>* indices;
+            SDDS<int>::create(&indices, ndirichlet, ARRAY);
+            G->get_condition_indices(indices, DIRICHLET);
+            int* free_index = (int*) calloc(nnodes, sizeof(int));
+            for(int i = 0; i < ndirichlet; i++){
+                int ID;
+                SDDS<int>::extract(indices, i, &ID);
+                free_index[ID-1] = -1;
+            }
+            SDDS<int>::destroy(indices);
+            nglobal = 0;
+            for(int i = 0; i < nnodes; i++)
+                if(free_index[i] == 0) free_index[i] = nglobal++;
+
+            //Nodos libres del subdominio, y su índice local según el ID original
+            int* local = (int*) malloc(sizeof(int)*nnodes);
+            for(int i = 0; i < nnodes; i++) local[i] = -1;
+            n = sub_nodes - sub->get_quantity(NUM_DIRICHLET_BCs);
+            global_free = (int*) malloc(sizeof(int)*n);
+            owned = (bool*) malloc(sizeof(bool)*n);
+            for(int l = 0, f = 0; l < sub_nodes; l++){
+                int i = global_ids[l] - 1;
+                if(free_index[i] < 0) continue;
+                local[i] = f;
+                global_free[f] = free_index[i];
+                owned[f] = owner[i] == p;
+                f++;
+            }
+
+            //Pares (vecino, nodo) de los nodos libres del subdominio que aparecen en
+            //elementos de otros subdominios, ordenados por vecino y por ID
+            long* keys = (long*) malloc(sizeof(long)*3*nelems);
+            int count = 0;
+            for(int e = 0; e < nelems; e++){
+                if(part[e] == p) continue;
+                Element* elem = G->get_element_at(e);
+                for(int a = 0; a < 3; a++){
+                    int i = elem->get_Node(a)->get_ID() - 1;
+                    if(local[i] >= 0) keys[count++] = (long) part[e]*nnodes + i;
+                }
+            }
+            qsort(keys, count, sizeof(long), compare_keys);
+            int unique = 0;
+            for(int k = 0; k < count; k++)
+                if(unique == 0 || keys[unique-1] != keys[k]) keys[unique++] = keys[k];
+
+            nneighbors = 0;
+            for(int k = 0; k < unique; k++)
+                if(k == 0 || keys[k]/nnodes != keys[k-1]/nnodes) nneighbors++;
+            neighbors = (int*) malloc(sizeof(int)*nneighbors);
+            lengths = (int*) calloc(nneighbors, sizeof(int));
+            shared = (int**) malloc(sizeof(int*)*nneighbors);
+            send = (real**) malloc(sizeof(real*)*nneighbors);
+            recv = (real**) malloc(sizeof(real*)*nneighbors);
+            for(int k = 0, q = -1; k < unique; k++){
+                if(k == 0 || keys[k]/nnodes != keys[k-1]/nnodes) neighbors[++q] = keys[k]/nnodes;
+                lengths[q]++;
+            }
+            for(int q = 0, k = 0; q < nneighbors; q++){
+                shared[q] = (int*) malloc(sizeof(int)*lengths[q]);
+                send[q] = (real*) malloc(sizeof(real)*lengths[q]);
+                recv[q] = (real*) malloc(sizeof(real)*lengths[q]);
+                for(int j = 0; j < lengths[q]; j++, k++) shared[q][j] = local[keys[k]%nnodes];
+            }
+
+            //Nodos de la interfaz, cada uno una sola vez
+            bool* in_interface = (bool*) calloc(n, sizeof(bool));
+            ninterface = 0;
+            interface = (int*) malloc(sizeof(int)*n);
+            for(int q = 0; q < nneighbors; q++)
+                for(int j = 0; j < lengths[q]; j++)
+                    if(!in_interface[shared[q][j]]){
+                        in_interface[shared[q][j]] = true;
+                        interface[ninterface++] = shared[q][j];
+                    }
+            total = (real*) malloc(sizeof(real)*n);
+
+            free(in_interface); free(keys); free(local); free(free_index);
+        }
+
+        /*
+            Destructor, libera los arreglos de la interfaz.
+        */
+        ~Interface(){
+            for(int q = 0; q < nneighbors; q++){ free(shared[q]); free(send[q]); free(recv[q]); }
+            free(shared); free(send); free(recv);
+            free(neighbors); free(lengths);
+            free(global_free); free(owned); free(interface); free(total);
+        }
+
+        /*
+            Funciones que retornan la cantidad de nodos libres del subdominio y de la
+            malla completa.
+        */
+        int size(){ return n; }
+        int global_size(){ return nglobal; }
+
+        /*
+            Función que retorna la cantidad de nodos de la interfaz de los que el
+            subdominio es dueño, cuya suma sobre los subdominios es la cantidad de
+            nodos libres compartidos.
+        */
+        int owned_interface(){
+            int count = 0;
+            for(int k = 0; k < ninterface; k++) if(owned[interface[k]]) count++;
+            return count;
+        }
+
+        /*
+            Procedimiento que convierte el vector parcial <v> en consistente.
+        */
+        void assemble(real* v){
+            for(int q = 0; q < nneighbors; q++)
+                for(int j = 0; j < lengths[q]; j++) send[q][j] = v[shared[q][j]];
+            comm->exchange(nneighbors, neighbors, lengths, send, recv);
+
+            //Se suman las contribuciones de los vecinos en orden creciente, incluyendo la
+            //propia al pasar por el subdominio actual
+            for(int k = 0; k < ninterface; k++) total[interface[k]] = 0;
+            bool own_added = false;
+            for(int q = 0; q <= nneighbors; q++){
+                if(!own_added && (q == nneighbors || neighbors[q] > comm->rank())){
+                    for(int k = 0; k < ninterface; k++) total[interface[k]] += v[interface[k]];
+                    own_added = true;
+                }
+                if(q < nneighbors)
+                    for(int j = 0; j < lengths[q]; j++) total[shared[q][j]] += recv[q][j];
+            }
+            for(int k = 0; k < ninterface; k++) v[interface[k]] = total[interface[k]];
+        }
+
+        /*
+            Función que retorna el producto punto de los vectores consistentes <x> y
+            <y>, acumulado en doble precisión.
+        */
+        double dot(real* x, real* y){
+            double acum = 0;
+            for(int i = 0; i < n; i++)
+                if(owned[i]) acum += (double) x[i]*y[i];
+            Perf::count_flops(2LL*n);
+            return comm->sum(acum);
+        }
+
+        /*
+            Procedimiento que coloca en <x> los datos de los nodos libres del
+            subdominio a partir del vector <global> de la malla completa.
+        */
+        void scatter(DS<real>* global, real* x){
+            for(int i = 0; i < n; i++) SDDS<real>::extract(global, global_free[i], 0, &x[i]);
+        }
+
+        /*
+            Procedimiento que reúne en <global> el vector consistente <x> de la malla
+            completa. Todos los subdominios deben invocarlo, pero únicamente los que
+            envían <global> distinto de NULL reciben el resultado.
+        */
+        void gather(real* x, DS<real>* global){
+            real* values = (real*) calloc(nglobal, sizeof(real));
+            for(int i = 0; i < n; i++)
+                if(owned[i]) values[global_free[i]] = x[i];
+            comm->sum(values, nglobal);
+            if(global != NULL)
+                for(int i = 0; i < nglobal; i++) SDDS<real>::insert(global, i, 0, values[i]);
+            free(values);
+        }
+};
+
+/*
+    Operador distribuido: el producto por una matriz global que se obtiene como
+    la suma de las matrices <A> de los subdominios, con la interfaz <I>. Opera
+    sobre vectores consistentes, y ofrece además la diagonal de la matriz global
+    para el precondicionador de Jacobi (ver JacobiPreconditioner).
+*/
+class DistributedOperator{
+    private:
+        SparseMatrix* A;
+        Interface* I;
+
+    public:
+        DistributedOperator(SparseMatrix* A, Interface* I){
+            this->A = A;
+            this->I = I;
+        }
+
+        int size(){
+            return I->size();
+        }
+
+        Interface* interface(){
+            return I;
+        }
+
+        void apply(real* x, real* y){
+            A->apply(x, y);
+            I->assemble(y);
+        }
+
+        void diagonal(real* d){
+            A->diagonal(d);
+            I->assemble(d);
+        }
+};
+
+class Distributed{
+    public:
+        /*
+            Función que resuelve el sistema global A * x = <b> con el método del
+            gradiente conjugado precondicionado, tal como Iterative::conjugate_gradient(),
+            donde <b> y <x> son vectores consistentes del subdominio.
+
+            Todos los subdominios ejecutan las mismas iteraciones: los productos A*p
+            se completan con el intercambio de la interfaz, y los productos punto con
+            la suma sobre los subdominios, por lo que alpha, beta y el residuo son los
+            mismos en todos ellos.
+        */
+        template <typename Preconditioner>
+        static int conjugate_gradient(DistributedOperator* A, Preconditioner* P, real* b, real* x, float tolerance, int max_iterations, float* residual = NULL){
+            Interface* I = A->interface();
+            int n = A->size();
+            real* r = (real*) malloc(sizeof(real)*n);
+            real* z = (real*) malloc(sizeof(real)*n);
+            real* p = (real*) malloc(sizeof(real)*n);
+            real* Ap = (real*) malloc(sizeof(real)*n);
+            Perf::count_allocation(4*sizeof(real)*n, 4);
+
+            //Residuo inicial
+            A->apply(x, Ap);
+            for(int i = 0; i < n; i++) r[i] = b[i] - Ap[i];
+
+            double norm_b = sqrt(I->dot(b, b));
+            if(norm_b == 0) norm_b = 1;
+            double norm_r = sqrt(I->dot(r, r));
+
+            P->apply(r, z);
+            for(int i = 0; i < n; i++) p[i] = z[i];
+            double rz = I->dot(r, z);
+
+            int k = 0;
+            while(k < max_iterations && norm_r > tolerance*norm_b){
+                A->apply(p, Ap);
+                double alpha = rz/I->dot(p, Ap);
+
+                for(int i = 0; i < n; i++){
+                    x[i] += alpha*p[i];
+                    r[i] -= alpha*Ap[i];
+                }
+                norm_r = sqrt(I->dot(r, r));
+
+                P->apply(r, z);
+                double rz_new = I->dot(r, z);
+                double beta = rz_new/rz;
+                rz = rz_new;
+
+                for(int i = 0; i < n; i++) p[i] = z[i] + beta*p[i];
+                Perf::count_flops(6LL*n);
+                k++;
+            }
+
+            if(residual != NULL) *residual = norm_r/norm_b;
+
+            free(r); free(z); free(p); free(Ap);
+            return k;
+        }
+};
@@ -0,0 +1,306 @@
+/*
+    Clases para la evaluación diferida ("lazy") de expresiones de matrices,
+    mediante plantillas de expresiones ("expression templates").
+
+    Cada operación de la clase Math calcula su resultado completo de inmediato,
+    por lo que una expresión como:
+
+                    delta_t * ( b - K * T )
+
+    recorre la memoria varias veces y construye matrices temporales: una para
+    K * T, y luego recorre dicha matriz para cambiarle el signo, sumarle b y
+    multiplicarla por delta_t. Con las clases de este archivo, los operadores
+    +, - y * no calculan nada, sino que construyen un objeto que describe la
+    expresión, cuyo tipo refleja el árbol de la expresión:
+
+            LazyScaled< LazyDifference< LazyMatrix<real>, LazyProduct<real> > >
+
+    La expresión se evalúa al asignarla a una matriz con Lazy::assign() o
+    Lazy::evaluate(), con un único recorrido de las celdas del resultado en el
+    que cada celda se calcula de principio a fin mediante at(i,j), sin matrices
+    temporales. Al tratarse de plantillas, el compilador genera para cada
+    expresión su propio ciclo fusionado, sin escribir cada combinación a mano.
+
+    Las hojas del árbol son matrices ya existentes, envueltas con Lazy::of(),
+    y los nodos disponibles son:
+        - LazySum y LazyDifference, para la suma y la resta celda por celda de
+          dos expresiones de las mismas dimensiones.
+        - LazyScaled, para el producto de un escalar por una expresión.
+        - LazyTranspose, para la transpuesta de una expresión.
+        - LazyProduct, para el producto de dos matrices. Cada celda del producto
+          recorre una fila y una columna completas, por lo que sus operandos
+          deben ser matrices ya evaluadas (hojas), y no expresiones, para no
+          recalcular cada operando una vez por celda. Al igual que en
+          Math::product(), la sumatoria se acumula en double.
+
+    Cada celda del resultado se redondea al tipo de la matriz en cada nodo, en
+    el mismo orden que las operaciones de Math, por lo que una expresión produce
+    exactamente los mismos valores que la secuencia de operaciones equivalente.
+
+    La matriz destino de Lazy::assign() puede aparecer en la expresión fuera de
+    los productos y las transpuestas, ya que cada celda del resultado solo lee
+    la misma celda de las demás matrices; por ejemplo b = delta_t * ( b - K*T ).
+*/
+
+/*
+    Clase base de todas las expresiones, según el patrón CRTP: <E> es la clase
+    derivada, de modo que los operadores reciben cualquier expresión y conocen
+    su tipo exacto en tiempo de compilación, sin funciones virtuales.
+
+    Toda expresión define su tipo de dato <value_type>, y las funciones rows(),
+    cols(), at(i,j), que calcula la celda (i,j), y flops(), que retorna la
+    cantidad de operaciones por celda para las mediciones de desempeño.
+*/
+template <typename E>
+class LazyExpression{
+    public:
+        const E& self() const{
+            return static_cast<const E&>(*this);
+        }
+};
+
+/*
+    Hoja de una expresión: una matriz DS ya existente, que no se copia.
+*/
+template <typename T>
+class LazyMatrix : public LazyExpression< LazyMatrix<T> >{
+    private:
+        DS<T>* data;
+        int nrows, ncols;
+
+    public:
+        typedef T value_type;
+
+        LazyMatrix(DS<T>* matrix){
+            data = matrix;
+            SDDS<T>::extension(matrix, &nrows, &ncols);
+        }
+
+        int rows() const{ return nrows; }
+        int cols() const{ return ncols; }
+        long long flops() const{ return 0; }
+
+        T at(int i, int j) const{
+            T value;
+            SDDS<T>::extract(data, i, j, &value);
+            return value;
+        }
+};
+
+/*
+    Suma celda por celda de dos expresiones <left> y <right>.
+*/
+template <typename L, typename R>
+class LazySum : public LazyExpression< LazySum<L,R> >{
+    private:
+        L left;
+        R right;
+
+    public:
+        typedef typename L::value_type value_type;
+
+        LazySum(const L& l, const R& r) : left(l), right(r){}
+
+        int rows() const{ return left.rows(); }
+        int cols() const{ return left.cols(); }
+        long long flops() const{ return left.flops() + right.flops() + 1; }
+
+        value_type at(int i, int j) const{
+            return left.at(i,j) + right.at(i,j);
+        }
+};
+
+/*
+    Resta celda por celda de dos expresiones <left> y <right>.
+*/
+template <typename L, typename R>
+class LazyDifference : public LazyExpression< LazyDifference<L,R> >{
+    private:
+        L left;
+        R right;
+
+    public:
+        typedef typename L::value_type value_type;
+
+        LazyDifference(const L& l, const R& r) : left(l), right(r){}
+
+        int rows() const{ return left.rows(); }
+        int cols() const{ return left.cols(); }
+        long long flops() const{ return left.flops() + right.flops() + 1; }
+
+        value_type at(int i, int j) const{
+            return left.at(i,j) - right.at(i,j);
+        }
+};
+
+/*
+    Producto de un escalar <factor> por una expresión <inner>. Al igual que en
+    Math::product_in_place(), el escalar se convierte primero al tipo de dato
+    de la expresión.
+*/
+template <typename E>
+class LazyScaled : public LazyExpression< LazyScaled<E> >{
+    private:
+        typename E::value_type factor;
+        E inner;
+
+    public:
+        typedef typename E::value_type value_type;
+
+        LazyScaled(double f, const E& e) : factor((value_type) f), inner(e){}
+
+        int rows() const{ return inner.rows(); }
+        int cols() const{ return inner.cols(); }
+        long long flops() const{ return inner.flops() + 1; }
+
+        value_type at(int i, int j) const{
+            return inner.at(i,j)*factor;
+        }
+};
+
+/*
+    Transpuesta de una expresión <inner>.
+*/
+template <typename E>
+class LazyTranspose : public LazyExpression< LazyTranspose<E> >{
+    private:
+        E inner;
+
+    public:
+        typedef typename E::value_type value_type;
+
+        LazyTranspose(const E& e) : inner(e){}
+
+        int rows() const{ return inner.cols(); }
+        int cols() const{ return inner.rows(); }
+        long long flops() const{ return inner.flops(); }
+
+        value_type at(int i, int j) const{
+            return inner.at(j,i);
+        }
+};
+
+/*
+    Producto de dos matrices <A> (p x q) y <B> (q x r). La celda (i,j) se
+    calcula como en Math::product(), acumulando en double los q términos de la
+    fila i de <A> por la columna j de <B>.
+*/
+template <typename T>
+class LazyProduct : public LazyExpression< LazyProduct<T> >{
+    private:
+        LazyMatrix<T> A, B;
+
+    public:
+        typedef T value_type;
+
+        LazyProduct(const LazyMatrix<T>& a, const LazyMatrix<T>& b) : A(a), B(b){}
+
+        int rows() const{ return A.rows(); }
+        int cols() const{ return B.cols(); }
+        long long flops() const{ return 2LL*A.cols(); }
+
+        T at(int i, int j) const{
+            double acum = 0;
+            for(int k = 0; k < A.cols(); k++)
+                acum += (double) A.at(i,k)*B.at(k,j);
+            return (T) acum;
+        }
+};
+
+/*
+    Operadores que construyen los nodos de las expresiones.
+*/
+template <typename L, typename R>
+LazySum<L,R> operator+(const LazyExpression<L>& left, const LazyExpression<R>& right){
+    return LazySum<L,R>(left.self(), right.self());
+}
+
+template <typename L, typename R>
+LazyDifference<L,R> operator-(const LazyExpression<L>& left, const LazyExpression<R>& right){
+    return LazyDifference<L,R>(left.self(), right.self());
+}
+
+template <typename E>
+LazyScaled<E> operator*(double factor, const LazyExpression<E>& e){
+    return LazyScaled<E>(factor, e.self());
+}
+
+template <typename T>
+LazyProduct<T> operator*(const LazyMatrix<T>& A, const LazyMatrix<T>& B){
+    return LazyProduct<T>(A, B);
+}
+
+/*
+    Clase utilitaria con los puntos de entrada de las expresiones diferidas: la
+    construcción de sus hojas y su evaluación.
+*/
+class Lazy{
+    public:
+        /*
+            Función que envuelve la matriz <matrix> como hoja de una expresión.
+        */
+        template <typename T>
+        static LazyMatrix<T> of(DS<T>* matrix){
+            return LazyMatrix<T>(matrix);
+        }
+
+        /*
+            Función que construye la transpuesta de la expresión <e>.
+        */
+        template <typename E>
+        static LazyTranspose<E> transpose(const LazyExpression<E>& e){
+            return LazyTranspose<E>(e.self());
+        }
+
+        /*
+            Procedimiento que evalúa la expresión <e> y coloca el resultado en la
+            matriz <target>, ya creada con las dimensiones de la expresión, con un
+            solo recorrido de sus celdas.
+        */
+        template <typename T, typename E>
+        static void assign(DS<T>* target, const LazyExpression<E>& e){
+            const E& expr = e.self();
+            int nrows, ncols;
+            SDDS<T>::extension(target, &nrows, &ncols);
+            if(nrows != expr.rows() || ncols != expr.cols()){
+                cerr << "The dimensions of a matrix expression do not match its target. :(\n";
+                exit(EXIT_FAILURE);
+            }
+
+            for(int i = 0; i < nrows; i++)
+                for(int j = 0; j < ncols; j++)
+                    SDDS<T>::insert(target, i, j, (T) expr.at(i,j));
+
+            Perf::count_flops(expr.flops()*nrows*ncols);
+        }
+
+        /*
+            Función que evalúa la expresión <e> en una matriz nueva, que constituye
+            el valor de retorno.
+        */
+        template <typename E>
+        static DS<typename E::value_type>* evaluate(const LazyExpression<E>& e){
+            typedef typename E::value_type T;
+            DS<T>* result;
+            SDDS<T>::create(&result, e.self().rows(), e.self().cols(), MATRIX);
+            assign(result, e);
+            return result;
+        }
+
+        /*
+            Función que calcula la norma infinito de la expresión <e>, es decir,
+            el mayor valor absoluto entre sus celdas, sin evaluarla en una matriz.
+        */
+        template <typename E>
+        static typename E::value_type max_norm(const LazyExpression<E>& e){
+            typedef typename E::value_type T;
+            const E& expr = e.self();
+            T norm = 0;
+            for(int i = 0; i < expr.rows(); i++)
+                for(int j = 0; j < expr.cols(); j++)
+                    norm = max(norm, (T) fabs(expr.at(i,j)));
+
+            Perf::count_flops(expr.flops()*expr.rows()*expr.cols());
+            return norm;
+        }
+};
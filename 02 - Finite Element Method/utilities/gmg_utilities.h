@@ -0,0 +1,171 @@
+/*
+    Clase para la construcción de la jerarquía de multigrid de forma geométrica,
+    a partir de una sucesión de mallas obtenidas con Mesh::refine(): la malla
+    más fina es el nivel 0, y la malla original, la más gruesa, es el último
+    nivel, que se resuelve de forma directa.
+
+    El prolongador de cada malla gruesa a la siguiente más fina interpola las
+    temperaturas de forma lineal, tal como lo hacen las funciones de forma:
+
+        - Un nodo de la malla gruesa conserva su temperatura.
+        - Un nodo nuevo, en el punto medio de un lado, recibe el promedio de las
+          temperaturas de los dos extremos del lado.
+
+    Únicamente se consideran los "nodos libres" de cada malla; los nodos con
+    condición de Dirichlet no aportan a la interpolación, ya que la corrección
+    de sus temperaturas siempre es cero.
+
+    La matriz K se ensambla directamente en formato disperso únicamente en la
+    malla más fina, y la de cada malla más gruesa se obtiene como:
+
+                A_c = P^T * A * P
+
+    que para mallas anidadas de triángulos lineales coincide con la matriz K
+    ensamblada en la malla gruesa. Ninguna matriz densa interviene, por lo que
+    la construcción y cada ciclo V cuestan del orden de n operaciones.
+*/
+class GeometricMultigrid : public Multigrid{
+    private:
+        /*
+            Función que retorna un arreglo nuevo con el índice de "nodo libre" del
+            nodo con ID i+1 de la malla <G> en la posición i, o -1 si el nodo tiene
+            condición de Dirichlet. Los nodos libres se numeran en el orden de sus
+            IDs, igual que al reducir las matrices globales. En <count> se coloca la
+            cantidad de nodos libres.
+        */
+        static int* free_numbering(Mesh* G, int* count){
+            int nnodes = G->get_quantity(NUM_NODES);
+            int ndirichlet = G->get_quantity(NUM_DIRICHLET_BCs);
+
+            DS<int>* indices;
+            SDDS<int>::create(&indices, ndirichlet, ARRAY);
+            G->get_condition_indices(indices, DIRICHLET);
+            int* free_index = (int*) calloc(nnodes, sizeof(int));
+            for(int i = 0; i < ndirichlet; i++){
+                int ID;
+                SDDS<int>::extract(indices, i, &ID);
+                free_index[ID-1] = -1;
+            }
+            SDDS<int>::destroy(indices);
+
+            *count = 0;
+            for(int i = 0; i < nnodes; i++)
+                if(free_index[i] == 0) free_index[i] = (*count)++;
+            return free_index;
+        }
+
+        /*
+            Función que ensambla la matriz K de la malla <G>, reducida a los nodos
+            libres <free_index>, en formato disperso. Las matrices locales son las de
+            FEM::calculate_local_K<real>(), con la conductividad térmica de la malla.
+        */
+        static SparseMatrix* stiffness_matrix(Mesh* G, int* free_index, int n){
+            int nelems = G->get_quantity(NUM_ELEMENTS);
+            real k = G->get_parameter(THERMAL_CONDUCTIVITY);
+            int* I = (int*) malloc(sizeof(int)*9*nelems);
+            int* J = (int*) malloc(sizeof(int)*9*nelems);
+            real* V = (real*) malloc(sizeof(real)*9*nelems);
+            int count = 0;
+
+            for(int e = 0; e < nelems; e++){
+                Element* elem = G->get_element_at(e);
+                DS<real>* local = FEM::calculate_local_K<real>(k, elem);
+                for(int a = 0; a < 3; a++){
+                    int i = free_index[elem->get_Node(a)->get_ID() - 1];
+                    if(i < 0) continue;
+                    for(int b = 0; b < 3; b++){
+                        int j = free_index[elem->get_Node(b)->get_ID() - 1];
+                        if(j < 0) continue;
+                        I[count] = i; J[count] = j;
+                        SDDS<real>::extract(local, a, b, &V[count]);
+                        count++;
+                    }
+                }
+                SDDS<real>::destroy(local);
+            }
+
+            SparseMatrix* K = new SparseMatrix(n, n, count, I, J, V);
+            free(I); free(J); free(V);
+            return K;
+        }
+
+        /*
+            Función que construye el prolongador de la malla <coarse> a la malla <fine>,
+            obtenida de ella con Mesh::refine(), donde <parents> contiene los extremos
+            del lado de cada nodo nuevo. Se reciben los nodos libres de ambas mallas.
+        */
+        static SparseMatrix* prolongator(Mesh* coarse, Mesh* fine, int* parents, int* coarse_free, int nc, int* fine_free, int nf){
+            int coarse_nodes = coarse->get_quantity(NUM_NODES);
+            int fine_nodes = fine->get_quantity(NUM_NODES);
+            int* I = (int*) malloc(sizeof(int)*2*fine_nodes);
+            int* J = (int*) malloc(sizeof(int)*2*fine_nodes);
+            real* V = (real*) malloc(sizeof(real)*2*fine_nodes);
+            int count = 0;
+
+            //Las posiciones de los nodos en la malla fina no cambian al renumerarla, por lo
+            //que se recorren por posición: las primeras corresponden a los nodos de la malla
+            //gruesa, y las siguientes a los puntos medios de sus lados
+            for(int p = 0; p < fine_nodes; p++){
+                int i = fine_free[fine->get_node_at(p)->get_ID() - 1];
+                if(i < 0) continue;
+                if(p < coarse_nodes){
+                    int j = coarse_free[coarse->get_node_at(p)->get_ID() - 1];
+                    if(j >= 0){ I[count] = i; J[count] = j; V[count] = 1; count++; }
+                }
+                else{
+                    int k = p - coarse_nodes;
+                    for(int s = 0; s < 2; s++){
+                        int j = coarse_free[parents[2*k+s] - 1];
+                        if(j >= 0){ I[count] = i; J[count] = j; V[count] = 0.5; count++; }
+                    }
+                }
+            }
+
+            SparseMatrix* result = new SparseMatrix(nf, nc, count, I, J, V);
+            free(I); free(J); free(V);
+            return result;
+        }
+
+    public:
+        /*
+            Constructor que construye la jerarquía a partir de las <nmeshes> mallas
+            <meshes>, de la más gruesa (posición 0) a la más fina, donde la malla en
+            la posición m+1 se obtuvo de la malla en la posición m con Mesh::refine(),
+            que colocó en <parents>[m] los extremos de sus nodos nuevos.
+        */
+        GeometricMultigrid(Mesh** meshes, int** parents, int nmeshes){
+            if(nmeshes > MAX_LEVELS){
+                cerr << "Too many refinement levels for the multigrid hierarchy. :(\n";
+                exit(EXIT_FAILURE);
+            }
+            nlevels = nmeshes;
+
+            //El nivel l corresponde a la malla en la posición nmeshes-1-l
+            int fine_count;
+            int* fine_free = free_numbering(meshes[nmeshes-1], &fine_count);
+            A[0] = stiffness_matrix(meshes[nmeshes-1], fine_free, fine_count);
+            P[0] = NULL;
+
+            for(int l = 1; l < nlevels; l++){
+                int m = nmeshes-1-l;
+                int coarse_count;
+                int* coarse_free = free_numbering(meshes[m], &coarse_count);
+
+                P[l] = prolongator(meshes[m], meshes[m+1], parents[m], coarse_free, coarse_count, fine_free, fine_count);
+                R[l-1] = P[l]->transpose();
+
+                //A_c = P^T * ( A * P )
+                SparseMatrix* AP = SparseMatrix::multiply(A[l-1], P[l]);
+                A[l] = SparseMatrix::multiply(R[l-1], AP);
+                delete AP;
+
+                free(fine_free);
+                fine_free = coarse_free;
+                fine_count = coarse_count;
+            }
+            R[nlevels-1] = NULL;
+            free(fine_free);
+
+            prepare_levels();
+        }
+};
@@ -0,0 +1,139 @@
+/*
+    Clase para la solución iterativa de sistemas de ecuaciones A * x = b con
+    A simétrica y definida positiva, como la matriz K reducida del MEF.
+
+    A diferencia de la factorización de Cholesky, los métodos iterativos
+    únicamente requieren calcular productos A * v, por lo que la matriz A no
+    necesita estar ensamblada: basta un "operador", es decir, cualquier objeto
+    con una función:
+
+                void apply(real* x, real* y)          //y = A * x
+
+    sobre arreglos de longitud size(), como ElementOperator. De la misma forma,
+    un precondicionador es cualquier objeto con una función:
+
+                void apply(real* r, real* z)          //z ~= A^(-1) * r
+
+    que aproxima la solución del sistema con lado derecho r.
+*/
+
+/*
+    Precondicionador de Jacobi: aproxima A^(-1) con el inverso de la diagonal
+    de A, es decir, z_i = r_i / A_ii.
+*/
+class JacobiPreconditioner{
+    private:
+        int n;                  //Longitud de los vectores
+        real* inverse;          //Inversos de la diagonal de A
+
+    public:
+        /*
+            Constructor que prepara el precondicionador a partir del operador <A>,
+            el cual debe ofrecer la función diagonal().
+        */
+        template <typename Operator>
+        JacobiPreconditioner(Operator* A){
+            n = A->size();
+            inverse = (real*) malloc(sizeof(real)*n);
+            A->diagonal(inverse);
+            for(int i = 0; i < n; i++) inverse[i] = 1/inverse[i];
+            Perf::count_allocation(sizeof(real)*n);
+        }
+
+        /*
+            Destructor, libera el arreglo de la diagonal.
+        */
+        ~JacobiPreconditioner(){
+            free(inverse);
+        }
+
+        /*
+            Función que calcula z = D^(-1) * r.
+        */
+        void apply(real* r, real* z){
+            for(int i = 0; i < n; i++) z[i] = inverse[i]*r[i];
+            Perf::count_flops(n);
+        }
+};
+
+class Iterative{
+    private:
+        /*
+            Función que calcula el producto punto de <x> y <y>, de longitud <n>.
+            La suma se acumula en doble precisión para que el error de redondeo
+            no crezca con la cantidad de nodos.
+        */
+        static double dot(real* x, real* y, int n){
+            double acum = 0;
+            for(int i = 0; i < n; i++) acum += (double) x[i]*y[i];
+            Perf::count_flops(2LL*n);
+            return acum;
+        }
+
+    public:
+        /*
+            Función que resuelve el sistema A * x = <b> con el método del gradiente
+            conjugado precondicionado, donde <A> es el operador del sistema y <P> su
+            precondicionador. Ambos vectores tienen longitud <n>, y <x> contiene al
+            inicio la aproximación inicial y al final la solución.
+
+            En cada iteración k, con r = b - A*x el residuo y z = P(r):
+
+                    alpha = (r . z) / (p . A*p)
+                    x     = x + alpha*p
+                    r     = r - alpha*A*p
+                    z     = P(r)
+                    beta  = (r . z)_nuevo / (r . z)_anterior
+                    p     = z + beta*p
+
+            El proceso se detiene cuando ||r|| <= <tolerance> * ||b||, o al llegar a
+            <max_iterations> iteraciones. Se retorna la cantidad de iteraciones
+            realizadas, y en <residual> (si no es NULL) el residuo relativo final.
+        */
+        template <typename Operator, typename Preconditioner>
+        static int conjugate_gradient(Operator* A, Preconditioner* P, real* b, real* x, int n, float tolerance, int max_iterations, float* residual = NULL){
+            real* r = (real*) malloc(sizeof(real)*n);
+            real* z = (real*) malloc(sizeof(real)*n);
+            real* p = (real*) malloc(sizeof(real)*n);
+            real* Ap = (real*) malloc(sizeof(real)*n);
+            Perf::count_allocation(4*sizeof(real)*n, 4);
+
+            //Residuo inicial
+            A->apply(x, Ap);
+            for(int i = 0; i < n; i++) r[i] = b[i] - Ap[i];
+
+            double norm_b = sqrt(dot(b, b, n));
+            if(norm_b == 0) norm_b = 1;
+            double norm_r = sqrt(dot(r, r, n));
+
+            P->apply(r, z);
+            for(int i = 0; i < n; i++) p[i] = z[i];
+            double rz = dot(r, z, n);
+
+            int k = 0;
+            while(k < max_iterations && norm_r > tolerance*norm_b){
+                A->apply(p, Ap);
+                double alpha = rz/dot(p, Ap, n);
+
+                for(int i = 0; i < n; i++){
+                    x[i] += alpha*p[i];
+                    r[i] -= alpha*Ap[i];
+                }
+                norm_r = sqrt(dot(r, r, n));
+
+                P->apply(r, z);
+                double rz_new = dot(r, z, n);
+                double beta = rz_new/rz;
+                rz = rz_new;
+
+                for(int i = 0; i < n; i++) p[i] = z[i] + beta*p[i];
+                Perf::count_flops(6LL*n);
+                k++;
+            }
+
+            if(residual != NULL) *residual = norm_r/norm_b;
+
+            free(r); free(z); free(p); free(Ap);
+            return k;
+        }
+};
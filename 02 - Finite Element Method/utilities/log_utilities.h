@@ -0,0 +1,59 @@
+/*
+    Enumeración utilizada para determinar el nivel de detalle de los
+    mensajes que el programa muestra durante su ejecución:
+        - LEVEL_QUIET para no mostrar nada salvo los errores.
+        - LEVEL_PROGRESS para mostrar las etapas principales del proceso y
+          una sola línea por cada paso de tiempo.
+        - LEVEL_DEBUG para mostrar además el detalle de cada elemento en
+          cada paso de tiempo.
+*/
+enum log_level {LEVEL_QUIET,LEVEL_PROGRESS,LEVEL_DEBUG};
+
+/*
+    Clase utilitaria para la administración de los mensajes del programa.
+
+    La clase únicamente almacena el nivel de detalle solicitado, los mensajes
+    como tal se muestran a través de las macros LOG_PROGRESS y LOG_DEBUG, que
+    reciben una secuencia de datos con el mismo formato que cout:
+
+            LOG_PROGRESS( "Working at TIME = " << t << "s\n" );
+
+    Los mensajes de nivel de depuración se encuentran dentro de los ciclos
+    por elemento, por lo que en una compilación de producción (compilada con
+    -DNDEBUG) la macro LOG_DEBUG se define vacía y estos mensajes desaparecen
+    por completo del ejecutable, sin costo alguno en tiempo de ejecución.
+*/
+class Log{
+    public:
+        /*
+            Como atributo estático se maneja el nivel de detalle actual,
+            por defecto se muestra únicamente el progreso del proceso.
+            Cada hilo tiene su propio nivel, de modo que los subdominios
+            auxiliares de la solución distribuida pueden silenciarse sin
+            afectar al hilo principal.
+        */
+        inline static thread_local log_level level = LEVEL_PROGRESS;
+
+        /*
+            Función para definir el nivel de detalle de los mensajes.
+        */
+        static void set_level(log_level new_level){
+            level = new_level;
+        }
+
+        /*
+            Función que determina si los mensajes de un nivel <lvl>
+            deben mostrarse con el nivel de detalle actual.
+        */
+        static bool enabled(log_level lvl){
+            return lvl <= level;
+        }
+};
+
+#define LOG_PROGRESS(message) do{ if(Log::enabled(LEVEL_PROGRESS)) cout << message; }while(0)
+
+#ifdef NDEBUG
+    #define LOG_DEBUG(message) do{}while(0)
+#else
+    #define LOG_DEBUG(message) do{ if(Log::enabled(LEVEL_DEBUG)) cout << message; }while(0)
+#endif
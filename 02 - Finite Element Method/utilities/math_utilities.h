@@ -5,6 +5,14 @@
     La clase hace uso de la clase utilitaria SDDS para la manipulación de
     estructuras de datos, así como también de la clase DS para la definición de
     dichas estructuras.
+
+    Todas las funciones son plantillas sobre el tipo <T> de los datos de las
+    matrices, el cual se deduce de las estructuras recibidas, de modo que las
+    mismas operaciones sirven para matrices de float y de double (ver el tipo
+    real en precision_utilities.h). Los escalares sueltos, como el factor de
+    product_in_place() o el valor de init(), se reciben como double y se
+    convierten a <T> antes de operar, para que cualquier constante o variable
+    pueda pasarse sin ambigüedad en la deducción del tipo.
 */
 class Math{
     /*
@@ -21,13 +29,14 @@ class Math{
             |      | = a*d - b*c
             | c  d |
         */
-        static float determinant2x2(DS<float>* M){
+        template <typename T>
+        static T determinant2x2(DS<T>* M){
             //Variables para almacenar los elementos de la matriz
-            float a,b,c,d;
+            T a,b,c,d;
             
             //Se extraen los elementos de la matriz
-            SDDS<float>::extract(M,0,0,&a); SDDS<float>::extract(M,0,1,&b);  //[ a  b ]
-            SDDS<float>::extract(M,1,0,&c); SDDS<float>::extract(M,1,1,&d);  //[ c  d ]
+            SDDS<T>::extract(M,0,0,&a); SDDS<T>::extract(M,0,1,&b);  //[ a  b ]
+            SDDS<T>::extract(M,1,0,&c); SDDS<T>::extract(M,1,1,&d);  //[ c  d ]
 
             return a*d - b*c;
         }
@@ -39,14 +48,15 @@ class Math{
             | d  e  f | = (a*e*i + b*f*g + c*d*h) - (c*e*g + a*f*h + b*d*i)
             | g  h  i |
         */
-        static float determinant3x3(DS<float>* M){
+        template <typename T>
+        static T determinant3x3(DS<T>* M){
             //Variables para almacenar los elementos de la matriz
-            float a,b,c,d,e,f,g,h,i;
+            T a,b,c,d,e,f,g,h,i;
             
             //Se extraen los elementos de la matriz
-            SDDS<float>::extract(M,0,0,&a); SDDS<float>::extract(M,0,1,&b); SDDS<float>::extract(M,0,2,&c);  //[ a  b  c ]
-            SDDS<float>::extract(M,1,0,&d); SDDS<float>::extract(M,1,1,&e); SDDS<float>::extract(M,1,2,&f);  //[ d  e  f ]
-            SDDS<float>::extract(M,2,0,&g); SDDS<float>::extract(M,2,1,&h); SDDS<float>::extract(M,2,2,&i);  //[ g  h  i ]
+            SDDS<T>::extract(M,0,0,&a); SDDS<T>::extract(M,0,1,&b); SDDS<T>::extract(M,0,2,&c);  //[ a  b  c ]
+            SDDS<T>::extract(M,1,0,&d); SDDS<T>::extract(M,1,1,&e); SDDS<T>::extract(M,1,2,&f);  //[ d  e  f ]
+            SDDS<T>::extract(M,2,0,&g); SDDS<T>::extract(M,2,1,&h); SDDS<T>::extract(M,2,2,&i);  //[ g  h  i ]
 
             return (a*e*i + b*f*g + c*d*h) - (c*e*g + a*f*h + b*d*i);
         }
@@ -60,26 +70,26 @@ class Math{
             Finitos en 2D, se sabe que solo serán necesarios los determinantes
             de matrices 2 x 2 y 3 x 3.
         */
-        static float determinant(DS<float>* M){
+        template <typename T>
+        static T determinant(DS<T>* M){
             //Se extraen las dimensiones de la matriz
             int nrows, ncols;
-            SDDS<float>::extension(M,&nrows,&ncols);
+            SDDS<T>::extension(M,&nrows,&ncols);
 
             //Se determina la función auxiliar a invocar
             if(nrows == 2) return determinant2x2(M);
             else
                 if(nrows == 3) return determinant3x3(M);
                 else{
-                    float value, det = 0;
-                    DS<float>* temp;
+                    T value, det = 0;
+                    DS<T>* temp;
                     for(int j = 0; j < ncols; j++){
-                        SDDS<float>::create(&temp,nrows-1,ncols-1,MATRIX);
-                        reduce_matrix(temp,M,0,j);
+                        reduce_matrix(&temp,M,0,j);
 
-                        SDDS<float>::extract(M,0,j,&value);
+                        SDDS<T>::extract(M,0,j,&value);
                         det += pow(-1,j)*value*determinant(temp);
 
-                        SDDS<float>::destroy(temp);
+                        SDDS<T>::destroy(temp);
                     }
                     return det;
                 }
@@ -89,58 +99,30 @@ class Math{
             Función que construye la reducción de una matriz, correspondiente
             a eliminar la fila y la columna indicadas de la matriz original.
 
-            Se recibe <R> como la matriz reducida a construir, <M> como la
-            matriz original, y <row> y <column> como la fila y columna que
-            se desean eliminar de la matriz original.
-        */
-        static void reduce_matrix(DS<float>* R, DS<float>* M, int row, int column){
-            /*
-                Se definen las variables auxiliares del proceso.
+            La reducción no copia las celdas de la matriz original, sino que
+            se construye como una vista sobre ella (ver DSMV.h) con todas sus
+            filas excepto <row> y todas sus columnas excepto <column>, por lo
+            que solo ocupa la memoria de sus índices. Al liberar la vista con
+            SDDS::destroy() la matriz original se conserva.
 
-                <nrows> y <ncols> se usan para almacenar las dimensiones de
-                la matrix proporcionada.
+            Se recibe <R> por referencia como la matriz reducida a construir,
+            <M> como la matriz original, y <row> y <column> como la fila y
+            columna que se desean eliminar de la matriz original.
+        */
+        template <typename T>
+        static void reduce_matrix(DS<T>** R, DS<T>* M, int row, int column){
+            int nrows, ncols;
+            SDDS<T>::extension(M,&nrows,&ncols);
 
-                <row_index> y <col_index> se utilizarán para llevar un control
-                de las posiciones a llenar en la matriz reducida, ambas inician
-                en 0 ya que primero se llenará su posición (0,0).
-            */
-            int nrows, ncols, row_index = 0, col_index = 0;
+            //Se preparan los índices de las filas y las columnas que se conservan
+            int* rows = (int*) malloc(sizeof(int)*(nrows-1));
+            int* cols = (int*) malloc(sizeof(int)*(ncols-1));
+            for(int i = 0, k = 0; i < nrows; i++) if(i != row) rows[k++] = i;
+            for(int j = 0, k = 0; j < ncols; j++) if(j != column) cols[k++] = j;
 
-            //Se extraen las dimensiones de la matriz original
-            SDDS<float>::extension(M,&nrows,&ncols);
+            SDDS<T>::create_view(R, M, nrows-1, rows, ncols-1, cols, false);
 
-            //Se recorre la matriz original
-            for(int i = 0; i < nrows; i++){
-
-                //Si la fila actual no es la que debe eliminarse, se procede
-                //al recorrido de sus columnas, de lo contrario se ignora
-                if(i != row){
-                    //Se recorre la fila actual
-                    for(int j = 0; j < nrows; j++){
-
-                        ////Si la columna actual no es la que debe eliminarse, se procede
-                        //a almacenar el valor de la celda actual en la matriz reducida,
-                        //de lo contrario se ignora
-                        if(j != column){
-                            //Se extrae el valor de la celda actual
-                            float value;
-                            SDDS<float>::extract(M,i,j,&value);
-
-                            //Se ingresa el valor extraído en la matriz reducida,
-                            //en la posición actualmente indicada por <row_index> y <col_index>
-                            SDDS<float>::insert(R,row_index,col_index,value);
-
-                            //Se avanza en las columnas de la matriz reducida
-                            col_index++;
-                        }
-                    }
-                    //Dado que se terminó el recorrido de una fila en la matriz original,
-                    //se avanza en las filas de la matriz reducida y...
-                    row_index++;
-                    //... se retrocede en las columnas de la matriz reducida
-                    col_index = 0;
-                }
-            }
+            free(rows); free(cols);
         }
 
         /*
@@ -163,35 +145,33 @@ class Math{
             el determinante de la matriz reducida que se obtiene al eliminar
             la fila i y la columna j de la matriz original.
         */
-        static void cofactors(DS<float>* C, DS<float>* M){
+        template <typename T>
+        static void cofactors(DS<T>* C, DS<T>* M){
             //Se preparan las variables auxiliares del proceso
             int nrows, ncols;
-            DS<float>* M_reduced;
+            DS<T>* M_reduced;
 
             //Se extraen las dimensiones de la matriz original
-            SDDS<float>::extension(C,&nrows,&ncols);
+            SDDS<T>::extension(C,&nrows,&ncols);
 
             //Se recorre la matriz original
             for(int i = 0; i < nrows; i++){
                 for(int j = 0; j < nrows; j++){
-                    //Se prepara una matriz con dimensiones (nrows-1) x (ncols-1)
-                    //para almacenar la matriz reducida que se obtendrá al
-                    //eliminar la fila i y la columna j de la matriz original
-                    SDDS<float>::create(&M_reduced,nrows-1,ncols-1,MATRIX);
-                    //Se construye dicha matriz reducida
-                    reduce_matrix(M_reduced,M,i,j);
+                    //Se construye la matriz reducida, de dimensiones (nrows-1) x (ncols-1),
+                    //que se obtiene al eliminar la fila i y la columna j de la matriz original
+                    reduce_matrix(&M_reduced,M,i,j);
 
                     //Se calcula el menor de la posición actual como el determinante
                     //de la matriz reducida
-                    float m_ij = determinant(M_reduced);
+                    T m_ij = determinant(M_reduced);
 
                     //Se ingresa en la matriz de cofactores el menor obtenido
                     //multiplicado por el signo alternante
-                    SDDS<float>::insert(C, i,j, pow(-1,i+j)*m_ij);
+                    SDDS<T>::insert(C, i,j, pow(-1,i+j)*m_ij);
 
-                    //Se libera el espacio en memoria para la matriz reducida
-                    //construida ya que no se utilizará más
-                    SDDS<float>::destroy(M_reduced);
+                    //Se libera la matriz reducida construida, es decir, sus índices,
+                    //ya que no se utilizará más
+                    SDDS<T>::destroy(M_reduced);
                 }
             }
         }
@@ -207,16 +187,17 @@ class Math{
 
             Se recibe <matrix> como la matriz a llenar con ceros.
         */
-        static void zeroes(DS<float>* matrix){
+        template <typename T>
+        static void zeroes(DS<T>* matrix){
             //Se extraen las dimensiones de la matriz
             int nrows, ncols;
-            SDDS<float>::extension(matrix,&nrows,&ncols);
+            SDDS<T>::extension(matrix,&nrows,&ncols);
 
             //Se recorre la matriz
             for(int i = 0; i < nrows; i++)
                 for(int j = 0; j < ncols; j++)
                     //Se coloca un 0 en la celda actual
-                    SDDS<float>::insert(matrix,i,j,0);
+                    SDDS<T>::insert(matrix,i,j,0);
         }
 
         /*
@@ -226,16 +207,17 @@ class Math{
             Se recibe <matrix> como la matriz a inicializar, y se
             recibe <value> como el dato a colocar en todas las celdas.
         */
-        static void init(DS<float>* matrix, float value){
+        template <typename T>
+        static void init(DS<T>* matrix, double value){
             //Se extraen las dimensiones de la matriz
             int nrows, ncols;
-            SDDS<float>::extension(matrix,&nrows,&ncols);
+            SDDS<T>::extension(matrix,&nrows,&ncols);
 
             //Se recorre la matriz
             for(int i = 0; i < nrows; i++)
                 for(int j = 0; j < ncols; j++)
                     //Se coloca <value> en la celda actual
-                    SDDS<float>::insert(matrix,i,j,value);
+                    SDDS<T>::insert(matrix,i,j,(T) value);
         }
 
         /*
@@ -245,25 +227,29 @@ class Math{
             se almacena en la primera matriz <A> de la operación,
             sobreescribiendo su contenido anterior.
         */
-        static void sum_in_place(DS<float>* A, DS<float>* B){
+        template <typename T>
+        static void sum_in_place(DS<T>* A, DS<T>* B){
             //Se extraen las dimensiones de <A>
             //Se asume que <B> posee la mismas dimensiones
             int nrows, ncols;
-            SDDS<float>::extension(A,&nrows,&ncols);
+            SDDS<T>::extension(A,&nrows,&ncols);
 
             //Se recorren las dos matrices a la vez
             for(int i = 0; i < nrows; i++)
                 for(int j = 0; j < ncols; j++){
                     //Se extraen los valores en las celdas actuales
                     //en <A> y en <B>
-                    float Aij, Bij;
-                    SDDS<float>::extract(A,i,j,&Aij);
-                    SDDS<float>::extract(B,i,j,&Bij);
+                    T Aij, Bij;
+                    SDDS<T>::extract(A,i,j,&Aij);
+                    SDDS<T>::extract(B,i,j,&Bij);
 
                     //Se inserta la suma de los valores extraídos en
                     //la celda actual de <A>
-                    SDDS<float>::insert(A,i,j,Aij+Bij);
+                    SDDS<T>::insert(A,i,j,Aij+Bij);
                 }
+
+            //Se registra una suma por celda
+            Perf::count_flops((long long) nrows*ncols);
         }
 
         /*
@@ -274,22 +260,26 @@ class Math{
             se almacena en la primera matriz <A> de la operación,
             sobreescribiendo su contenido anterior.
         */
-        static void product_in_place(DS<float>* A, float factor){
+        template <typename T>
+        static void product_in_place(DS<T>* A, double factor){
             //Se extraen las dimensiones de <A>
             int nrows, ncols;
-            SDDS<float>::extension(A,&nrows,&ncols);
+            SDDS<T>::extension(A,&nrows,&ncols);
 
             //Se recorre la matriz <A>
             for(int i = 0; i < nrows; i++)
                 for(int j = 0; j < ncols; j++){
                     //Se extrae el valor en la celda actual de <A>
-                    float Aij;
-                    SDDS<float>::extract(A,i,j,&Aij);
+                    T Aij;
+                    SDDS<T>::extract(A,i,j,&Aij);
 
                     //Se inserta en la celda actual de <A> el valor
                     //extraído multiplicado por <factor>
-                    SDDS<float>::insert(A,i,j,Aij*factor);
+                    SDDS<T>::insert(A,i,j,Aij*(T) factor);
                 }
+
+            //Se registra una multiplicación por celda
+            Perf::count_flops((long long) nrows*ncols);
         }
 
         /*
@@ -331,24 +321,31 @@ class Math{
             Es decir, se multiplica elemento por elemento de la fila i de A y
             la columna j de B, sumando estos resultados parciales.
 
+            La sumatoria se acumula siempre en double, aun cuando las matrices
+            sean de float, de modo que el error de redondeo de cada celda no crece
+            con la cantidad de términos q; el resultado se redondea a <T> una
+            sola vez al almacenarlo.
+
             Un diagrama ilustrativo de este proceso puede consultarse en el
             siguiente enlace: https://tinyurl.com/mr4x7b5a
         */
-        static DS<float>* product(DS<float>* A, DS<float>* B){
+        template <typename T>
+        static DS<T>* product(DS<T>* A, DS<T>* B){
             //Se preparan las variables auxiliares del proceso
             int p, q, r;
-            float Aij, Bij, Cij;
-            DS<float>* C;
+            T Aij, Bij;
+            double Cij;
+            DS<T>* C;
 
             //Se extraen las dimensiones de <A> y <B>
             //Se asume que la cantidad de columnas de <A> es igual a la
             //cantidad de filas de <B>
-            SDDS<float>::extension(A,&p,&q);
-            SDDS<float>::extension(B,&q,&r);
+            SDDS<T>::extension(A,&p,&q);
+            SDDS<T>::extension(B,&q,&r);
 
             //Se crea la matriz <C> con una cantidad de filas igual a la
             //de <A> y una cantidad de columnas igual a la de <B>
-            SDDS<float>::create(&C,p,r,MATRIX);
+            SDDS<T>::create(&C,p,r,MATRIX);
 
             //Se recorren las posiciones de la matriz <C>
             for(int i = 0; i < p; i++)
@@ -361,17 +358,20 @@ class Math{
                         //Se extraen los valores en:
                         //  - La posición (i,k) de <A>.
                         //  - La posición (k,j) de <B>
-                        SDDS<float>::extract(A,i,k,&Aij);
-                        SDDS<float>::extract(B,k,j,&Bij);
+                        SDDS<T>::extract(A,i,k,&Aij);
+                        SDDS<T>::extract(B,k,j,&Bij);
 
                         //Se acumula la multiplicación de los valores extraídos
-                        Cij += Aij*Bij;
+                        Cij += (double) Aij*Bij;
                     }
 
                     //Se almacena el acumulador en la posición (i,j) de <C>
-                    SDDS<float>::insert(C,i,j,Cij);
+                    SDDS<T>::insert(C,i,j,(T) Cij);
                 }
 
+            //Se registran una multiplicación y una suma por cada término
+            Perf::count_flops(2LL*p*q*r);
+
             //Se retorna la matriz resultante
             return C;
         }
@@ -391,21 +391,22 @@ class Math{
             Es decir, un dato en la posición (i,j) de la matriz original
             estará ubicado en la posición (j,i) de la matriz transpuesta.
         */
-        static void transpose(DS<float>* trans_M, DS<float>* M){
+        template <typename T>
+        static void transpose(DS<T>* trans_M, DS<T>* M){
             //Se extraen las dimensiones de la matriz original
             int nrows, ncols;
-            SDDS<float>::extension(M,&nrows,&ncols);
+            SDDS<T>::extension(M,&nrows,&ncols);
 
             //Se recorre la matriz original
             for(int i = 0; i < nrows; i++)
                 for(int j = 0; j < ncols; j++){
                     //Se extrae el dato en la celda actual
-                    float Aij;
-                    SDDS<float>::extract(M,i,j,&Aij);
+                    T Aij;
+                    SDDS<T>::extract(M,i,j,&Aij);
 
                     //Se inserta el dato extraído en la celda correspondiente
                     //de la matriz transpuesta
-                    SDDS<float>::insert(trans_M,j,i,Aij);
+                    SDDS<T>::insert(trans_M,j,i,Aij);
                 }
         }
 
@@ -416,13 +417,57 @@ class Math{
             Se recibe <A> como la matriz, <i> y <j> como los índices de la
             celda de interés, y <value> como el dato a añadir a dicha celda.
         */
-        static void add_to_cell(DS<float>* A, int i, int j, float value){
+        template <typename T>
+        static void add_to_cell(DS<T>* A, int i, int j, T value){
             //Se extrae el valor en la posición (i,j) de <A>
-            float Aij;
-            SDDS<float>::extract(A,i,j,&Aij);
+            T Aij;
+            SDDS<T>::extract(A,i,j,&Aij);
 
             //Se inserta en la misma posición el valor extraído sumándole <value>
-            SDDS<float>::insert(A,i,j,Aij+value);
+            SDDS<T>::insert(A,i,j,Aij+value);
+            Perf::count_flops(1);
+        }
+
+        /*
+            Función que calcula la norma infinito de una matriz <A>, es decir,
+            el mayor valor absoluto entre todas sus celdas. Para un vector
+            columna corresponde a su componente de mayor magnitud.
+        */
+        template <typename T>
+        static T max_norm(DS<T>* A){
+            int nrows, ncols;
+            SDDS<T>::extension(A,&nrows,&ncols);
+
+            T norm = 0, Aij;
+            for(int i = 0; i < nrows; i++)
+                for(int j = 0; j < ncols; j++){
+                    SDDS<T>::extract(A,i,j,&Aij);
+                    norm = max(norm, (T) fabs(Aij));
+                }
+            return norm;
+        }
+
+        /*
+            Función que calcula la norma infinito de la diferencia entre dos
+            matrices <A> y <B> de las mismas dimensiones, sin construir la
+            matriz diferencia.
+        */
+        template <typename T>
+        static T max_difference(DS<T>* A, DS<T>* B){
+            int nrows, ncols;
+            SDDS<T>::extension(A,&nrows,&ncols);
+
+            T norm = 0, Aij, Bij;
+            for(int i = 0; i < nrows; i++)
+                for(int j = 0; j < ncols; j++){
+                    SDDS<T>::extract(A,i,j,&Aij);
+                    SDDS<T>::extract(B,i,j,&Bij);
+                    norm = max(norm, (T) fabs(Aij-Bij));
+                }
+
+            //Se registra una resta por celda
+            Perf::count_flops((long long) nrows*ncols);
+            return norm;
         }
 
         /*
@@ -451,24 +496,25 @@ class Math{
             ya que es el único caso posible en la aplicación del Método de los Elementos
             Finitos en 2D.
         */
-        static DS<float>* inverse(DS<float>* matrix){
+        template <typename T>
+        static DS<T>* inverse(DS<T>* matrix){
             //Se calcula el determinante de la matriz
-            float D = determinant(matrix);
+            T D = determinant(matrix);
 
             //Se preparan variables para la matriz de cofactores
             //y la matriz adjunta
-            DS<float> *Cof, *Adj;
+            DS<T> *Cof, *Adj;
 
             int nrows, ncols;
-            SDDS<float>::extension(matrix,&nrows,&ncols);
+            SDDS<T>::extension(matrix,&nrows,&ncols);
 
             //Se define la matriz de cofactores como una matriz 3 x 3
-            SDDS<float>::create(&Cof,nrows,ncols,MATRIX);
+            SDDS<T>::create(&Cof,nrows,ncols,MATRIX);
             //Se construye la matriz de cofactores
             cofactors(Cof, matrix);
 
             //Se define la matriz adjunta como una matriz 3 x 3
-            SDDS<float>::create(&Adj,ncols,nrows,MATRIX);
+            SDDS<T>::create(&Adj,ncols,nrows,MATRIX);
             //Se construye la matriz adjunta como la transpuesta de
             //la matriz de cofactores
             transpose(Adj, Cof);
@@ -479,47 +525,50 @@ class Math{
 
             //La matriz de cofactores ya no se utilizará, por lo que
             //se libera el espacio en memoria asignado para su contenido
-            SDDS<float>::destroy(Cof);
+            SDDS<T>::destroy(Cof);
 
             //Se retorna la matriz resultante del proceso
             return Adj;
         }
 
-        static DS<float>* inverse_Cholesky(DS<float>* matrix){
+        template <typename T>
+        static DS<T>* inverse_Cholesky(DS<T>* matrix){
             int f, c;
-            float acum, value, other_value;
-            DS<float> *L, *U, *M;
+            T acum, value, other_value;
+            DS<T> *L, *U, *M;
 
-            SDDS<float>::extension(matrix, &f, &c);
-            SDDS<float>::create(&L, f, c, MATRIX);
-            SDDS<float>::create(&U, f, c, MATRIX);
-            SDDS<float>::create(&M, f, c, MATRIX);
+            SDDS<T>::extension(matrix, &f, &c);
+            SDDS<T>::create(&L, f, c, MATRIX);
+            SDDS<T>::create(&U, f, c, MATRIX);
+            SDDS<T>::create(&M, f, c, MATRIX);
 
             for(int i= 0; i < f; i++){
                 for(int j= 0; j < c; j++){
                     if(i == j){
                         acum = 0;
                         for(int k = 0; k < j; k++){
-                            SDDS<float>::extract(L, j, k, &value);
+                            SDDS<T>::extract(L, j, k, &value);
                             acum += pow(value,2);
                         }
-                        SDDS<float>::extract(matrix, j, j, &value);
-                        SDDS<float>::insert(L, j, j, sqrt(value - acum));
+                        SDDS<T>::extract(matrix, j, j, &value);
+                        SDDS<T>::insert(L, j, j, sqrt(value - acum));
+                        Perf::count_flops(2LL*j + 2);
                     }
                     else{
                         if(i > j){
                             acum = 0;
                             for(int k = 0; k < j; k++){
-                                SDDS<float>::extract(L, i, k, &value);
-                                SDDS<float>::extract(L, j, k, &other_value);
+                                SDDS<T>::extract(L, i, k, &value);
+                                SDDS<T>::extract(L, j, k, &other_value);
                                 acum += value*other_value;
                             }
-                            SDDS<float>::extract(L, j, j, &value);
-                            SDDS<float>::extract(matrix, i, j, &other_value);
-                            SDDS<float>::insert(L, i, j, (1/value)*(other_value - acum));
+                            SDDS<T>::extract(L, j, j, &value);
+                            SDDS<T>::extract(matrix, i, j, &other_value);
+                            SDDS<T>::insert(L, i, j, (1/value)*(other_value - acum));
+                            Perf::count_flops(2LL*j + 3);
                         } 
                         else{
-                            SDDS<float>::insert(L, i, j, 0);
+                            SDDS<T>::insert(L, i, j, 0);
                         }
                     }
                 }
@@ -528,22 +577,24 @@ class Math{
             for(int i= 0; i < f; i++){
                 for(int j= 0; j < c; j++){
                     if(i == j){
-                        SDDS<float>::extract(L, j, j, &value);
-                        SDDS<float>::insert(U, j, j, 1/value);
+                        SDDS<T>::extract(L, j, j, &value);
+                        SDDS<T>::insert(U, j, j, 1/value);
+                        Perf::count_flops(1);
                     }
                     else{
                         if(i > j){
                             acum = 0;
                             for(int k = j; k < i; k++){
-                                SDDS<float>::extract(L, i, k, &value);
-                                SDDS<float>::extract(U, k, j, &other_value);
+                                SDDS<T>::extract(L, i, k, &value);
+                                SDDS<T>::extract(U, k, j, &other_value);
                                 acum += value*other_value;
                             }
-                            SDDS<float>::extract(L, i, i, &value);
-                            SDDS<float>::insert(U, i, j, -(1/value)*acum);
+                            SDDS<T>::extract(L, i, i, &value);
+                            SDDS<T>::insert(U, i, j, -(1/value)*acum);
+                            Perf::count_flops(2LL*(i-j) + 2);
                         }
                         else{
-                            SDDS<float>::insert(U, i, j, 0);
+                            SDDS<T>::insert(U, i, j, 0);
                         }
                     }
                 }
@@ -553,18 +604,19 @@ class Math{
                 for(int j= 0; j < c; j++){
                     acum = 0;
                     for(int k = i+1; k < f; k++){
-                        SDDS<float>::extract(L, k, i, &value);
-                        SDDS<float>::extract(M, k, j, &other_value);
+                        SDDS<T>::extract(L, k, i, &value);
+                        SDDS<T>::extract(M, k, j, &other_value);
                         acum += value*other_value;
                     }
-                    SDDS<float>::extract(L, i, i, &value);
-                    SDDS<float>::extract(U, i, j, &other_value);
-                    SDDS<float>::insert(M, i, j, (1/value)*( ((i>=j)?other_value:0) - acum ));
+                    SDDS<T>::extract(L, i, i, &value);
+                    SDDS<T>::extract(U, i, j, &other_value);
+                    SDDS<T>::insert(M, i, j, (1/value)*( ((i>=j)?other_value:0) - acum ));
+                    Perf::count_flops(2LL*(f-i-1) + 3);
                 }
             }
 
-            SDDS<float>::destroy(L);
-            SDDS<float>::destroy(U);
+            SDDS<T>::destroy(L);
+            SDDS<T>::destroy(U);
 
             return M;
         }
@@ -0,0 +1,252 @@
+/*
+    Clase para aplicar la matriz K global del proceso MEF2D sin ensamblarla,
+    elemento por elemento ("matrix-free").
+
+    La matriz K local de un elemento se calcula en FEM::calculate_local_K como:
+
+                K_e = (k*Area/D^2) * B^T * A^T * A * B
+
+    Llamando G = A * B, una matriz de 2 x 3 que depende únicamente de las
+    coordenadas del elemento, el producto de K_e por las temperaturas t_e de
+    los tres nodos del elemento se calcula como:
+
+                K_e * t_e = s * G^T * ( G * t_e ),      s = k*Area/D^2 = k/(2*|D|)
+
+    es decir, con dos combinaciones de las tres temperaturas y su proyección de
+    regreso, sin formar la matriz de 3 x 3. El producto K * T global es la suma
+    de estas contribuciones sobre todos los elementos.
+
+    Al construir el operador se precalculan, para cada elemento, las seis
+    entradas de G, el factor s, el valor J = |D| y los índices de sus nodos. Cada
+    uno se guarda en un arreglo propio con un dato por elemento (estructura de
+    arreglos), de modo que el recorrido de los elementos lee cada arreglo de
+    forma contigua. El operador ocupa así 13 datos por elemento en lugar de los
+    datos de K, a cambio de recalcular el producto en cada aplicación.
+
+    El operador trabaja directamente sobre los "nodos libres": el índice de cada
+    nodo es su fila en los vectores de temperaturas de los nodos libres, o -1 si
+    tiene condición de Dirichlet, en cuyo caso su temperatura es el valor de
+    Dirichlet. De este modo apply() calcula:
+
+                y = K_ff * x + K_fd * Td
+
+    que con Td = 0 es el producto por la matriz K ya reducida, y con x = 0 es el
+    vector adicional de las condiciones de Dirichlet (ver FEM::apply_Dirichlet()).
+*/
+class ElementOperator{
+    private:
+        int nelems;             //Cantidad de elementos
+        int n;                  //Cantidad de nodos libres
+        int *node0, *node1, *node2;                     //Índices libres de los nodos, o -1
+        real *g00, *g01, *g02, *g10, *g11, *g12;        //Filas de G = A * B
+        real *scale;            //Factor s = k*Area/D^2
+        real *J;                //Valor J = |D|, el doble del área
+
+        /*
+            Función que reserva un arreglo de <count> datos de tipo <T>,
+            registrando la reserva para las mediciones de desempeño.
+        */
+        template <typename T>
+        static T* allocate(int count){
+            Perf::count_allocation(sizeof(T)*count);
+            return (T*) malloc(sizeof(T)*count);
+        }
+
+    public:
+        /*
+            Constructor que precalcula los factores geométricos de todos los elementos
+            de la malla <G>, con <thermal_k> como la conductividad térmica, y con
+            <dirichlet_indices> como el conjunto de IDs de los nodos con condición de
+            Dirichlet.
+        */
+        ElementOperator(Mesh* G, DS<int>* dirichlet_indices, real thermal_k){
+            nelems = G->get_quantity(NUM_ELEMENTS);
+            int nnodes = G->get_quantity(NUM_NODES);
+
+            //Se numeran los nodos libres en el orden de sus IDs, igual que al reducir
+            //las matrices globales
+            int* free_index = (int*) malloc(sizeof(int)*nnodes);
+            n = 0;
+            for(int i = 0; i < nnodes; i++){
+                bool is_dirichlet;
+                SDDS<int>::search(dirichlet_indices, i+1, &is_dirichlet);
+                free_index[i] = is_dirichlet ? -1 : n++;
+            }
+
+            node0 = allocate<int>(nelems); node1 = allocate<int>(nelems); node2 = allocate<int>(nelems);
+            g00 = allocate<real>(nelems); g01 = allocate<real>(nelems); g02 = allocate<real>(nelems);
+            g10 = allocate<real>(nelems); g11 = allocate<real>(nelems); g12 = allocate<real>(nelems);
+            scale = allocate<real>(nelems);
+            J = allocate<real>(nelems);
+
+            for(int e = 0; e < nelems; e++){
+                Element* elem = G->get_element_at(e);
+                Point* P1 = elem->get_Node(0)->get_Point();
+                Point* P2 = elem->get_Node(1)->get_Point();
+                Point* P3 = elem->get_Node(2)->get_Point();
+
+                node0[e] = free_index[elem->get_Node(0)->get_ID() - 1];
+                node1[e] = free_index[elem->get_Node(1)->get_ID() - 1];
+                node2[e] = free_index[elem->get_Node(2)->get_ID() - 1];
+
+                //Matriz A, tal como en FEM::calculate_local_A()
+                real a00 = P3->get_y() - P1->get_y(), a01 = P1->get_y() - P2->get_y();
+                real a10 = P1->get_x() - P3->get_x(), a11 = P2->get_x() - P1->get_x();
+
+                //G = A * B, con B = [ -1 1 0 ; -1 0 1 ]
+                g00[e] = -(a00 + a01); g01[e] = a00; g02[e] = a01;
+                g10[e] = -(a10 + a11); g11[e] = a10; g12[e] = a11;
+
+                real D = (P2->get_x() - P1->get_x())*(P3->get_y() - P1->get_y()) - (P3->get_x() - P1->get_x())*(P2->get_y() - P1->get_y());
+                J[e] = fabs(D);
+                scale[e] = thermal_k/(2*J[e]);
+            }
+
+            free(free_index);
+        }
+
+        /*
+            Destructor, libera los arreglos de factores.
+        */
+        ~ElementOperator(){
+            free(node0); free(node1); free(node2);
+            free(g00); free(g01); free(g02);
+            free(g10); free(g11); free(g12);
+            free(scale); free(J);
+        }
+
+        /*
+            Función que retorna la cantidad de nodos libres, es decir, la dimensión
+            de los vectores sobre los que opera.
+        */
+        int size(){
+            return n;
+        }
+
+        /*
+            Función que calcula y = K_ff * <x> + K_fd * <Td>, donde <x> y <y> son
+            arreglos de longitud size().
+        */
+        void apply(real* x, real* y, real Td){
+            for(int i = 0; i < n; i++) y[i] = 0;
+
+            for(int e = 0; e < nelems; e++){
+                int a = node0[e], b = node1[e], c = node2[e];
+                real xa = (a >= 0) ? x[a] : Td;
+                real xb = (b >= 0) ? x[b] : Td;
+                real xc = (c >= 0) ? x[c] : Td;
+
+                //u y v son las dos componentes de G * t_e, escaladas por s
+                real u = scale[e]*(g00[e]*xa + g01[e]*xb + g02[e]*xc);
+                real v = scale[e]*(g10[e]*xa + g11[e]*xb + g12[e]*xc);
+
+                //Se proyectan de regreso con G^T, únicamente en los nodos libres
+                if(a >= 0) y[a] += g00[e]*u + g10[e]*v;
+                if(b >= 0) y[b] += g01[e]*u + g11[e]*v;
+                if(c >= 0) y[c] += g02[e]*u + g12[e]*v;
+            }
+
+            //Se registran 12 operaciones para G * t_e, 2 para el escalamiento
+            //y 9 para la proyección, por elemento
+            Perf::count_flops(23LL*nelems);
+        }
+
+        /*
+            Función que calcula y = K_ff * <x>, el producto por la matriz K reducida.
+            Es la operación que utilizan los solucionadores iterativos.
+        */
+        void apply(real* x, real* y){
+            apply(x, y, 0);
+        }
+
+        /*
+            Función que calcula el producto por la matriz K de un vector columna
+            <x> de los nodos libres, colocando el resultado en el vector columna <y>
+            de las mismas dimensiones. Las temperaturas de los nodos con condición
+            de Dirichlet se toman iguales a <Td>.
+        */
+        void apply(DS<real>* x, DS<real>* y, real Td){
+            real* xa = (real*) malloc(sizeof(real)*n);
+            real* ya = (real*) malloc(sizeof(real)*n);
+            for(int i = 0; i < n; i++) SDDS<real>::extract(x, i, 0, &xa[i]);
+            apply(xa, ya, Td);
+            for(int i = 0; i < n; i++) SDDS<real>::insert(y, i, 0, ya[i]);
+            free(xa); free(ya);
+        }
+
+        /*
+            Función que coloca en <d> la diagonal de la matriz K reducida, que
+            utiliza el precondicionador de Jacobi:
+
+                    (K_e)_ii = s * ( G_0i^2 + G_1i^2 )
+        */
+        void diagonal(real* d){
+            for(int i = 0; i < n; i++) d[i] = 0;
+            for(int e = 0; e < nelems; e++){
+                if(node0[e] >= 0) d[node0[e]] += scale[e]*(g00[e]*g00[e] + g10[e]*g10[e]);
+                if(node1[e] >= 0) d[node1[e]] += scale[e]*(g01[e]*g01[e] + g11[e]*g11[e]);
+                if(node2[e] >= 0) d[node2[e]] += scale[e]*(g02[e]*g02[e] + g12[e]*g12[e]);
+            }
+        }
+
+        /*
+            Función que coloca en <b> el vector b global reducido a los nodos libres
+            para la fuente de calor <Q>, sin incluir las condiciones de Neumann ni
+            de Dirichlet. El vector b local es, tal como en FEM::calculate_local_b():
+
+                    b = (Q*J/6) * [ 1  1  1 ]^T
+        */
+        void load_vector(real Q, real* b){
+            for(int i = 0; i < n; i++) b[i] = 0;
+            for(int e = 0; e < nelems; e++){
+                real value = Q*J[e]/6;
+                if(node0[e] >= 0) b[node0[e]] += value;
+                if(node1[e] >= 0) b[node1[e]] += value;
+                if(node2[e] >= 0) b[node2[e]] += value;
+            }
+        }
+
+        /*
+            Función que ensambla la matriz M reducida en almacenamiento skyline, a
+            partir de los mismos factores y sin construir la matriz densa. Se reciben
+            la densidad <rho> y el calor específico <Cp> del material.
+
+            La matriz M local es, tal como en FEM::calculate_local_M():
+
+                                        [ 2   1   1 ]
+                    M = (rho*Cp*J/24) * [ 1   2   1 ]
+                                        [ 1   1   2 ]
+
+            El perfil de cada fila inicia en el menor índice de los nodos libres con
+            los que comparte algún elemento.
+        */
+        Skyline* mass_matrix(real rho, real Cp){
+            int* profile = (int*) malloc(sizeof(int)*n);
+            for(int i = 0; i < n; i++) profile[i] = i;
+
+            for(int e = 0; e < nelems; e++){
+                int nodes[3] = {node0[e], node1[e], node2[e]};
+                int lowest = n;
+                for(int a = 0; a < 3; a++)
+                    if(nodes[a] >= 0) lowest = min(lowest, nodes[a]);
+                for(int a = 0; a < 3; a++)
+                    if(nodes[a] >= 0) profile[nodes[a]] = min(profile[nodes[a]], lowest);
+            }
+
+            Skyline* M = new Skyline(n, profile);
+            free(profile);
+
+            for(int e = 0; e < nelems; e++){
+                int nodes[3] = {node0[e], node1[e], node2[e]};
+                real factor = rho*Cp*J[e]/24;
+                for(int a = 0; a < 3; a++){
+                    if(nodes[a] < 0) continue;
+                    M->add(nodes[a], nodes[a], 2*factor);
+                    for(int b = a+1; b < 3; b++)
+                        if(nodes[b] >= 0) M->add(nodes[a], nodes[b], factor);
+                }
+            }
+
+            return M;
+        }
+};
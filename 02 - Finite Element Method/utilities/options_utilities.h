@@ -0,0 +1,265 @@
+/*
+    Enumeración para los solucionadores disponibles del sistema K * T = b.
+*/
+enum linear_solver {SOLVER_CHOLESKY,SOLVER_CHOLESKY_IR,SOLVER_AMG,SOLVER_AMG_CG,SOLVER_GMG,SOLVER_GMG_CG};
+
+/*
+    Estructura Options utilizada para almacenar las opciones de ejecución
+    recibidas en la línea de comandos.
+
+    La línea de comandos tiene el siguiente formato:
+
+            <ejecutable> <archivo_sin_extension> [opciones]
+
+    Donde las opciones disponibles son:
+        --restart            Reanuda el proceso a partir del último checkpoint
+                             guardado para el archivo de entrada indicado.
+        --checkpoint <n>     Guarda un checkpoint cada <n> pasos de tiempo.
+                             Un valor de 0 desactiva los checkpoints.
+        --rcm                Renumera los nodos de la malla con el algoritmo
+                             Reverse Cuthill-McKee antes del ensamblaje, para
+                             reducir el ancho de banda de las matrices globales.
+                             Los resultados se escriben con los IDs de GiD.
+        --steady             Calcula directamente el estado estacionario, resolviendo
+                             K * T = b, en lugar de avanzar en el tiempo. Equivale
+                             a indicar "Steady" en el bloque Analysis del archivo de
+                             entrada.
+        --adaptive           Ajusta el paso de tiempo en cada paso a partir de una
+                             estimación del error de Forward Euler, partiendo del
+                             paso indicado en el archivo de entrada, y termina antes
+                             del tiempo final si se alcanza el estado estacionario.
+        --tolerance <e>      Error relativo admitido por paso con --adaptive
+                             (por defecto 1e-4).
+        --steady-tolerance <s>
+                             Cambio relativo de las temperaturas en un paso por
+                             debajo del cual, con --adaptive, se considera alcanzado
+                             el estado estacionario (por defecto 1e-5). Debe ser
+                             menor que --tolerance, pero no demasiado, ya que cerca
+                             del estado estacionario los cambios de cada paso son
+                             del orden del error admitido. Un valor de 0 desactiva
+                             la detección.
+        --sweep <archivo>    Resuelve en un solo proceso todos los casos de la tabla
+                             <archivo>, cada uno con sus propios valores de Q, Td,
+                             Tn y temperatura inicial (ver read_sweep_file()), y
+                             escribe los resultados del caso k en el archivo
+                             <archivo_de_entrada>_k.post.res. No admite --restart
+                             ni --adaptive.
+        --matrix-free        No ensambla la matriz K: calcula los productos K * T
+                             elemento por elemento a partir de factores geométricos
+                             precalculados (ver ElementOperator). El análisis
+                             estacionario se resuelve entonces con gradiente
+                             conjugado precondicionado. No admite --adaptive ni
+                             --sweep.
+        --solver <tipo>      Solucionador del sistema K * T = b del análisis
+                             estacionario:
+                                cholesky  Cholesky en almacenamiento skyline
+                                          (por defecto).
+                                cholesky-ir
+                                          Cholesky en precisión mixta: factoriza
+                                          en float y refina la solución en double
+                                          hasta --cg-tolerance (ver la clase
+                                          RefinedCholesky).
+                                amg       Ciclos V de multigrid algebraico.
+                                amg-cg    Gradiente conjugado precondicionado con
+                                          un ciclo V de multigrid algebraico.
+                                gmg       Ciclos V de multigrid geométrico sobre
+                                          las mallas de --refine, sin ensamblar
+                                          ninguna matriz densa.
+                                gmg-cg    Gradiente conjugado precondicionado con
+                                          un ciclo V de multigrid geométrico.
+                             La jerarquía de multigrid se construye una sola vez, y
+                             en un barrido de parámetros se reutiliza en todos los
+                             casos. cholesky-ir, amg y amg-cg no admiten
+                             --matrix-free, y gmg y gmg-cg requieren --refine y no
+                             admiten --sweep.
+        --refine <n>         Divide <n> veces cada triángulo de la malla en cuatro
+                             (ver Mesh::refine()) y resuelve el problema sobre la
+                             malla refinada, que se escribe en el archivo de malla de
+                             post-proceso <archivo_de_entrada>.post.msh.
+        --cg-tolerance <e>   Residuo relativo al que se detienen el gradiente
+                             conjugado, el multigrid y el refinamiento de
+                             cholesky-ir (por defecto 1e-5). amg, gmg y cholesky-ir
+                             acumulan la solución en double, por lo que en float
+                             alcanzan residuos de hasta 1e-7 por el número de
+                             condición de la matriz.
+        --partitions <p>     Divide la malla en <p> subdominios, cada uno de los
+                             cuales ensambla únicamente su propio sistema, y resuelve
+                             el sistema global con gradiente conjugado distribuido
+                             (ver distributed_utilities.h): K * T = b en el análisis
+                             estacionario, y M * delta = delta_t * ( b - K * T ) en
+                             cada paso de tiempo. Cada subdominio se resuelve en un
+                             hilo, o en un proceso de MPI en compilaciones con
+                             -DFEM_USE_MPI, en cuyo caso <p> debe ser la cantidad de
+                             procesos. No admite --sweep, --adaptive, --matrix-free
+                             ni --solver.
+        --quiet              No muestra mensajes de progreso.
+        --debug              Muestra el detalle de cada elemento en cada paso
+                             (no disponible en compilaciones con -DNDEBUG).
+
+    La estructura posee además un constructor genérico que coloca los
+    valores por defecto de todas las opciones.
+*/
+typedef struct Options{
+    char* filename;
+    char* sweep_file;
+    bool restart;
+    bool renumber;
+    bool steady;
+    bool adaptive;
+    bool matrix_free;
+    linear_solver solver;
+    float tolerance;
+    float steady_tolerance;
+    float cg_tolerance;
+    int checkpoint_every;
+    int refine;
+    int partitions;
+    log_level verbosity;
+    Options(){
+        filename = NULL;
+        sweep_file = NULL;
+        restart = false;
+        renumber = false;
+        steady = false;
+        adaptive = false;
+        matrix_free = false;
+        solver = SOLVER_CHOLESKY;
+        tolerance = 1e-4;
+        steady_tolerance = 1e-5;
+        cg_tolerance = 1e-5;
+        checkpoint_every = 10;
+        refine = 0;
+        partitions = 0;
+        verbosity = LEVEL_PROGRESS;
+    }
+} Options;
+
+/*
+    Función que informa el uso correcto del programa y termina el proceso.
+*/
+void show_usage(char* program){
+    cout << "Usage: " << program << " <input_file_without_extension> [--restart] [--checkpoint <steps>] [--rcm] [--steady] [--sweep <file>] [--refine <n>] [--solver cholesky|cholesky-ir|amg|amg-cg|gmg|gmg-cg] [--matrix-free] [--cg-tolerance <e>] [--partitions <p>] [--adaptive [--tolerance <e>] [--steady-tolerance <s>]] [--quiet|--debug]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*
+    Función para interpretar los argumentos recibidos en la línea de
+    comandos.
+
+    Se reciben <argc> y <argv> tal como los recibe el procedimiento
+    principal, y se retorna un objeto Options con las opciones indicadas.
+
+    El primer argumento que no corresponde a una opción se interpreta
+    como el nombre del archivo de entrada sin extensión.
+*/
+Options parse_options(int argc, char** argv){
+    Options opts;
+
+    //Se recorren los argumentos, comenzando después del nombre del ejecutable
+    for(int i = 1; i < argc; i++){
+        string arg(argv[i]);
+
+        if(arg == "--restart")
+            opts.restart = true;
+        else if(arg == "--rcm")
+            opts.renumber = true;
+        else if(arg == "--steady")
+            opts.steady = true;
+        else if(arg == "--sweep"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            opts.sweep_file = argv[++i];
+        }
+        else if(arg == "--adaptive")
+            opts.adaptive = true;
+        else if(arg == "--matrix-free")
+            opts.matrix_free = true;
+        else if(arg == "--solver"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            string type(argv[++i]);
+            if(type == "cholesky") opts.solver = SOLVER_CHOLESKY;
+            else if(type == "cholesky-ir") opts.solver = SOLVER_CHOLESKY_IR;
+            else if(type == "amg") opts.solver = SOLVER_AMG;
+            else if(type == "amg-cg") opts.solver = SOLVER_AMG_CG;
+            else if(type == "gmg") opts.solver = SOLVER_GMG;
+            else if(type == "gmg-cg") opts.solver = SOLVER_GMG_CG;
+            else{
+                cout << "Unknown solver: " << type << "\n";
+                show_usage(argv[0]);
+            }
+        }
+        else if(arg == "--tolerance" || arg == "--steady-tolerance" || arg == "--cg-tolerance"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            if(arg == "--tolerance") opts.tolerance = atof(argv[++i]);
+            else if(arg == "--steady-tolerance") opts.steady_tolerance = atof(argv[++i]);
+            else opts.cg_tolerance = atof(argv[++i]);
+        }
+        else if(arg == "--checkpoint"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            opts.checkpoint_every = atoi(argv[++i]);
+        }
+        else if(arg == "--refine"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            opts.refine = atoi(argv[++i]);
+        }
+        else if(arg == "--partitions"){
+            //La opción requiere un valor a continuación
+            if(i+1 >= argc) show_usage(argv[0]);
+            opts.partitions = atoi(argv[++i]);
+            if(opts.partitions < 1){
+                cout << "--partitions requires at least 1 subdomain.\n";
+                show_usage(argv[0]);
+            }
+        }
+        else if(arg == "--quiet")
+            opts.verbosity = LEVEL_QUIET;
+        else if(arg == "--debug")
+            opts.verbosity = LEVEL_DEBUG;
+        else if(arg.rfind("--",0) == 0){
+            //Opción desconocida
+            cout << "Unknown option: " << arg << "\n";
+            show_usage(argv[0]);
+        }
+        else
+            opts.filename = argv[i];
+    }
+
+    //El nombre del archivo de entrada es obligatorio
+    if(opts.filename == NULL) show_usage(argv[0]);
+
+    //El barrido de parámetros no guarda checkpoints y utiliza paso de tiempo fijo
+    if(opts.sweep_file != NULL && (opts.restart || opts.adaptive)){
+        cout << "--sweep cannot be combined with --restart or --adaptive.\n";
+        show_usage(argv[0]);
+    }
+
+    //El operador sin ensamblar únicamente reemplaza al paso de tiempo fijo y al análisis estacionario
+    if(opts.matrix_free && (opts.sweep_file != NULL || opts.adaptive)){
+        cout << "--matrix-free cannot be combined with --sweep or --adaptive.\n";
+        show_usage(argv[0]);
+    }
+
+    //El refinamiento y el multigrid algebraico se construyen a partir de la matriz K ensamblada
+    if(opts.matrix_free && (opts.solver == SOLVER_CHOLESKY_IR || opts.solver == SOLVER_AMG || opts.solver == SOLVER_AMG_CG)){
+        cout << "--solver cholesky-ir, amg and amg-cg require the assembled K, and cannot be combined with --matrix-free.\n";
+        show_usage(argv[0]);
+    }
+
+    //El multigrid geométrico se construye sobre las mallas de la refinación
+    if((opts.solver == SOLVER_GMG || opts.solver == SOLVER_GMG_CG) && (opts.refine < 1 || opts.sweep_file != NULL)){
+        cout << "--solver gmg and gmg-cg require --refine <n> with n >= 1, and cannot be combined with --sweep.\n";
+        show_usage(argv[0]);
+    }
+
+    //La solución distribuida tiene su propio solucionador y su propio ciclo de paso fijo
+    if(opts.partitions > 0 && (opts.sweep_file != NULL || opts.adaptive || opts.matrix_free || opts.solver != SOLVER_CHOLESKY)){
+        cout << "--partitions cannot be combined with --sweep, --adaptive, --matrix-free or --solver.\n";
+        show_usage(argv[0]);
+    }
+
+    return opts;
+}
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <fstream>
+#include <string>
+
+//El reporte JSON indica el tipo real del proceso
+#include "precision_utilities.h"
+
+/*
+    Enumeración utilizada para identificar las fases del proceso cuyo
+    tiempo de ejecución se mide:
+        - PHASE_MESH_READ para la lectura del archivo de entrada.
+        - PHASE_LOCAL_SYSTEMS para el cálculo de las matrices locales.
+        - PHASE_ASSEMBLY para el ensamblaje de las matrices globales.
+        - PHASE_NEUMANN para la aplicación de las condiciones de Neumann.
+        - PHASE_DIRICHLET para la aplicación de las condiciones de Dirichlet.
+        - PHASE_SOLVE para el cálculo de las temperaturas del siguiente tiempo.
+        - PHASE_OUTPUT para la escritura de resultados y checkpoints.
+
+    NUM_PHASES no es una fase, se utiliza como cantidad total de fases.
+*/
+enum phase {PHASE_MESH_READ,PHASE_LOCAL_SYSTEMS,PHASE_ASSEMBLY,PHASE_NEUMANN,PHASE_DIRICHLET,PHASE_SOLVE,PHASE_OUTPUT,NUM_PHASES};
+
+/*
+    Clase utilitaria para la medición del desempeño del proceso.
+
+    La clase acumula, para cada fase, el tiempo total transcurrido y la
+    cantidad de veces que se ejecutó, además de dos contadores globales:
+        - La cantidad de reservas de memoria realizadas por las estructuras
+          de datos, junto con el total de bytes reservados.
+        - La cantidad de operaciones de punto flotante realizadas por las
+          operaciones de álgebra de matrices.
+
+    Al finalizar el proceso, la clase genera una tabla resumen y un reporte
+    en formato JSON para poder comparar ejecuciones entre sí.
+
+    Todos los atributos y métodos son estáticos, ya que se ha concebido como
+    una clase utilitaria. Las estructuras de datos registran con ella sus
+    reservas de memoria, por lo que "SDDS.h" incluye este archivo.
+
+    Los atributos son thread_local: cada hilo acumula sus propias mediciones,
+    igual que cada proceso de MPI, por lo que los subdominios que se resuelven
+    en hilos auxiliares (ver Communicator) no alteran las mediciones del hilo
+    principal.
+*/
+class Perf{
+    private:
+        inline static thread_local double elapsed[NUM_PHASES] = {};
+        inline static thread_local long calls[NUM_PHASES] = {};
+        inline static thread_local long allocations = 0;
+        inline static thread_local long allocated_bytes = 0;
+        inline static thread_local long long flops = 0;
+        inline static thread_local std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        /*
+            Función que retorna el nombre de una fase para los reportes.
+        */
+        static const char* phase_name(int p){
+            switch(p){
+                case PHASE_MESH_READ:     return "mesh_read";
+                case PHASE_LOCAL_SYSTEMS: return "local_systems";
+                case PHASE_ASSEMBLY:      return "assembly";
+                case PHASE_NEUMANN:       return "neumann";
+                case PHASE_DIRICHLET:     return "dirichlet";
+                case PHASE_SOLVE:         return "solve";
+                case PHASE_OUTPUT:        return "output";
+            }
+            return "unknown";
+        }
+
+    public:
+        /*
+            Función para registrar el tiempo <seconds> de una ejecución de
+            la fase <p>.
+        */
+        static void add_time(phase p, double seconds){
+            elapsed[p] += seconds;
+            calls[p]++;
+        }
+
+        /*
+            Función para registrar <n> reservas de memoria que suman en
+            total <bytes> bytes.
+        */
+        static void count_allocation(long bytes, long n = 1){
+            allocations += n;
+            allocated_bytes += bytes;
+        }
+
+        /*
+            Función para registrar <n> operaciones de punto flotante.
+        */
+        static void count_flops(long long n){
+            flops += n;
+        }
+
+        /*
+            Funciones para consultar los contadores globales.
+        */
+        static long get_allocations(){ return allocations; }
+        static long get_allocated_bytes(){ return allocated_bytes; }
+        static long long get_flops(){ return flops; }
+        static double get_time(phase p){ return elapsed[p]; }
+
+        /*
+            Función para reiniciar todas las mediciones.
+        */
+        static void reset(){
+            for(int p = 0; p < NUM_PHASES; p++){ elapsed[p] = 0; calls[p] = 0; }
+            allocations = 0; allocated_bytes = 0; flops = 0;
+            start = std::chrono::steady_clock::now();
+        }
+
+        /*
+            Función que retorna el tiempo transcurrido desde el inicio del proceso.
+        */
+        static double total_time(){
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        /*
+            Función que muestra la tabla resumen de las mediciones en <out>.
+        */
+        static void show_summary(std::ostream& out){
+            double total = total_time();
+
+            out << "\nPerformance summary:\n";
+            out << "\t" << std::left << std::setw(16) << "Phase" << std::right << std::setw(12) << "Seconds" << std::setw(10) << "%" << std::setw(10) << "Calls" << "\n";
+            for(int p = 0; p < NUM_PHASES; p++)
+                out << "\t" << std::left << std::setw(16) << phase_name(p) << std::right << std::fixed << std::setprecision(4) << std::setw(12) << elapsed[p]
+                    << std::setprecision(1) << std::setw(10) << ((total > 0)?100*elapsed[p]/total:0) << std::setw(10) << calls[p] << "\n";
+            out << "\t" << std::left << std::setw(16) << "total" << std::right << std::setprecision(4) << std::setw(12) << total << "\n";
+            out.unsetf(std::ios::fixed); out << std::setprecision(6);
+
+            out << "\tAllocations: " << allocations << " (" << allocated_bytes << " bytes)\n";
+            out << "\tFlops: " << flops << "\n";
+        }
+
+        /*
+            Función que retorna <text> como una cadena de JSON, es decir,
+            entre comillas y con sus barras invertidas y comillas escapadas,
+            ya que el nombre del archivo de entrada puede contener ambas
+            (por ejemplo, las rutas de Windows).
+        */
+        static std::string json_string(const char* text){
+            std::string res = "\"";
+            for(const char* c = text; *c != '\0'; c++){
+                if(*c == '\\' || *c == '"') res += '\\';
+                res += *c;
+            }
+            return res + "\"";
+        }
+
+        /*
+            Función para crear el reporte en formato JSON de las mediciones.
+
+            Se reciben <filename> como el nombre del archivo de entrada sin
+            extensión, y <nnodes>, <nelems> y <steps> como datos de la malla y
+            del proceso que acompañan a las mediciones en el reporte. El reporte
+            indica también el tipo real con el que se compiló el proceso (ver
+            precision_utilities.h), para comparar ejecuciones en float y double.
+
+            El reporte se escribe en el archivo <filename>.perf.json.
+        */
+        static void write_json(char* filename, int nnodes, int nelems, int steps){
+            std::string report_file = std::string(filename) + ".perf.json";
+            std::ofstream jsonFile( report_file );
+
+            //Si la apertura falló se informa, pero el proceso como tal ya terminó
+            if( !jsonFile.is_open() ){
+                std::cerr << "Problem opening the performance report file. :(\n";
+                return;
+            }
+
+            jsonFile << "{\n";
+            jsonFile << "  \"input\": " << json_string(filename) << ",\n";
+            jsonFile << "  \"nodes\": " << nnodes << ",\n";
+            jsonFile << "  \"elements\": " << nelems << ",\n";
+            jsonFile << "  \"precision\": \"" << REAL_NAME << "\",\n";
+            jsonFile << "  \"steps\": " << steps << ",\n";
+            jsonFile << "  \"total_seconds\": " << total_time() << ",\n";
+            jsonFile << "  \"phases\": {\n";
+            for(int p = 0; p < NUM_PHASES; p++)
+                jsonFile << "    \"" << phase_name(p) << "\": { \"seconds\": " << elapsed[p] << ", \"calls\": " << calls[p] << " }"
+                         << ((p < NUM_PHASES-1)?",":"") << "\n";
+            jsonFile << "  },\n";
+            jsonFile << "  \"counters\": { \"allocations\": " << allocations << ", \"allocated_bytes\": " << allocated_bytes
+                     << ", \"flops\": " << flops << " }\n";
+            jsonFile << "}\n";
+
+            jsonFile.close();
+        }
+};
+
+/*
+    Clase para medir el tiempo de una fase dentro de un bloque de código.
+
+    El tiempo se comienza a medir al construir el objeto y se registra en
+    la clase Perf al destruirlo, es decir, al salir del bloque en el que se
+    declaró:
+
+            {
+                ScopedTimer timer(PHASE_ASSEMBLY);
+                ...
+            }
+*/
+class ScopedTimer{
+    private:
+        phase p;
+        std::chrono::steady_clock::time_point begin;
+
+    public:
+        ScopedTimer(phase measured){
+            p = measured;
+            begin = std::chrono::steady_clock::now();
+        }
+        ~ScopedTimer(){
+            Perf::add_time(p, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+        }
+};
@@ -0,0 +1,31 @@
+/*
+    Definición del tipo de dato <real>, utilizado para todos los datos numéricos
+    del proceso MEF2D: las matrices globales y locales, las temperaturas y los
+    vectores de los solucionadores.
+
+    Por defecto <real> es float. Al compilar con la bandera -DFEM_DOUBLE, por
+    ejemplo:
+
+            g++ -std=c++17 -O2 -DFEM_DOUBLE -o main main.cpp
+
+    <real> pasa a ser double, con el doble de memoria por dato a cambio de unos
+    ocho dígitos más de precisión, lo cual es relevante en mallas grandes, donde
+    el error de redondeo de la factorización de Cholesky en float crece con el
+    ancho de banda de la matriz.
+
+    Las coordenadas de los puntos y los parámetros del problema se mantienen en
+    float en ambos casos, ya que provienen del archivo de entrada. Los datos del
+    checkpoint se almacenan con el tamaño de <real>, por lo que un checkpoint solo
+    puede reanudarse con un ejecutable de la misma precisión.
+
+    Una alternativa intermedia, sin recompilar, es el solucionador cholesky-ir
+    (ver la clase RefinedCholesky en skyline_utilities.h), que factoriza en float
+    y refina la solución en double.
+*/
+#ifdef FEM_DOUBLE
+    typedef double real;
+    #define REAL_NAME "double"
+#else
+    typedef float real;
+    #define REAL_NAME "float"
+#endif
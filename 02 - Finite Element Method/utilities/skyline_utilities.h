@@ -0,0 +1,492 @@
+/*
+    Clase para el almacenamiento de una matriz simétrica en formato skyline
+    (o de perfil), junto con su factorización de Cholesky y la solución de
+    sistemas de ecuaciones a partir de ella.
+
+    En una matriz simétrica basta almacenar la parte triangular inferior. En
+    cada fila i se almacenan únicamente las columnas desde la primera columna
+    no nula <first[i]> hasta la diagonal, es decir, el "perfil" de la fila:
+
+                [ x                 ]       fila 0: columnas 0..0
+                [ x  x              ]       fila 1: columnas 0..1
+                [ 0  0  x           ]       fila 2: columnas 2..2
+                [ 0  x  0  x        ]       fila 3: columnas 1..3
+                [ 0  0  x  x  x     ]       fila 4: columnas 2..4
+
+    Todas las filas se colocan una tras otra en un único arreglo <values>, y
+    <start[i]> indica la posición en dicho arreglo en la que inicia la fila i.
+    Los ceros que quedan dentro del perfil (como la posición (3,2)) sí se
+    almacenan, ya que la factorización de Cholesky puede llenarlos; los ceros
+    fuera del perfil permanecen siempre en cero, por lo que el factor L ocupa
+    exactamente el mismo espacio que la matriz original.
+
+    Con un ancho de banda w, la matriz ocupa a lo sumo n*(w+1) datos y la
+    factorización requiere del orden de n*w^2 operaciones, en lugar de n^2
+    datos y n^3 operaciones para una matriz densa. Las matrices del MEF son
+    de banda angosta cuando los nodos están bien numerados, por ejemplo tras
+    renumerarlos con Reverse Cuthill-McKee (opción --rcm).
+
+    La clase es una plantilla sobre el tipo <T> de los datos del perfil. El
+    proceso utiliza Skyline, con el tipo real (ver precision_utilities.h), y la
+    clase RefinedCholesky combina un factor en float con la matriz original en
+    el tipo real.
+*/
+template <typename T>
+class BasicSkyline{
+    //Las matrices skyline de otro tipo acceden al perfil al convertirse
+    template <typename S> friend class BasicSkyline;
+
+    private:
+        int n;              //Cantidad de filas (y de columnas) de la matriz
+        int* first;         //Primera columna almacenada de cada fila
+        long* start;        //Posición de inicio de cada fila en <values>, con una posición extra al final
+        T* values;          //Perfil de todas las filas, una tras otra
+        bool factorized;    //Indica si <values> contiene ya el factor L
+
+        /*
+            Función que retorna la posición en <values> de la celda (i,j),
+            asumiendo que first[i] <= j <= i.
+        */
+        long position(int i, int j){
+            return start[i] + (j - first[i]);
+        }
+
+    public:
+        /*
+            Constructor que construye la matriz skyline a partir de la matriz
+            densa simétrica <A>, de la cual se utiliza únicamente la parte
+            triangular inferior.
+
+            El perfil de cada fila inicia en su primera columna no nula, y se
+            extiende siempre hasta la diagonal. Los datos de <A> se convierten al
+            tipo <T> de la matriz skyline.
+        */
+        template <typename S>
+        BasicSkyline(DS<S>* A){
+            int ncols;
+            SDDS<S>::extension(A, &n, &ncols);
+
+            first = (int*) malloc(sizeof(int)*n);
+            start = (long*) malloc(sizeof(long)*(n+1));
+
+            //Primer recorrido: se determina el perfil de cada fila
+            S Aij;
+            start[0] = 0;
+            for(int i = 0; i < n; i++){
+                first[i] = i;
+                for(int j = 0; j < i; j++){
+                    SDDS<S>::extract(A, i, j, &Aij);
+                    if(Aij != 0){ first[i] = j; break; }
+                }
+                start[i+1] = start[i] + (i - first[i] + 1);
+            }
+
+            //Segundo recorrido: se copian los datos del perfil
+            values = (T*) malloc(sizeof(T)*start[n]);
+            for(int i = 0; i < n; i++)
+                for(int j = first[i]; j <= i; j++){
+                    SDDS<S>::extract(A, i, j, &Aij);
+                    values[position(i,j)] = (T) Aij;
+                }
+
+            factorized = false;
+
+            //Se registran las reservas para las mediciones de desempeño
+            Perf::count_allocation(sizeof(int)*n + sizeof(long)*(n+1) + sizeof(T)*start[n], 3);
+        }
+
+        /*
+            Constructor que copia la matriz skyline <other>, con su mismo perfil,
+            convirtiendo sus datos al tipo <T>. Permite, por ejemplo, factorizar en
+            float una copia de una matriz almacenada en double.
+        */
+        template <typename S>
+        BasicSkyline(BasicSkyline<S>* other){
+            n = other->n;
+            first = (int*) malloc(sizeof(int)*n);
+            start = (long*) malloc(sizeof(long)*(n+1));
+            memcpy(first, other->first, sizeof(int)*n);
+            memcpy(start, other->start, sizeof(long)*(n+1));
+
+            values = (T*) malloc(sizeof(T)*start[n]);
+            for(long p = 0; p < start[n]; p++) values[p] = (T) other->values[p];
+            factorized = other->factorized;
+
+            //Se registran las reservas para las mediciones de desempeño
+            Perf::count_allocation(sizeof(int)*n + sizeof(long)*(n+1) + sizeof(T)*start[n], 3);
+        }
+
+        /*
+            Constructor que crea una matriz skyline de <size> x <size> con todas
+            sus posiciones en cero, cuyo perfil en la fila i inicia en la columna
+            <profile[i]>. Permite ensamblar la matriz directamente con add(), sin
+            construir antes una matriz densa.
+        */
+        BasicSkyline(int size, int* profile){
+            n = size;
+            first = (int*) malloc(sizeof(int)*n);
+            start = (long*) malloc(sizeof(long)*(n+1));
+
+            start[0] = 0;
+            for(int i = 0; i < n; i++){
+                first[i] = profile[i];
+                start[i+1] = start[i] + (i - first[i] + 1);
+            }
+
+            values = (T*) calloc(start[n], sizeof(T));
+            factorized = false;
+
+            //Se registran las reservas para las mediciones de desempeño
+            Perf::count_allocation(sizeof(int)*n + sizeof(long)*(n+1) + sizeof(T)*start[n], 3);
+        }
+
+        /*
+            Destructor, libera el espacio en memoria del perfil.
+        */
+        ~BasicSkyline(){
+            free(first);
+            free(start);
+            free(values);
+        }
+
+        /*
+            Función que retorna la cantidad de filas de la matriz.
+        */
+        int size(){
+            return n;
+        }
+
+        /*
+            Función que retorna la cantidad de datos almacenados en el perfil,
+            la cual se compara con los n*(n+1)/2 datos de la parte triangular
+            inferior de la matriz densa.
+        */
+        long stored(){
+            return start[n];
+        }
+
+        /*
+            Función que retorna el dato en la posición (i,j) de la matriz, o de
+            su factor L si ya se ha factorizado. Las posiciones fuera del perfil
+            son cero, y las posiciones sobre la diagonal se obtienen por simetría
+            antes de factorizar, y son cero en L.
+        */
+        T get(int i, int j){
+            if(j > i){
+                if(factorized) return 0;
+                int aux = i; i = j; j = aux;
+            }
+            if(j < first[i]) return 0;
+            return values[position(i,j)];
+        }
+
+        /*
+            Función para añadir <value> al dato en la posición (i,j) de la matriz,
+            la cual debe encontrarse dentro del perfil. Por simetría, las posiciones
+            sobre la diagonal se añaden en su posición transpuesta, por lo que cada
+            par (i,j), (j,i) fuera de la diagonal debe añadirse una sola vez.
+        */
+        void add(int i, int j, T value){
+            if(j > i){ int aux = i; i = j; j = aux; }
+            values[position(i,j)] += value;
+        }
+
+        /*
+            Función que calcula, en el mismo espacio de la matriz, su factorización
+            de Cholesky:
+                                A = L * L^T
+
+            Donde L es triangular inferior. Las filas se calculan en orden, y para
+            la fila i:
+
+                          1     /          j-1             \
+                L_ij = ------ * |  A_ij -  ===  L_ik*L_jk   |       para j < i
+                        L_jj    \          k=m             /
+
+                                 /          i-1          \
+                L_ii =   sqrt(   |  A_ii -  ===  L_ik^2   |   )
+                                 \          k=first[i]   /
+
+            Donde m = max(first[i], first[j]), ya que fuera de los perfiles L es
+            cero. Cada sumatoria recorre posiciones contiguas de <values>.
+
+            Dentro del perfil, los datos de L decrecen rápidamente al alejarse de
+            la diagonal, y en float sus productos llegan a ser subnormales (menores
+            que el menor float normalizado), con los cuales cada operación es
+            decenas de veces más lenta. Por ello, los datos de L menores que la raíz
+            cuadrada del menor valor normalizado de <T> (alrededor de 1e-19 en
+            float) se reemplazan por cero, de modo que ningún producto Li[k]*Lj[k]
+            sea subnormal. Su aporte a la solución es muy inferior al error de
+            redondeo, y la factorización en float conserva así su ventaja de
+            velocidad sobre la de double.
+
+            Se retorna false si la matriz no es definida positiva, en cuyo caso el
+            contenido de la matriz queda indefinido.
+        */
+        bool factorize(){
+            const T tiny = sqrt(numeric_limits<T>::min());
+            long long ops = 0;
+            for(int i = 0; i < n; i++){
+                T* Li = values + start[i] - first[i];   //Li[k] es L_ik
+                for(int j = first[i]; j < i; j++){
+                    T* Lj = values + start[j] - first[j];
+                    int m = max(first[i], first[j]);
+                    T acum = Li[j];
+                    for(int k = m; k < j; k++)
+                        acum -= Li[k]*Lj[k];
+                    Li[j] = acum/Lj[j];
+                    if(fabs(Li[j]) < tiny) Li[j] = 0;
+                    ops += 2LL*(j-m) + 1;
+                }
+
+                T acum = Li[i];
+                for(int k = first[i]; k < i; k++)
+                    acum -= Li[k]*Li[k];
+                ops += 2LL*(i-first[i]) + 1;
+
+                if(!(acum > 0)) return false;
+                Li[i] = sqrt(acum);
+            }
+            Perf::count_flops(ops);
+
+            factorized = true;
+            return true;
+        }
+
+        /*
+            Función que resuelve el sistema A * x = <b> utilizando el factor L, por
+            lo que requiere haber llamado antes a factorize(). La solución se
+            almacena en la misma matriz <b>.
+
+            <b> puede tener varias columnas, en cuyo caso se resuelve un sistema por
+            columna con un solo recorrido del factor, lo cual permite resolver varios
+            lados derechos a la vez con el costo de leer L una única vez.
+
+            Se resuelven dos sistemas triangulares:
+                - L * y = b, por sustitución hacia adelante, recorriendo las filas
+                  de L.
+                - L^T * x = y, por sustitución hacia atrás; las filas de L^T son
+                  columnas de L, por lo que se recorren de nuevo las filas de L,
+                  de la última a la primera, restando la contribución de cada
+                  incógnita ya calculada a las posiciones de su perfil.
+        */
+        template <typename S>
+        void solve(DS<S>* b){
+            int nrows, nrhs;
+            SDDS<S>::extension(b, &nrows, &nrhs);
+
+            //Las columnas de <b> se copian intercaladas, de modo que los datos de una
+            //misma fila de todas las columnas queden contiguos
+            T* x = (T*) malloc(sizeof(T)*n*nrhs);
+            S value;
+            for(int i = 0; i < n; i++)
+                for(int c = 0; c < nrhs; c++){
+                    SDDS<S>::extract(b, i, c, &value);
+                    x[i*nrhs + c] = (T) value;
+                }
+
+            solve(x, nrhs);
+
+            for(int i = 0; i < n; i++)
+                for(int c = 0; c < nrhs; c++)
+                    SDDS<S>::insert(b, i, c, (S) x[i*nrhs + c]);
+            free(x);
+            Perf::count_allocation(sizeof(T)*n*nrhs);
+        }
+
+        /*
+            Función que resuelve el sistema A * x = b, al igual que la anterior,
+            directamente sobre el arreglo <x> de n*<nrhs> datos, que contiene los
+            <nrhs> lados derechos intercalados (el dato de la fila i de la columna
+            c en la posición i*nrhs + c) y en el que se almacena la solución.
+        */
+        void solve(T* x, int nrhs){
+            //Sustitución hacia adelante
+            for(int i = 0; i < n; i++){
+                T* Li = values + start[i] - first[i];
+                T* xi = x + i*nrhs;
+                for(int k = first[i]; k < i; k++){
+                    T* xk = x + k*nrhs;
+                    for(int c = 0; c < nrhs; c++)
+                        xi[c] -= Li[k]*xk[c];
+                }
+                for(int c = 0; c < nrhs; c++)
+                    xi[c] /= Li[i];
+            }
+
+            //Sustitución hacia atrás
+            for(int i = n-1; i >= 0; i--){
+                T* Li = values + start[i] - first[i];
+                T* xi = x + i*nrhs;
+                for(int c = 0; c < nrhs; c++)
+                    xi[c] /= Li[i];
+                for(int k = first[i]; k < i; k++){
+                    T* xk = x + k*nrhs;
+                    for(int c = 0; c < nrhs; c++)
+                        xk[c] -= Li[k]*xi[c];
+                }
+            }
+
+            //Se registran dos multiplicaciones y restas por dato del perfil y por columna
+            Perf::count_flops(4LL*start[n]*nrhs);
+        }
+
+        /*
+            Función que calcula y = A * x con la matriz original, por lo que
+            requiere que no se haya factorizado. <x> y <y> contienen <nrhs>
+            columnas intercaladas, al igual que en solve().
+
+            Cada dato A_ij del perfil, con j < i, aporta tanto a la fila i como, por
+            simetría, a la fila j. Los productos y las sumas se calculan en double,
+            sin importar el tipo <T> de los datos, ya que esta función se utiliza
+            para calcular residuos.
+        */
+        void apply(double* x, double* y, int nrhs){
+            for(long p = 0; p < (long) n*nrhs; p++) y[p] = 0;
+
+            for(int i = 0; i < n; i++){
+                T* Ai = values + start[i] - first[i];
+                double* xi = x + (long) i*nrhs;
+                double* yi = y + (long) i*nrhs;
+                for(int k = first[i]; k < i; k++){
+                    double* xk = x + (long) k*nrhs;
+                    double* yk = y + (long) k*nrhs;
+                    for(int c = 0; c < nrhs; c++){
+                        yi[c] += Ai[k]*xk[c];
+                        yk[c] += Ai[k]*xi[c];
+                    }
+                }
+                for(int c = 0; c < nrhs; c++)
+                    yi[c] += Ai[i]*xi[c];
+            }
+
+            //Se registran dos multiplicaciones y dos sumas por dato del perfil y por columna
+            Perf::count_flops(4LL*start[n]*nrhs);
+        }
+};
+
+/*
+    Matriz skyline con el tipo de datos del proceso (ver precision_utilities.h).
+*/
+typedef BasicSkyline<real> Skyline;
+
+/*
+    Clase para resolver un sistema simétrico y definido positivo A * x = b en
+    precisión mixta: la factorización de Cholesky, que es la operación costosa,
+    se calcula en float, y la solución se mejora con refinamiento iterativo en
+    double:
+
+            x_0 = 0,    r_0 = b
+            L * L^T * d_k = r_k         (en float, con el factor)
+            x_(k+1) = x_k + d_k         (en double)
+            r_(k+1) = b - A * x_(k+1)   (en double, con la matriz original)
+
+    Cada iteración reduce el error en un factor del orden de cond(A)*eps_float,
+    por lo que, mientras dicho producto sea menor que 1, unas pocas iteraciones
+    llevan la solución hasta la precisión de double, aun cuando el factor en
+    float por sí solo deje un error relativo de varias décimas de porcentaje en
+    mallas grandes. Cada iteración cuesta una sustitución con el factor y un
+    producto con la matriz, del mismo orden que la sustitución de Cholesky y
+    muy por debajo del costo de factorizar.
+
+    La matriz original se almacena con el tipo real y el factor en float, con el
+    mismo perfil; en una compilación con float la clase ocupa entonces el doble
+    de memoria que Skyline, y en una compilación con -DFEM_DOUBLE, una vez y media.
+*/
+class RefinedCholesky{
+    private:
+        Skyline* A;                 //Matriz original, para calcular los residuos
+        BasicSkyline<float>* L;     //Factor de Cholesky en float
+
+    public:
+        /*
+            Constructor que construye la matriz original y su copia en float a
+            partir de la matriz densa simétrica <matrix>.
+        */
+        RefinedCholesky(DS<real>* matrix){
+            A = new Skyline(matrix);
+            L = new BasicSkyline<float>(A);
+        }
+
+        /*
+            Destructor, libera las dos matrices skyline.
+        */
+        ~RefinedCholesky(){
+            delete A;
+            delete L;
+        }
+
+        /*
+            Función que calcula la factorización de Cholesky en float. Se retorna
+            false si la matriz no es definida positiva en float.
+        */
+        bool factorize(){
+            return L->factorize();
+        }
+
+        /*
+            Función que resuelve el sistema A * x = <B>, almacenando la solución en
+            la misma matriz <B>, que puede tener varias columnas; todas se refinan a
+            la vez, con un solo recorrido del factor y de la matriz por iteración.
+
+            Se itera hasta que el residuo relativo ||b - A*x|| / ||b|| de cada columna
+            sea menor o igual que <tolerance>, o hasta <max_iterations> iteraciones.
+            Se retorna la cantidad de iteraciones realizadas, y en <residual> se
+            coloca el mayor residuo relativo entre las columnas.
+        */
+        int solve(DS<real>* B, float tolerance, int max_iterations, float* residual){
+            int n = A->size(), nrows, nrhs;
+            SDDS<real>::extension(B, &nrows, &nrhs);
+
+            double* b = (double*) malloc(sizeof(double)*n*nrhs);
+            double* x = (double*) calloc(n*nrhs, sizeof(double));
+            double* r = (double*) malloc(sizeof(double)*n*nrhs);
+            float* d = (float*) malloc(sizeof(float)*n*nrhs);
+            double* norm_b = (double*) calloc(nrhs, sizeof(double));
+            double* norm_r = (double*) malloc(sizeof(double)*nrhs);
+            Perf::count_allocation(sizeof(double)*(3*n*nrhs + 2*nrhs) + sizeof(float)*n*nrhs, 6);
+
+            real value;
+            for(int i = 0; i < n; i++)
+                for(int c = 0; c < nrhs; c++){
+                    SDDS<real>::extract(B, i, c, &value);
+                    b[i*nrhs + c] = value;
+                    r[i*nrhs + c] = value;
+                    norm_b[c] += (double) value*value;
+                }
+
+            int iterations = 0;
+            double worst;
+            while(true){
+                //Residuo relativo de cada columna; una columna nula ya está resuelta
+                for(int c = 0; c < nrhs; c++) norm_r[c] = 0;
+                for(int p = 0; p < n*nrhs; p++) norm_r[p % nrhs] += r[p]*r[p];
+                worst = 0;
+                for(int c = 0; c < nrhs; c++)
+                    if(norm_b[c] > 0) worst = max(worst, sqrt(norm_r[c]/norm_b[c]));
+
+                if(worst <= tolerance || iterations == max_iterations) break;
+
+                //Corrección con el factor en float
+                for(int p = 0; p < n*nrhs; p++) d[p] = (float) r[p];
+                L->solve(d, nrhs);
+                for(int p = 0; p < n*nrhs; p++) x[p] += d[p];
+
+                //Nuevo residuo con la matriz original
+                A->apply(x, r, nrhs);
+                for(int p = 0; p < n*nrhs; p++) r[p] = b[p] - r[p];
+                Perf::count_flops(4LL*n*nrhs);
+                iterations++;
+            }
+
+            for(int i = 0; i < n; i++)
+                for(int c = 0; c < nrhs; c++)
+                    SDDS<real>::insert(B, i, c, (real) x[i*nrhs + c]);
+
+            free(b); free(x); free(r); free(d);
+            free(norm_b); free(norm_r);
+
+            *residual = worst;
+            return iterations;
+        }
+};
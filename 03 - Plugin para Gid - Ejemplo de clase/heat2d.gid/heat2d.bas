@@ -33,3 +33,7 @@ Neumann
 *NodesNum
 *end nodes
 EndNeumann
+
+Analysis
+*GenData(11)
+EndAnalysis